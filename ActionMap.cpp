@@ -0,0 +1,131 @@
+/** @file ActionMap.cpp
+ *  @brief Source file for the action map
+ *
+ * This program is responsible for turning latched key presses into named
+ * actions and handing them to the screen that is currently active.
+ *
+ *  @author Michael Martinez
+ *  @bug No known bugs.
+ */
+#include "ActionMap.h"
+
+#include <algorithm>
+
+ActionMap* ActionMap::sInstance = nullptr;
+
+ActionMap* ActionMap::Instance() {
+  // C26409: Fixing warning to replace 'new' requires editing included
+  // framework library 'QuickSDL"
+  if (sInstance == nullptr) sInstance = new ActionMap();
+
+  return sInstance;
+}
+
+void ActionMap::Release() noexcept {
+  delete sInstance;
+  sInstance = nullptr;
+}
+
+// C26455: Fixing the warning 'noexcept' solution is to not include 'noexcept'
+// in the first place.
+//(https://docs.microsoft.com/en-us/cpp/code-quality/c26447?view=msvc-170)
+ActionMap::ActionMap() {
+  mInput = InputLatch::Instance();
+  mContext = -1;
+
+  for (int i = 0; i < SDL_NUM_SCANCODES; i++) mBindings[i] = -1;
+  for (int i = 0; i < TOTAL_ACTIONS; i++) mTriggered[i] = false;
+
+  Bind(up, SDL_SCANCODE_UP);
+  Bind(down, SDL_SCANCODE_DOWN);
+  Bind(left, SDL_SCANCODE_LEFT);
+  Bind(right, SDL_SCANCODE_RIGHT);
+  Bind(fire, SDL_SCANCODE_SPACE);
+  Bind(confirm, SDL_SCANCODE_RETURN);
+  Bind(hit, SDL_SCANCODE_X);
+  Bind(skip, SDL_SCANCODE_N);
+
+  ResetDispatchTime();
+}
+
+// C26432: deleting all would cause compiling error
+ActionMap::~ActionMap() { mInput = nullptr; }
+
+void ActionMap::Bind(ACTIONS action, SDL_Scancode key) {
+  if (mBindings[key] < 0) mBoundKeys.push_back(key);
+
+  mBindings[key] = action;
+}
+
+void ActionMap::Unbind(SDL_Scancode key) {
+  if (mBindings[key] < 0) return;
+
+  mBindings[key] = -1;
+  mBoundKeys.erase(std::find(mBoundKeys.begin(), mBoundKeys.end(), key));
+}
+
+void ActionMap::Rebind(ACTIONS action, SDL_Scancode key) {
+  for (int i = 0; i < SDL_NUM_SCANCODES; i++) {
+    if (mBindings[i] == action) Unbind(static_cast<SDL_Scancode>(i));
+  }
+
+  Bind(action, key);
+}
+
+void ActionMap::Subscribe(int context, ActionHandler handler, void* data) {
+  const Subscriber subscriber = {context, handler, data};
+  mSubscribers.push_back(subscriber);
+}
+
+void ActionMap::Context(int context) noexcept { mContext = context; }
+
+void ActionMap::Trigger(ACTIONS action) noexcept {
+  mTriggered[action] = true;
+  mPressTimes[action] = InputQueue::Clock::now();
+}
+
+void ActionMap::Dispatch() {
+  const Clock::time_point start = Clock::now();
+
+  for (const SDL_Scancode key : mBoundKeys) {
+    if (!mInput->KeyPressed(key)) continue;
+
+    mTriggered[mBindings[key]] = true;
+    mPressTimes[mBindings[key]] = mInput->PressTime(key);
+  }
+
+  // Handlers may switch screens, so the context is read once up front
+  const int context = mContext;
+  for (int action = 0; action < TOTAL_ACTIONS; action++) {
+    if (!mTriggered[action]) continue;
+    mTriggered[action] = false;
+
+    for (const Subscriber& subscriber : mSubscribers) {
+      if (subscriber.context == context)
+        subscriber.handler(subscriber.data, static_cast<ACTIONS>(action));
+    }
+  }
+
+  mDispatchTime =
+      std::chrono::duration<float, std::micro>(Clock::now() - start).count();
+  mTotalDispatchTime += mDispatchTime;
+  mDispatches++;
+}
+
+InputQueue::Clock::time_point ActionMap::PressTime(ACTIONS action) noexcept {
+  return mPressTimes[action];
+}
+
+float ActionMap::DispatchTime() noexcept { return mDispatchTime; }
+
+float ActionMap::AverageDispatchTime() noexcept {
+  if (mDispatches == 0) return 0.0f;
+
+  return static_cast<float>(mTotalDispatchTime / mDispatches);
+}
+
+void ActionMap::ResetDispatchTime() noexcept {
+  mDispatchTime = 0.0f;
+  mTotalDispatchTime = 0.0;
+  mDispatches = 0;
+}
@@ -0,0 +1,272 @@
+/** @file ActionMap.h
+ *  @brief Header file for the action map
+ *
+ * This program is responsible for turning latched key presses into named
+ * actions and handing them to the screen that is currently active.
+ *
+ *  @author Michael Martinez
+ *  @bug No known bugs.
+ */
+#ifndef _ACTIONMAP_H
+#define _ACTIONMAP_H
+#include <chrono>
+#include <vector>
+
+#include "InputLatch.h"
+
+/**
+ * @brief The ActionMap class
+ * @author Michael Martinez
+ *
+ * ActionMap class which is used as the only reader of keyboard input. Keys
+ * are bound to actions, actions are worked out once per simulation step and
+ * every subscriber of the active context is called with each one.
+ *
+ */
+class ActionMap {
+ public:
+  /** @brief enum for actions
+   *
+   * Everything a key can be bound to.
+   *
+   */
+  enum ACTIONS {
+    up,
+    down,
+    left,
+    right,
+    fire,
+    confirm,
+    hit,
+    skip,
+    TOTAL_ACTIONS
+  };
+
+  /** @brief Action handler type
+   *
+   * Called with the subscriber's data and an action that was triggered.
+   *
+   */
+  typedef void (*ActionHandler)(void* data, ACTIONS action);
+
+ private:
+  /** @brief Subscriber struct
+   *
+   * One handler listening to one context.
+   *
+   */
+  struct Subscriber {
+    int context;
+    ActionHandler handler;
+    void* data;
+  };
+
+  /** @brief Clock type
+   *
+   * Clock used to time dispatching.
+   *
+   */
+  typedef std::chrono::steady_clock Clock;
+
+  /** @brief Static instance variable
+   *
+   * Used within the Instance function to check if required to create a new
+   * action map.
+   *
+   */
+  static ActionMap* sInstance;
+
+  /** @brief Input variable
+   *
+   * Latched key presses read by 'Dispatch'.
+   *
+   */
+  InputLatch* mInput;
+
+  /** @brief Bindings variable
+   *
+   * One entry per scancode, the action it triggers or -1.
+   *
+   */
+  int mBindings[SDL_NUM_SCANCODES];
+
+  /** @brief Bound keys variable
+   *
+   * Every scancode with an action, so dispatching skips unbound keys.
+   *
+   */
+  std::vector<SDL_Scancode> mBoundKeys;
+
+  /** @brief Triggered variable
+   *
+   * One entry per action, set when it fires in the step being dispatched.
+   *
+   */
+  bool mTriggered[TOTAL_ACTIONS];
+
+  /** @brief Press times variable
+   *
+   * One entry per action, when the key or trigger that last fired it went
+   * down.
+   *
+   */
+  InputQueue::Clock::time_point mPressTimes[TOTAL_ACTIONS];
+
+  /** @brief Subscribers variable
+   *
+   * Every handler in the order it subscribed.
+   *
+   */
+  std::vector<Subscriber> mSubscribers;
+
+  /** @brief Context variable
+   *
+   * Context whose subscribers receive actions.
+   *
+   */
+  int mContext;
+
+  /** @brief Dispatch time variables
+   *
+   * Microseconds spent in the last dispatch, in all dispatches since the last
+   * reset, and the number of those dispatches.
+   *
+   */
+  float mDispatchTime;
+  double mTotalDispatchTime;
+  int mDispatches;
+
+ public:
+  /** @brief Instance function
+   *
+   * Used to create and return an action map if the static instance is null.
+   *
+   */
+  static ActionMap* Instance();
+
+  /** @brief Release function
+   *
+   * Frees the static instance.
+   *
+   *  @return void
+   */
+  static void Release() noexcept;
+
+  /** @brief Bind function
+   *
+   * Makes a key trigger an action. A key triggers at most one action, while
+   * an action may have several keys.
+   *
+   *  @param action, key
+   *  @return void
+   */
+  void Bind(ACTIONS action, SDL_Scancode key);
+
+  /** @brief Unbind function
+   *
+   * Stops a key from triggering anything.
+   *
+   *  @param key
+   *  @return void
+   */
+  void Unbind(SDL_Scancode key);
+
+  /** @brief Rebind function
+   *
+   * Replaces every key of an action with a new one.
+   *
+   *  @param action, key
+   *  @return void
+   */
+  void Rebind(ACTIONS action, SDL_Scancode key);
+
+  /** @brief Subscribe function
+   *
+   * Calls 'handler' with 'data' for every action triggered while 'context' is
+   * active.
+   *
+   *  @param context, handler, data
+   *  @return void
+   */
+  void Subscribe(int context, ActionHandler handler, void* data);
+
+  /** @brief Context function
+   *
+   * Sets the context whose subscribers receive actions.
+   *
+   *  @param context
+   *  @return void
+   */
+  void Context(int context) noexcept;
+
+  /** @brief Trigger function
+   *
+   * Fires an action in the next dispatch without a key press.
+   *
+   *  @param action
+   *  @return void
+   */
+  void Trigger(ACTIONS action) noexcept;
+
+  /** @brief Dispatch function
+   *
+   * Turns the latched presses into actions and calls the active context's
+   * subscribers with each. A subscriber that changes the context only affects
+   * the next dispatch.
+   *
+   *  @return void
+   */
+  void Dispatch();
+
+  /** @brief Press time function
+   *
+   * Used to return when the key that last fired an action went down. Read it
+   * from the action's handler to time how long the action takes to show.
+   *
+   *  @param action
+   *  @return InputQueue::Clock::time_point
+   */
+  InputQueue::Clock::time_point PressTime(ACTIONS action) noexcept;
+
+  /** @brief Dispatch time function
+   *
+   * Used to return the microseconds spent in the last dispatch.
+   *
+   *  @return float
+   */
+  float DispatchTime() noexcept;
+
+  /** @brief Average dispatch time function
+   *
+   * Used to return the average microseconds per dispatch since the last
+   * reset.
+   *
+   *  @return float
+   */
+  float AverageDispatchTime() noexcept;
+
+  /** @brief Reset dispatch time function
+   *
+   * Sets the dispatch timing back to zero.
+   *
+   *  @return void
+   */
+  void ResetDispatchTime() noexcept;
+
+ private:
+  /** @brief Constructor
+   *
+   * Creates the default key bindings.
+   *
+   */
+  ActionMap();
+
+  /** @brief Deconstructor
+   *
+   * Freeing all entities.
+   *
+   */
+  ~ActionMap();
+};
+
+#endif
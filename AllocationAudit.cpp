@@ -0,0 +1,397 @@
+/** @file AllocationAudit.cpp
+ *  @brief Source file for the allocation audit
+ *
+ * This program is responsible for tracking heap allocations made while the
+ * game runs and reporting them frame by frame with where they came from.
+ * Allocations are only seen in builds with ALLOCATION_AUDIT defined.
+ *
+ *  @author Michael Martinez
+ *  @bug No known bugs.
+ */
+#include "AllocationAudit.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <dbghelp.h>
+#else
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#endif
+
+namespace {
+
+// Tags of the allocations made on the current thread
+thread_local const char* tSubsystem = "untagged";
+thread_local int tPhase = -1;
+
+// Set while the stack is captured, in case capturing allocates
+thread_local bool tCapturing = false;
+
+const char* const PHASE_NAMES[] = {"update", "simulate", "record", "render"};
+
+// Frames of the audit and the standard library come before the call site
+const char* const LIBRARY_PREFIXES[] = {"operator new", "std::",
+                                        "__gnu_cxx::"};
+
+void Audit(std::size_t size) noexcept {
+  // One more frame than kept, this function's own
+  void* frames[AllocationAudit::CAPTURED_FRAMES + 1];
+  int count = 0;
+
+  if (!tCapturing) {
+    tCapturing = true;
+#ifdef _WIN32
+    count = CaptureStackBackTrace(0, AllocationAudit::CAPTURED_FRAMES + 1,
+                                  frames, nullptr);
+#else
+    count = backtrace(frames, AllocationAudit::CAPTURED_FRAMES + 1);
+#endif
+    tCapturing = false;
+  }
+
+  AllocationAudit::Allocated(size, frames + 1, count > 0 ? count - 1 : 0);
+}
+
+// Writes the function at 'address', with its file and line where known
+bool Describe(void* address, char* text, std::size_t size) {
+#ifdef _WIN32
+  alignas(SYMBOL_INFO) char buffer[sizeof(SYMBOL_INFO) + MAX_SYM_NAME];
+  SYMBOL_INFO* symbol = reinterpret_cast<SYMBOL_INFO*>(buffer);
+  symbol->SizeOfStruct = sizeof(SYMBOL_INFO);
+  symbol->MaxNameLen = MAX_SYM_NAME;
+
+  const HANDLE process = GetCurrentProcess();
+  const DWORD64 where = reinterpret_cast<DWORD64>(address);
+  DWORD64 offset = 0;
+  if (!SymFromAddr(process, where, &offset, symbol)) return false;
+
+  IMAGEHLP_LINE64 line = {};
+  line.SizeOfStruct = sizeof(line);
+  DWORD column = 0;
+  if (SymGetLineFromAddr64(process, where, &column, &line))
+    std::snprintf(text, size, "%s %s:%lu", symbol->Name, line.FileName,
+                  line.LineNumber);
+  else
+    std::snprintf(text, size, "%s+0x%llx", symbol->Name, offset);
+  return true;
+#else
+  // Names only resolve for exported symbols, e.g. linking with -rdynamic,
+  // otherwise the module and offset are given for addr2line
+  Dl_info info;
+  if (dladdr(address, &info) == 0) return false;
+  if (info.dli_sname == nullptr) {
+    std::snprintf(text, size, "%s+0x%tx", info.dli_fname,
+                  static_cast<char*>(address) -
+                      static_cast<char*>(info.dli_fbase));
+    return true;
+  }
+
+  int status = 0;
+  char* name = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+  std::snprintf(text, size, "%s+0x%tx", status == 0 ? name : info.dli_sname,
+                static_cast<char*>(address) -
+                    static_cast<char*>(info.dli_saddr));
+  std::free(name);
+  return true;
+#endif
+}
+
+bool Library(const char* name) noexcept {
+  // Templates may be named after their return type, e.g. 'void std::'
+  const char* space = std::strchr(name, ' ');
+  const char* args = std::strpbrk(name, "<(");
+  const char* start = space != nullptr && space < args ? space + 1 : name;
+
+  for (const char* prefix : LIBRARY_PREFIXES) {
+    const std::size_t length = std::strlen(prefix);
+    if (std::strncmp(name, prefix, length) == 0 ||
+        std::strncmp(start, prefix, length) == 0)
+      return true;
+  }
+  return false;
+}
+
+}  // namespace
+
+#ifdef ALLOCATION_AUDIT
+void* operator new(std::size_t size) {
+  Audit(size);
+
+  void* pointer = std::malloc(size > 0 ? size : 1);
+  if (pointer == nullptr) throw std::bad_alloc();
+  return pointer;
+}
+
+void* operator new[](std::size_t size) {
+  Audit(size);
+
+  void* pointer = std::malloc(size > 0 ? size : 1);
+  if (pointer == nullptr) throw std::bad_alloc();
+  return pointer;
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+  Audit(size);
+
+  // Sizes are rounded up to the alignment, as aligned_alloc requires
+  const std::size_t align = static_cast<std::size_t>(alignment);
+  const std::size_t rounded = (size + align - 1) / align * align;
+#ifdef _WIN32
+  void* pointer = _aligned_malloc(rounded > 0 ? rounded : align, align);
+#else
+  void* pointer = std::aligned_alloc(align, rounded > 0 ? rounded : align);
+#endif
+  if (pointer == nullptr) throw std::bad_alloc();
+  return pointer;
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+  return operator new(size, alignment);
+}
+
+void operator delete(void* pointer) noexcept {
+  if (pointer != nullptr) AllocationAudit::Freed();
+  std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+  if (pointer != nullptr) AllocationAudit::Freed();
+  std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+  if (pointer != nullptr) AllocationAudit::Freed();
+  std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept {
+  if (pointer != nullptr) AllocationAudit::Freed();
+  std::free(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept {
+  if (pointer != nullptr) AllocationAudit::Freed();
+#ifdef _WIN32
+  _aligned_free(pointer);
+#else
+  std::free(pointer);
+#endif
+}
+
+void operator delete[](void* pointer, std::align_val_t alignment) noexcept {
+  operator delete(pointer, alignment);
+}
+
+void operator delete(void* pointer, std::size_t,
+                     std::align_val_t alignment) noexcept {
+  operator delete(pointer, alignment);
+}
+
+void operator delete[](void* pointer, std::size_t,
+                       std::align_val_t alignment) noexcept {
+  operator delete(pointer, alignment);
+}
+#endif
+
+AllocationAudit* AllocationAudit::sInstance = nullptr;
+
+AllocationAudit* AllocationAudit::Instance() {
+  // C26409: Fixing warning to replace 'new' requires editing included
+  // framework library 'QuickSDL"
+  if (sInstance == nullptr) sInstance = new AllocationAudit();
+
+  return sInstance;
+}
+
+void AllocationAudit::Release() noexcept {
+  // Cleared first, deleting the audit calls operator delete
+  AllocationAudit* audit = sInstance;
+  sInstance = nullptr;
+  delete audit;
+}
+
+// C26455: Fixing the warning 'noexcept' solution is to not include 'noexcept'
+// in the first place.
+//(https://docs.microsoft.com/en-us/cpp/code-quality/c26447?view=msvc-170)
+AllocationAudit::AllocationAudit() {
+  mSiteCount = 0;
+  mFrame = 0;
+  mFrameAllocations = 0;
+  mUnlisted = 0;
+  mAllocations = 0;
+  mAllocatingFrames = 0;
+  mFailures = 0;
+  mFrees = 0;
+  mStrict = false;
+  mLock.clear();
+
+  // Symbols are loaded now, and the first capture may load the unwinder
+#ifdef _WIN32
+  SymSetOptions(SYMOPT_UNDNAME | SYMOPT_DEFERRED_LOADS | SYMOPT_LOAD_LINES);
+  SymInitialize(GetCurrentProcess(), nullptr, TRUE);
+#else
+  void* frame = nullptr;
+  backtrace(&frame, 1);
+#endif
+}
+
+// C26432: deleting all would cause compiling error
+AllocationAudit::~AllocationAudit() {
+#ifdef _WIN32
+  SymCleanup(GetCurrentProcess());
+#endif
+}
+
+bool AllocationAudit::Enabled() noexcept {
+#ifdef ALLOCATION_AUDIT
+  return true;
+#else
+  return false;
+#endif
+}
+
+void AllocationAudit::Tag(const char* subsystem) noexcept {
+  tSubsystem = subsystem;
+}
+
+void AllocationAudit::Phase(PHASES phase) noexcept { tPhase = phase; }
+
+void AllocationAudit::Allocated(std::size_t size, void* const* frames,
+                                int count) noexcept {
+  AllocationAudit* audit = sInstance;
+  if (audit == nullptr) return;
+
+  audit->Lock();
+  audit->mFrameAllocations++;
+  audit->mAllocations++;
+
+  int site = 0;
+  while (site < audit->mSiteCount) {
+    const Site& listed = audit->mSites[site];
+    if (listed.subsystem == tSubsystem && listed.phase == tPhase &&
+        listed.frameCount == count &&
+        std::memcmp(listed.frames, frames, count * sizeof(void*)) == 0)
+      break;
+    site++;
+  }
+
+  if (site == audit->mSiteCount && site < MAX_SITES) {
+    Site& added = audit->mSites[site];
+    added = {tSubsystem, tPhase, {}, count, 0, 0, 0, 0};
+    std::memcpy(added.frames, frames, count * sizeof(void*));
+    audit->mSiteCount++;
+  }
+
+  if (site < MAX_SITES) {
+    audit->mSites[site].count++;
+    audit->mSites[site].step++;
+    audit->mSites[site].bytes += size;
+  } else {
+    audit->mUnlisted++;
+  }
+  audit->Unlock();
+}
+
+void AllocationAudit::Freed() noexcept {
+  AllocationAudit* audit = sInstance;
+  if (audit != nullptr) audit->mFrees++;
+}
+
+void AllocationAudit::Strict(bool strict) noexcept { mStrict = strict; }
+
+void AllocationAudit::EndStep(bool steady) {
+  Lock();
+  int failures = 0;
+  for (int i = 0; i < mSiteCount; i++) {
+    if (steady) mSites[i].steady += mSites[i].step;
+    if (steady) failures += mSites[i].step;
+    mSites[i].step = 0;
+  }
+  mFailures += failures;
+
+  if (mStrict && failures > 0) {
+    std::printf("Allocation audit: %d allocations in steady state play\n",
+                failures);
+    Print();
+    std::fflush(stdout);
+    std::abort();
+  }
+  Unlock();
+}
+
+void AllocationAudit::EndFrame() {
+  Lock();
+  if (mFrameAllocations > 0) {
+    mAllocatingFrames++;
+    Print();
+  }
+
+  mFrame++;
+  mFrameAllocations = 0;
+  mUnlisted = 0;
+  mSiteCount = 0;
+  Unlock();
+}
+
+long long AllocationAudit::Allocations() noexcept { return mAllocations; }
+
+int AllocationAudit::Failures() noexcept { return mFailures; }
+
+void AllocationAudit::Summary() {
+  Lock();
+  std::printf("Allocation audit: %lld allocations and %lld frees over %d "
+              "frames, %d frames allocated, %d allocations in steady state "
+              "play\n",
+              mAllocations, mFrees.load(), mFrame, mAllocatingFrames,
+              mFailures);
+  Unlock();
+}
+
+void AllocationAudit::Lock() noexcept {
+  while (mLock.test_and_set(std::memory_order_acquire)) {
+  }
+}
+
+void AllocationAudit::Unlock() noexcept {
+  mLock.clear(std::memory_order_release);
+}
+
+void AllocationAudit::Print() {
+  std::printf("Frame %d: %d allocations\n", mFrame, mFrameAllocations);
+
+  for (int i = 0; i < mSiteCount; i++) {
+    const Site& site = mSites[i];
+    const char* phase = site.phase >= 0 ? PHASE_NAMES[site.phase] : "other";
+
+    std::printf("  %-12s %-8s %4d calls %8zu bytes%s\n", site.subsystem,
+                phase, site.count, site.bytes,
+                site.steady > 0 ? " (steady state)" : "");
+
+    // The call site and its callers, past the allocator's own frames
+    int shown = 0;
+    bool inLibrary = true;
+    for (int frame = 0; frame < site.frameCount && shown < SHOWN_FRAMES;
+         frame++) {
+      char text[512];
+      if (!Describe(site.frames[frame], text, sizeof(text))) {
+        std::snprintf(text, sizeof(text), "%p", site.frames[frame]);
+      } else if (inLibrary && Library(text)) {
+        continue;
+      }
+
+      inLibrary = false;
+      std::printf("      at %s\n", text);
+      shown++;
+    }
+  }
+
+  if (mUnlisted > 0) std::printf("  %d more at other sites\n", mUnlisted);
+}
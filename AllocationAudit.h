@@ -0,0 +1,290 @@
+/** @file AllocationAudit.h
+ *  @brief Header file for the allocation audit
+ *
+ * This program is responsible for tracking heap allocations made while the
+ * game runs and reporting them frame by frame with where they came from.
+ * Allocations are only seen in builds with ALLOCATION_AUDIT defined.
+ *
+ *  @author Michael Martinez
+ *  @bug No known bugs.
+ */
+#ifndef _ALLOCATIONAUDIT_H
+#define _ALLOCATIONAUDIT_H
+#include <atomic>
+#include <cstddef>
+
+/**
+ * @brief The AllocationAudit class
+ * @author Michael Martinez
+ *
+ * AllocationAudit class which is used to count every call to the global
+ * operator new, aligned or not. Each allocation is tagged with the subsystem
+ * and frame phase last set on its thread and the stack it was called from,
+ * and allocations with the same tags are reported together at the end of the
+ * frame. The report names the first functions outside the audit and the
+ * standard library, with file and line where debug information has them.
+ * Allocations made during a simulation step that started and ended in steady
+ * state play are failures, and in strict mode the first one stops the game.
+ *
+ */
+class AllocationAudit {
+ public:
+  /** @brief enum for frame phases
+   *
+   * Used to tag allocations with the part of the frame that made them.
+   *
+   */
+  enum PHASES { update, simulate, record, render };
+
+  /** @brief Max sites variable
+   *
+   * Number of different tags and call sites reported per frame.
+   *
+   */
+  static const int MAX_SITES = 64;
+
+  /** @brief Frame count variables
+   *
+   * Number of stack frames captured per allocation and printed per site.
+   *
+   */
+  static const int CAPTURED_FRAMES = 16;
+  static const int SHOWN_FRAMES = 4;
+
+ private:
+  /** @brief Site struct
+   *
+   * Allocations of one frame with the same subsystem, phase and call stack,
+   * with how many came in the current step and in steady state.
+   *
+   */
+  struct Site {
+    const char* subsystem;
+    int phase;
+    void* frames[CAPTURED_FRAMES];
+    int frameCount;
+    int count;
+    int step;
+    int steady;
+    std::size_t bytes;
+  };
+
+  /** @brief Static instance variable
+   *
+   * Used within the Instance function to check if required to create a new
+   * allocation audit.
+   *
+   */
+  static AllocationAudit* sInstance;
+
+  /** @brief Sites variable
+   *
+   * Allocations of the current frame by site.
+   *
+   */
+  Site mSites[MAX_SITES];
+
+  /** @brief Site count variable
+   *
+   * Number of sites used in the current frame.
+   *
+   */
+  int mSiteCount;
+
+  /** @brief Frame variables
+   *
+   * Number of the current frame, allocations in it and allocations that had
+   * no free site left.
+   *
+   */
+  int mFrame;
+  int mFrameAllocations;
+  int mUnlisted;
+
+  /** @brief Total variables
+   *
+   * Allocations since the audit started, frames that had any and
+   * allocations made in steady state.
+   *
+   */
+  long long mAllocations;
+  int mAllocatingFrames;
+  int mFailures;
+
+  /** @brief Frees variable
+   *
+   * Calls to the global operator delete since the audit started.
+   *
+   */
+  std::atomic<long long> mFrees;
+
+  /** @brief Strict variable
+   *
+   * True to stop the game at the first steady state allocation.
+   *
+   */
+  bool mStrict;
+
+  /** @brief Lock variable
+   *
+   * Guards the sites, since any thread may allocate.
+   *
+   */
+  std::atomic_flag mLock;
+
+ public:
+  /** @brief Instance function
+   *
+   * Used to create and return an allocation audit if the static instance is
+   * null.
+   *
+   */
+  static AllocationAudit* Instance();
+
+  /** @brief Release function
+   *
+   * Frees the static instance.
+   *
+   *  @return void
+   */
+  static void Release() noexcept;
+
+  /** @brief Enabled function
+   *
+   * Used to return true in builds that hook the global operator new.
+   *
+   *  @return bool
+   */
+  static bool Enabled() noexcept;
+
+  /** @brief Tag function
+   *
+   * Tags allocations on this thread with a subsystem until the next tag.
+   *
+   *  @param subsystem
+   *  @return void
+   */
+  static void Tag(const char* subsystem) noexcept;
+
+  /** @brief Phase function
+   *
+   * Tags allocations on this thread with a frame phase.
+   *
+   *  @param phase
+   *  @return void
+   */
+  static void Phase(PHASES phase) noexcept;
+
+  /** @brief Allocated function
+   *
+   * Records an allocation with the 'count' return addresses of the stack it
+   * came from. Called from the global operator new, so it never allocates
+   * itself.
+   *
+   *  @param size, frames, count
+   *  @return void
+   */
+  static void Allocated(std::size_t size, void* const* frames,
+                        int count) noexcept;
+
+  /** @brief Freed function
+   *
+   * Counts a call to the global operator delete.
+   *
+   *  @return void
+   */
+  static void Freed() noexcept;
+
+  /** @brief Strict function
+   *
+   * Sets whether the first steady state allocation stops the game.
+   *
+   *  @param strict
+   *  @return void
+   */
+  void Strict(bool strict) noexcept;
+
+  /** @brief End step function
+   *
+   * Finishes a simulation step. Its allocations are failures if the step
+   * was steady state play from start to end.
+   *
+   *  @param steady
+   *  @return void
+   */
+  void EndStep(bool steady);
+
+  /** @brief End frame function
+   *
+   * Prints the frame's allocations by site if it had any and starts the next
+   * frame.
+   *
+   *  @return void
+   */
+  void EndFrame();
+
+  /** @brief Allocations function
+   *
+   * Used to return the number of allocations since the audit started.
+   *
+   *  @return long long
+   */
+  long long Allocations() noexcept;
+
+  /** @brief Failures function
+   *
+   * Used to return the number of allocations made in steady state.
+   *
+   *  @return int
+   */
+  int Failures() noexcept;
+
+  /** @brief Summary function
+   *
+   * Prints the allocations, frees and failures since the audit started.
+   *
+   *  @return void
+   */
+  void Summary();
+
+ private:
+  /** @brief Lock function
+   *
+   * Waits until this thread holds the lock.
+   *
+   *  @return void
+   */
+  void Lock() noexcept;
+
+  /** @brief Unlock function
+   *
+   * Lets the next thread take the lock.
+   *
+   *  @return void
+   */
+  void Unlock() noexcept;
+
+  /** @brief Print function
+   *
+   * Prints the frame's allocations by site. Only called with the lock held.
+   *
+   *  @return void
+   */
+  void Print();
+
+  /** @brief Constructor
+   *
+   * Creates an audit with nothing recorded.
+   *
+   */
+  AllocationAudit();
+
+  /** @brief Deconstructor
+   *
+   * Freeing all entities.
+   *
+   */
+  ~AllocationAudit();
+};
+
+#endif
@@ -0,0 +1,208 @@
+/** @file Animations.cpp
+ *  @brief Source file for the animation registry
+ *
+ * This program is responsible for advancing every sprite sheet animation in
+ * the game in one pass per simulation step.
+ *
+ *  @author Michael Martinez
+ *  @bug No known bugs.
+ */
+#include "Animations.h"
+
+#include <utility>
+
+#include "TextureState.h"
+
+Animations* Animations::sInstance = nullptr;
+
+Animations* Animations::Instance() {
+  // C26409: Fixing warning to replace 'new' requires editing included
+  // framework library 'QuickSDL"
+  if (sInstance == nullptr) sInstance = new Animations();
+
+  return sInstance;
+}
+
+void Animations::Release() noexcept {
+  delete sInstance;
+  sInstance = nullptr;
+}
+
+// C26455: Fixing the warning 'noexcept' solution is to not include 'noexcept'
+// in the first place.
+//(https://docs.microsoft.com/en-us/cpp/code-quality/c26447?view=msvc-170)
+Animations::Animations() {
+  mTimer = FixedTimer::Instance();
+  mRunning = 0;
+}
+
+// C26432: deleting all would cause compiling error
+Animations::~Animations() { mTimer = nullptr; }
+
+int Animations::Add(Texture* texture, int frameCount, float animationSpeed,
+                    AnimatedTexture::ANIM_DIR direction,
+                    AnimatedTexture::WRAP_MODE wrapMode) {
+  SDL_Rect* clip = &(texture->*TextureState::Clip());
+
+  mClips.push_back(clip);
+  mStartX.push_back(clip->x);
+  mStartY.push_back(clip->y);
+  mStrideX.push_back(direction == AnimatedTexture::horizontal ? clip->w : 0);
+  mStrideY.push_back(direction == AnimatedTexture::vertical ? clip->h : 0);
+  mTimers.push_back(0.0f);
+  mSpeeds.push_back(animationSpeed);
+  mFrameTimes.push_back(animationSpeed / frameCount);
+  mFrames.push_back(0);
+  mLoops.push_back(wrapMode == AnimatedTexture::loop);
+  mPaused.push_back(false);
+  mDone.push_back(false);
+
+  int handle = 0;
+  if (mFreeHandles.empty()) {
+    handle = mSlots.size();
+    mSlots.push_back(0);
+  } else {
+    handle = mFreeHandles.back();
+    mFreeHandles.pop_back();
+  }
+
+  const int slot = mHandles.size();
+  mHandles.push_back(handle);
+  mSlots[handle] = slot;
+  Refresh(slot);
+
+  return handle;
+}
+
+void Animations::Remove(int handle) {
+  // Stop it first so it sits past the running slots, then move it last
+  mPaused[mSlots[handle]] = true;
+  Refresh(mSlots[handle]);
+  Swap(mSlots[handle], mHandles.size() - 1);
+
+  mClips.pop_back();
+  mStartX.pop_back();
+  mStartY.pop_back();
+  mStrideX.pop_back();
+  mStrideY.pop_back();
+  mTimers.pop_back();
+  mSpeeds.pop_back();
+  mFrameTimes.pop_back();
+  mFrames.pop_back();
+  mLoops.pop_back();
+  mPaused.pop_back();
+  mDone.pop_back();
+  mHandles.pop_back();
+
+  mSlots[handle] = -1;
+  mFreeHandles.push_back(handle);
+}
+
+void Animations::Reset(int handle) noexcept {
+  const int slot = mSlots[handle];
+
+  mTimers[slot] = 0.0f;
+  mFrames[slot] = 0;
+  mPaused[slot] = false;
+  mDone[slot] = false;
+  ShowFrame(slot);
+  Refresh(slot);
+}
+
+void Animations::Pause(int handle, bool paused) noexcept {
+  const int slot = mSlots[handle];
+  if (mPaused[slot] == paused) return;
+
+  mPaused[slot] = paused;
+  Refresh(slot);
+}
+
+bool Animations::Animating(int handle) noexcept {
+  return !mDone[mSlots[handle]];
+}
+
+void Animations::Advance(float deltaTime) noexcept {
+  float* timers = mTimers.data();
+  const float* speeds = mSpeeds.data();
+  const float* frameTimes = mFrameTimes.data();
+  int* frames = mFrames.data();
+
+  int slot = 0;
+  while (slot < mRunning) {
+    float timer = timers[slot] + deltaTime;
+    bool done = false;
+
+    // Flags are only read once an animation reaches its end
+    if (timer >= speeds[slot]) {
+      if (mLoops[slot]) {
+        timer -= speeds[slot];
+      } else {
+        // Stays on the last frame like 'AnimatedTexture'
+        done = true;
+        timer = speeds[slot] - frameTimes[slot];
+      }
+    }
+    timers[slot] = timer;
+
+    const int frame = static_cast<int>(timer / frameTimes[slot]);
+    if (frame != frames[slot]) {
+      frames[slot] = frame;
+      ShowFrame(slot);
+    }
+
+    // A finished animation swaps with the last running one, which is
+    // advanced next from this same slot
+    if (done) {
+      mDone[slot] = true;
+      mRunning--;
+      Swap(slot, mRunning);
+    } else {
+      slot++;
+    }
+  }
+}
+
+void Animations::Update() noexcept { Advance(mTimer->DeltaTime()); }
+
+int Animations::Count() noexcept { return mHandles.size(); }
+
+int Animations::Running() noexcept { return mRunning; }
+
+void Animations::Swap(int a, int b) noexcept {
+  if (a == b) return;
+
+  std::swap(mClips[a], mClips[b]);
+  std::swap(mStartX[a], mStartX[b]);
+  std::swap(mStartY[a], mStartY[b]);
+  std::swap(mStrideX[a], mStrideX[b]);
+  std::swap(mStrideY[a], mStrideY[b]);
+  std::swap(mTimers[a], mTimers[b]);
+  std::swap(mSpeeds[a], mSpeeds[b]);
+  std::swap(mFrameTimes[a], mFrameTimes[b]);
+  std::swap(mFrames[a], mFrames[b]);
+  std::vector<bool>::swap(mLoops[a], mLoops[b]);
+  std::vector<bool>::swap(mPaused[a], mPaused[b]);
+  std::vector<bool>::swap(mDone[a], mDone[b]);
+  std::swap(mHandles[a], mHandles[b]);
+
+  mSlots[mHandles[a]] = a;
+  mSlots[mHandles[b]] = b;
+}
+
+void Animations::Refresh(int slot) noexcept {
+  const bool running = !mPaused[slot] && !mDone[slot];
+
+  if (running && slot >= mRunning) {
+    Swap(slot, mRunning);
+    mRunning++;
+  } else if (!running && slot < mRunning) {
+    mRunning--;
+    Swap(slot, mRunning);
+  }
+}
+
+void Animations::ShowFrame(int slot) noexcept {
+  SDL_Rect* clip = mClips[slot];
+  clip->x = mStartX[slot] + mFrames[slot] * mStrideX[slot];
+  clip->y = mStartY[slot] + mFrames[slot] * mStrideY[slot];
+}
@@ -0,0 +1,271 @@
+/** @file Animations.h
+ *  @brief Header file for the animation registry
+ *
+ * This program is responsible for advancing every sprite sheet animation in
+ * the game in one pass per simulation step.
+ *
+ *  @author Michael Martinez
+ *  @bug No known bugs.
+ */
+#ifndef _ANIMATIONS_H
+#define _ANIMATIONS_H
+#include <vector>
+
+#include "AnimatedTexture.h"
+#include "FixedTimer.h"
+
+using namespace QuickSDL;
+
+/**
+ * @brief The Animations class
+ * @author Michael Martinez
+ *
+ * Animations class which is used to own the state of every animation in
+ * packed arrays. An animation drives the clip of a clipped texture across a
+ * sprite sheet the same way 'AnimatedTexture' does. Animations that are
+ * running are kept at the front of the arrays so paused and finished ones are
+ * never touched by 'Advance'.
+ *
+ */
+class Animations {
+ private:
+  /** @brief Static instance variable
+   *
+   * Used within the Instance function to check if required to create a new
+   * animation registry.
+   *
+   */
+  static Animations* sInstance;
+
+  /** @brief Timer variable
+   *
+   * Used to get the length of a simulation step.
+   *
+   */
+  FixedTimer* mTimer;
+
+  /** @brief Clips variable
+   *
+   * Clip rectangle inside the texture each animation drives.
+   *
+   */
+  std::vector<SDL_Rect*> mClips;
+
+  /** @brief Start variables
+   *
+   * Top left corner of the first frame on the sprite sheet.
+   *
+   */
+  std::vector<int> mStartX;
+  std::vector<int> mStartY;
+
+  /** @brief Stride variables
+   *
+   * Distance from one frame to the next, the frame width for horizontal
+   * sheets or the frame height for vertical ones.
+   *
+   */
+  std::vector<int> mStrideX;
+  std::vector<int> mStrideY;
+
+  /** @brief Timing variables
+   *
+   * Time into the animation, length of the whole animation and length of one
+   * frame, all in seconds.
+   *
+   */
+  std::vector<float> mTimers;
+  std::vector<float> mSpeeds;
+  std::vector<float> mFrameTimes;
+
+  /** @brief Frames variable
+   *
+   * Frame each animation is showing.
+   *
+   */
+  std::vector<int> mFrames;
+
+  /** @brief State variables
+   *
+   * Whether each animation loops, is paused or has finished playing once.
+   *
+   */
+  std::vector<bool> mLoops;
+  std::vector<bool> mPaused;
+  std::vector<bool> mDone;
+
+  /** @brief Handles variable
+   *
+   * Handle of the animation in each packed slot.
+   *
+   */
+  std::vector<int> mHandles;
+
+  /** @brief Slots variable
+   *
+   * Packed slot of each handle, or -1 if the handle is free.
+   *
+   */
+  std::vector<int> mSlots;
+
+  /** @brief Free handles variable
+   *
+   * Handles of removed animations, reused by 'Add'.
+   *
+   */
+  std::vector<int> mFreeHandles;
+
+  /** @brief Running variable
+   *
+   * Number of animations at the front of the arrays that are running.
+   *
+   */
+  int mRunning;
+
+ public:
+  /** @brief Instance function
+   *
+   * Used to create and return an animation registry if the static instance
+   * is null.
+   *
+   */
+  static Animations* Instance();
+
+  /** @brief Release function
+   *
+   * Frees the static instance.
+   *
+   *  @return void
+   */
+  static void Release() noexcept;
+
+  /** @brief Add function
+   *
+   * Starts animating a texture created with a clip of one frame. Frames
+   * follow the first one across the sheet in 'direction' and the whole
+   * animation takes 'animationSpeed' seconds. Returns the animation's handle.
+   *
+   *  @param texture, frameCount, animationSpeed, direction, wrapMode
+   *  @return int
+   */
+  int Add(Texture* texture, int frameCount, float animationSpeed,
+          AnimatedTexture::ANIM_DIR direction,
+          AnimatedTexture::WRAP_MODE wrapMode = AnimatedTexture::loop);
+
+  /** @brief Remove function
+   *
+   * Stops an animation and frees its handle. The texture is left on the
+   * frame it was showing.
+   *
+   *  @param handle
+   *  @return void
+   */
+  void Remove(int handle);
+
+  /** @brief Reset function
+   *
+   * Plays an animation again from its first frame, resuming it if paused.
+   *
+   *  @param handle
+   *  @return void
+   */
+  void Reset(int handle) noexcept;
+
+  /** @brief Pause function
+   *
+   * Stops or resumes advancing an animation.
+   *
+   *  @param handle, paused
+   *  @return void
+   */
+  void Pause(int handle, bool paused) noexcept;
+
+  /** @brief Animating function
+   *
+   * Used to return false once an animation that does not loop has played
+   * through.
+   *
+   *  @param handle
+   *  @return bool
+   */
+  bool Animating(int handle) noexcept;
+
+  /** @brief Advance function
+   *
+   * Moves every running animation forward by 'deltaTime'. A texture's clip is
+   * only written when its frame changes.
+   *
+   *  @param deltaTime
+   *  @return void
+   */
+  void Advance(float deltaTime) noexcept;
+
+  /** @brief Update function
+   *
+   * Advances every running animation by one simulation step.
+   *
+   *  @return void
+   */
+  void Update() noexcept;
+
+  /** @brief Count function
+   *
+   * Used to return the number of animations.
+   *
+   *  @return int
+   */
+  int Count() noexcept;
+
+  /** @brief Running function
+   *
+   * Used to return the number of animations that are running.
+   *
+   *  @return int
+   */
+  int Running() noexcept;
+
+ private:
+  /** @brief Swap function
+   *
+   * Exchanges two packed slots and updates their handles.
+   *
+   *  @param a, b
+   *  @return void
+   */
+  void Swap(int a, int b) noexcept;
+
+  /** @brief Refresh function
+   *
+   * Moves an animation in or out of the running slots after its state
+   * changed.
+   *
+   *  @param slot
+   *  @return void
+   */
+  void Refresh(int slot) noexcept;
+
+  /** @brief Show frame function
+   *
+   * Moves a texture's clip to its animation's current frame.
+   *
+   *  @param slot
+   *  @return void
+   */
+  void ShowFrame(int slot) noexcept;
+
+  /** @brief Constructor
+   *
+   * Creates an empty registry.
+   *
+   */
+  Animations();
+
+  /** @brief Deconstructor
+   *
+   * Freeing all entities.
+   *
+   */
+  ~Animations();
+};
+
+#endif
@@ -0,0 +1,250 @@
+/** @file AttackVM.cpp
+ *  @brief Source file for the attack pattern virtual machine
+ *
+ * This program is responsible for compiling attack pattern scripts into
+ * bytecode and running them for every active emitter. Emitters write the
+ * projectiles they fire straight into the projectile pool.
+ *
+ *  @author Michael Martinez
+ *  @bug No known bugs.
+ */
+#include "AttackVM.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <sstream>
+
+AttackVM::AttackVM(Projectiles* projectiles, int capacity) {
+  mProjectiles = projectiles;
+  mTarget = VEC2_ZERO;
+
+  mCapacity = capacity;
+  mCount = 0;
+
+  // Emitter slots are only allocated here, never while playing
+  mPc.resize(mCapacity);
+  mWait.resize(mCapacity);
+  mX.resize(mCapacity);
+  mY.resize(mCapacity);
+  mRegisters.resize(mCapacity * REGISTERS);
+
+  mInstructions = 0;
+}
+
+int AttackVM::Compile(const std::string& source) {
+  // Operand kinds: 'r' register, 'v' value, 'l' label
+  struct OpInfo {
+    const char* name;
+    OPCODES op;
+    const char* operands;
+  };
+  static const OpInfo ops[] = {
+      {"set", op_set, "rv"},       {"mov", op_mov, "rr"},
+      {"add", op_add, "rrr"},      {"addi", op_addi, "rrv"},
+      {"mul", op_mul, "rrr"},      {"muli", op_muli, "rrv"},
+      {"sin", op_sin, "rr"},       {"cos", op_cos, "rr"},
+      {"aim", op_aim, "r"},        {"fire", op_fire, "rrv"},
+      {"wait", op_wait, "v"},      {"decjnz", op_decjnz, "rl"},
+      {"jmp", op_jmp, "l"},        {"end", op_end, ""}};
+
+  const int start = mCode.size();
+
+  // First pass splits lines into words and records where labels point
+  std::vector<std::vector<std::string>> lines;
+  std::map<std::string, int> labels;
+
+  std::istringstream stream(source);
+  std::string line;
+  while (std::getline(stream, line)) {
+    line = line.substr(0, line.find(';'));
+
+    std::istringstream words(line);
+    std::vector<std::string> tokens;
+    std::string word;
+    while (words >> word) tokens.push_back(word);
+
+    if (!tokens.empty() && tokens[0].back() == ':') {
+      const std::string name = tokens[0].substr(0, tokens[0].size() - 1);
+      if (labels.count(name) != 0) return -1;
+
+      labels[name] = start + lines.size();
+      tokens.erase(tokens.begin());
+    }
+
+    if (!tokens.empty()) lines.push_back(tokens);
+  }
+
+  // Second pass encodes every instruction
+  std::vector<Instruction> code;
+  for (const std::vector<std::string>& tokens : lines) {
+    const OpInfo* info = nullptr;
+    for (const OpInfo& candidate : ops) {
+      if (tokens[0] == candidate.name) info = &candidate;
+    }
+    if (info == nullptr) return -1;
+    if (tokens.size() != std::strlen(info->operands) + 1) return -1;
+
+    Instruction instruction = {static_cast<unsigned char>(info->op), 0, 0, 0,
+                               0.0f};
+    int registers = 0;
+
+    for (unsigned int i = 1; i < tokens.size(); i++) {
+      const std::string& token = tokens[i];
+      char* end = nullptr;
+
+      switch (info->operands[i - 1]) {
+        case 'r': {
+          if (token.size() < 2 || token[0] != 'r') return -1;
+          const long reg = std::strtol(token.c_str() + 1, &end, 10);
+          if (*end != '\0' || reg < 0 || reg >= REGISTERS) return -1;
+
+          unsigned char* fields[] = {&instruction.a, &instruction.b,
+                                     &instruction.c};
+          *fields[registers++] = static_cast<unsigned char>(reg);
+          break;
+        }
+
+        case 'v':
+          instruction.value = std::strtof(token.c_str(), &end);
+          if (*end != '\0') return -1;
+          break;
+
+        default:
+          if (labels.count(token) == 0) return -1;
+          instruction.value = static_cast<float>(labels[token]);
+          break;
+      }
+    }
+
+    code.push_back(instruction);
+  }
+
+  // Every script ends, even if its last line does not say so
+  code.push_back({static_cast<unsigned char>(op_end), 0, 0, 0, 0.0f});
+
+  mCode.insert(mCode.end(), code.begin(), code.end());
+  return start;
+}
+
+int AttackVM::Emit(int script, Vector2 pos) noexcept {
+  if (script < 0 || mCount >= mCapacity) return -1;
+
+  const int slot = mCount++;
+  mPc[slot] = script;
+  mWait[slot] = 0.0f;
+  mX[slot] = pos.x;
+  mY[slot] = pos.y;
+  for (int i = 0; i < REGISTERS; i++) mRegisters[slot * REGISTERS + i] = 0.0f;
+
+  return slot;
+}
+
+void AttackVM::Kill(int slot) noexcept {
+  // Keep running emitters packed by moving the last one into the freed slot
+  const int last = --mCount;
+  mPc[slot] = mPc[last];
+  mWait[slot] = mWait[last];
+  mX[slot] = mX[last];
+  mY[slot] = mY[last];
+  for (int i = 0; i < REGISTERS; i++)
+    mRegisters[slot * REGISTERS + i] = mRegisters[last * REGISTERS + i];
+}
+
+void AttackVM::Clear() noexcept { mCount = 0; }
+
+int AttackVM::Count() noexcept { return mCount; }
+
+void AttackVM::Target(Vector2 target) noexcept { mTarget = target; }
+
+void AttackVM::Run(float deltaTime) noexcept {
+  long long executed = 0;
+
+  int slot = 0;
+  while (slot < mCount) {
+    if (mWait[slot] > 0.0f) {
+      mWait[slot] -= deltaTime;
+      if (mWait[slot] > 0.0f) {
+        slot++;
+        continue;
+      }
+    }
+
+    float* r = &mRegisters[slot * REGISTERS];
+    int pc = mPc[slot];
+    bool waiting = false;
+    bool finished = false;
+
+    for (int step = 0; step < MAX_INSTRUCTIONS && !waiting && !finished;
+         step++) {
+      const Instruction& in = mCode[pc++];
+      executed++;
+
+      // C26812: Changing 'enum' to 'enum class' would cause compilation
+      // error, making all types into undeclared identifiers
+      switch (in.op) {
+        case op_set:
+          r[in.a] = in.value;
+          break;
+        case op_mov:
+          r[in.a] = r[in.b];
+          break;
+        case op_add:
+          r[in.a] = r[in.b] + r[in.c];
+          break;
+        case op_addi:
+          r[in.a] = r[in.b] + in.value;
+          break;
+        case op_mul:
+          r[in.a] = r[in.b] * r[in.c];
+          break;
+        case op_muli:
+          r[in.a] = r[in.b] * in.value;
+          break;
+        case op_sin:
+          r[in.a] = std::sin(r[in.b]);
+          break;
+        case op_cos:
+          r[in.a] = std::cos(r[in.b]);
+          break;
+        case op_aim:
+          r[in.a] = std::atan2(mTarget.y - mY[slot], mTarget.x - mX[slot]);
+          break;
+        case op_fire:
+          mProjectiles->Spawn(mX[slot], mY[slot], r[in.a], r[in.b],
+                              static_cast<int>(in.value));
+          break;
+        case op_wait:
+          // Time left over from the last wait carries into this one
+          mWait[slot] += in.value;
+          waiting = true;
+          break;
+        case op_decjnz:
+          r[in.a] -= 1.0f;
+          if (r[in.a] > 0.0f) pc = static_cast<int>(in.value);
+          break;
+        case op_jmp:
+          pc = static_cast<int>(in.value);
+          break;
+        default:
+          finished = true;
+          break;
+      }
+    }
+
+    mPc[slot] = pc;
+
+    // A removed slot is refilled by the last emitter, so run it next
+    if (finished)
+      Kill(slot);
+    else
+      slot++;
+  }
+
+  mInstructions += executed;
+}
+
+long long AttackVM::Instructions() noexcept { return mInstructions; }
+
+void AttackVM::ResetInstructions() noexcept { mInstructions = 0; }
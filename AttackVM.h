@@ -0,0 +1,248 @@
+/** @file AttackVM.h
+ *  @brief Header file for the attack pattern virtual machine
+ *
+ * This program is responsible for compiling attack pattern scripts into
+ * bytecode and running them for every active emitter. Emitters write the
+ * projectiles they fire straight into the projectile pool.
+ *
+ *  @author Michael Martinez
+ *  @bug No known bugs.
+ */
+#ifndef _ATTACKVM_H
+#define _ATTACKVM_H
+#include <string>
+#include <vector>
+
+#include "Projectiles.h"
+
+/**
+ * @brief The AttackVM class
+ * @author Michael Martinez
+ *
+ * AttackVM class which is used to run register based bytecode for virus
+ * attack patterns.
+ *
+ * Scripts are one instruction per line, ';' starts a comment and 'name:'
+ * marks a jump label. Registers are r0 to r7 and keep their values between
+ * frames.
+ *
+ *  set rA value       rA = value
+ *  mov rA rB          rA = rB
+ *  add rA rB rC       rA = rB + rC
+ *  addi rA rB value   rA = rB + value
+ *  mul rA rB rC       rA = rB * rC
+ *  muli rA rB value   rA = rB * value
+ *  sin rA rB          rA = sin(rB)
+ *  cos rA rB          rA = cos(rB)
+ *  aim rA             rA = angle from the emitter to the target
+ *  fire rA rB flags   fires at angle rA with speed rB
+ *  wait seconds       resumes on the next instruction once time has passed
+ *  decjnz rA label    rA = rA - 1, jumps to label while rA is above zero
+ *  jmp label          jumps to label
+ *  end                frees the emitter
+ *
+ */
+class AttackVM {
+ public:
+  /** @brief enum for opcodes
+   *
+   * One value per instruction.
+   *
+   */
+  enum OPCODES {
+    op_set,
+    op_mov,
+    op_add,
+    op_addi,
+    op_mul,
+    op_muli,
+    op_sin,
+    op_cos,
+    op_aim,
+    op_fire,
+    op_wait,
+    op_decjnz,
+    op_jmp,
+    op_end
+  };
+
+  /** @brief Registers variable
+   *
+   * Number of registers each emitter has.
+   *
+   */
+  static const int REGISTERS = 8;
+
+  /** @brief Default capacity variable
+   *
+   * Number of emitter slots for a normal stage.
+   *
+   */
+  static const int DEFAULT_CAPACITY = 32;
+
+ private:
+  /** @brief Instruction struct
+   *
+   * One compiled instruction. 'a', 'b' and 'c' are register numbers and
+   * 'value' holds immediates, flags and jump targets.
+   *
+   */
+  struct Instruction {
+    unsigned char op;
+    unsigned char a;
+    unsigned char b;
+    unsigned char c;
+    float value;
+  };
+
+  /** @brief Max instructions variable
+   *
+   * Most instructions one emitter may run in a frame, so a loop without a
+   * 'wait' cannot stall the game.
+   *
+   */
+  static const int MAX_INSTRUCTIONS = 256;
+
+  /** @brief Projectiles variable
+   *
+   * Pool every 'fire' instruction writes into.
+   *
+   */
+  Projectiles* mProjectiles;
+
+  /** @brief Code variable
+   *
+   * Bytecode of every compiled script.
+   *
+   */
+  std::vector<Instruction> mCode;
+
+  /** @brief Target variable
+   *
+   * Position the 'aim' instruction measures towards.
+   *
+   */
+  Vector2 mTarget;
+
+  /** @brief Capacity variable
+   *
+   * Number of preallocated emitter slots.
+   *
+   */
+  int mCapacity;
+
+  /** @brief Count variable
+   *
+   * Number of running emitters. Running emitters fill slots 0 to mCount - 1.
+   *
+   */
+  int mCount;
+
+  /** @brief Packed emitter state
+   *
+   * One array per field, indexed by slot. 'mRegisters' holds REGISTERS
+   * values per slot.
+   *
+   */
+  std::vector<int> mPc;
+  std::vector<float> mWait;
+  std::vector<float> mX;
+  std::vector<float> mY;
+  std::vector<float> mRegisters;
+
+  /** @brief Instructions variable
+   *
+   * Number of instructions run since the last reset.
+   *
+   */
+  long long mInstructions;
+
+ private:
+  /** @brief Kill function
+   *
+   * Frees a slot by moving the last running emitter into it.
+   *
+   *  @param slot
+   *  @return void
+   */
+  void Kill(int slot) noexcept;
+
+ public:
+  /** @brief Constructor
+   *
+   * Preallocates every emitter slot.
+   *
+   *  @param projectiles, capacity
+   */
+  AttackVM(Projectiles* projectiles, int capacity = DEFAULT_CAPACITY);
+
+  /** @brief Compile function
+   *
+   * Turns a script into bytecode.
+   *
+   *  @param source
+   *  @return int script id, or -1 if the script has an error
+   */
+  int Compile(const std::string& source);
+
+  /** @brief Emit function
+   *
+   * Starts a script from a position.
+   *
+   *  @param script, pos
+   *  @return int slot, or -1 if every slot is taken
+   */
+  int Emit(int script, Vector2 pos) noexcept;
+
+  /** @brief Clear function
+   *
+   * Stops every emitter.
+   *
+   *  @return void
+   */
+  void Clear() noexcept;
+
+  /** @brief Count function
+   *
+   * Used to return the number of running emitters.
+   *
+   *  @return int
+   */
+  int Count() noexcept;
+
+  /** @brief Target function
+   *
+   * Sets the position the 'aim' instruction measures towards.
+   *
+   *  @param target
+   *  @return void
+   */
+  void Target(Vector2 target) noexcept;
+
+  /** @brief Run function
+   *
+   * Runs every emitter until it waits or ends.
+   *
+   *  @param deltaTime
+   *  @return void
+   */
+  void Run(float deltaTime) noexcept;
+
+  /** @brief Instructions function
+   *
+   * Used to return the number of instructions run since the last reset.
+   *
+   *  @return long long
+   */
+  long long Instructions() noexcept;
+
+  /** @brief Reset instructions function
+   *
+   * Sets the instruction counter back to zero.
+   *
+   *  @return void
+   */
+  void ResetInstructions() noexcept;
+};
+
+#endif
@@ -0,0 +1,33 @@
+/** @file AudioQueue.cpp
+ *  @brief Source file for the audio message queue
+ *
+ * This program is responsible for passing audio commands to the audio thread
+ * and audio events back to the game without locks.
+ *
+ *  @author Michael Martinez
+ *  @bug No known bugs.
+ */
+#include "AudioQueue.h"
+
+AudioQueue::AudioQueue() noexcept {
+  mHead = 0;
+  mTail = 0;
+}
+
+bool AudioQueue::Push(const Message& message) noexcept {
+  const unsigned int tail = mTail.load(std::memory_order_relaxed);
+  if (tail - mHead.load(std::memory_order_acquire) == CAPACITY) return false;
+
+  mMessages[tail & (CAPACITY - 1)] = message;
+  mTail.store(tail + 1, std::memory_order_release);
+  return true;
+}
+
+bool AudioQueue::Pop(Message& message) noexcept {
+  const unsigned int head = mHead.load(std::memory_order_relaxed);
+  if (head == mTail.load(std::memory_order_acquire)) return false;
+
+  message = mMessages[head & (CAPACITY - 1)];
+  mHead.store(head + 1, std::memory_order_release);
+  return true;
+}
@@ -0,0 +1,112 @@
+/** @file AudioQueue.h
+ *  @brief Header file for the audio message queue
+ *
+ * This program is responsible for passing audio commands to the audio thread
+ * and audio events back to the game without locks.
+ *
+ *  @author Michael Martinez
+ *  @bug No known bugs.
+ */
+#ifndef _AUDIOQUEUE_H
+#define _AUDIOQUEUE_H
+#include <atomic>
+
+/**
+ * @brief The AudioQueue class
+ * @author Michael Martinez
+ *
+ * AudioQueue class which is used as a fixed size ring buffer with exactly one
+ * producer and one consumer. Each side only writes its own index, so pushing
+ * and popping never wait.
+ *
+ */
+class AudioQueue {
+ public:
+  /** @brief enum for messages
+   *
+   * Commands sent to the audio thread and events sent back from it.
+   *
+   */
+  enum MESSAGES {
+    playMusic,
+    pauseMusic,
+    resumeMusic,
+    loadSFX,
+    playSFX,
+    musicFinished
+  };
+
+  /** @brief Message struct
+   *
+   * One command or event. 'filename' points at a string that outlives the
+   * message, in practice a string literal. 'sound' is the handle of a loaded
+   * sound effect, played at 'gain' and 'pan'.
+   *
+   */
+  struct Message {
+    MESSAGES type;
+    const char* filename;
+    int loops;
+    int sound;
+    float gain = 1.0f;
+    float pan = 0.0f;
+  };
+
+  /** @brief Capacity variable
+   *
+   * Number of messages the queue holds. A power of two so indices wrap with
+   * a mask.
+   *
+   */
+  static const int CAPACITY = 256;
+
+ private:
+  /** @brief Messages variable
+   *
+   * Ring buffer storage.
+   *
+   */
+  Message mMessages[CAPACITY];
+
+  /** @brief Head variable
+   *
+   * Index of the next message to pop. Only written by the consumer.
+   *
+   */
+  std::atomic<unsigned int> mHead;
+
+  /** @brief Tail variable
+   *
+   * Index of the next message to push. Only written by the producer.
+   *
+   */
+  std::atomic<unsigned int> mTail;
+
+ public:
+  /** @brief Constructor
+   *
+   * Creates an empty queue.
+   *
+   */
+  AudioQueue() noexcept;
+
+  /** @brief Push function
+   *
+   * Adds a message. Only called from the producer thread.
+   *
+   *  @param message
+   *  @return bool false if the queue is full and the message was dropped
+   */
+  bool Push(const Message& message) noexcept;
+
+  /** @brief Pop function
+   *
+   * Removes the oldest message. Only called from the consumer thread.
+   *
+   *  @param message
+   *  @return bool false if the queue is empty
+   */
+  bool Pop(Message& message) noexcept;
+};
+
+#endif
@@ -0,0 +1,380 @@
+/** @file AudioThread.cpp
+ *  @brief Source file for the audio thread
+ *
+ * This program is responsible for playing music and sound effects on a
+ * thread of its own, so gameplay never waits on the mixer.
+ *
+ *  @author Michael Martinez
+ *  @bug No known bugs.
+ */
+#include "AudioThread.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <string>
+
+#include "AllocationAudit.h"
+
+AudioThread* AudioThread::sInstance = nullptr;
+
+AudioThread* AudioThread::Instance() {
+  // C26409: Fixing warning to replace 'new' requires editing included
+  // framework library 'QuickSDL"
+  if (sInstance == nullptr) sInstance = new AudioThread();
+
+  return sInstance;
+}
+
+void AudioThread::Release() noexcept {
+  delete sInstance;
+  sInstance = nullptr;
+}
+
+// C26455: Fixing the warning 'noexcept' solution is to not include 'noexcept'
+// in the first place.
+//(https://docs.microsoft.com/en-us/cpp/code-quality/c26447?view=msvc-170)
+AudioThread::AudioThread() {
+  mAudio = AudioManager::Instance();
+  // C26409: Fixing warning to replace 'new' requires editing included
+  // framework library 'QuickSDL"
+  mMusic = new MusicStream();
+  mStreaming = false;
+  mMixer = new SoftwareMixer();
+#ifdef SOFTWARE_MIXER
+  mMixing = mMixer->Start();
+#else
+  mMixing = false;
+#endif
+  mMusicFinished = false;
+  mDropped = 0;
+  mQuit = false;
+
+  mSoundCount = 0;
+  mLimited = 0;
+
+  // Sound effects only play on the voices
+  Mix_AllocateChannels(VOICES);
+  for (int i = 0; i < VOICES; i++) mVoices[i] = {-1, 0, 0};
+  mVoiceOrder = 0;
+  ResetStatistics();
+
+  Mix_HookMusicFinished(MusicFinished);
+  mThread = std::thread(&AudioThread::Run, this);
+}
+
+// C26432: deleting all would cause compiling error
+AudioThread::~AudioThread() {
+  mQuit = true;
+  mThread.join();
+
+  // The audio thread has stopped, so the stream is only used here now
+  StopStream();
+  delete mMusic;
+  mMusic = nullptr;
+  delete mMixer;
+  mMixer = nullptr;
+
+  Mix_HookMusicFinished(nullptr);
+  mAudio = nullptr;
+}
+
+void AudioThread::PlayMusic(const char* filename, int loops) noexcept {
+  Send({AudioQueue::playMusic, filename, loops, 0});
+}
+
+void AudioThread::PauseMusic() noexcept {
+  Send({AudioQueue::pauseMusic, nullptr, 0, 0});
+}
+
+void AudioThread::ResumeMusic() noexcept {
+  Send({AudioQueue::resumeMusic, nullptr, 0, 0});
+}
+
+int AudioThread::LoadSFX(const char* filename, int priority, int maxVoices,
+                         int maxPerFrame) noexcept {
+  for (int i = 0; i < mSoundCount; i++) {
+    if (std::strcmp(mSounds[i].filename, filename) == 0) return i;
+  }
+
+  if (mSoundCount == MAX_SOUNDS) return -1;
+
+  // Filled in before the load is queued, the audio thread reads it after
+  const int sound = mSoundCount++;
+  mSounds[sound] = {filename, nullptr, priority, maxVoices, maxPerFrame, 0};
+  Send({AudioQueue::loadSFX, filename, 0, sound});
+
+  return sound;
+}
+
+void AudioThread::PlaySFX(int sound, int loops, float gain,
+                          float pan) noexcept {
+  if (sound < 0) return;
+
+  Sound& played = mSounds[sound];
+  if (played.triggers >= played.maxPerFrame) {
+    mLimited++;
+    return;
+  }
+
+  played.triggers++;
+  Send({AudioQueue::playSFX, nullptr, loops, sound, gain, pan});
+}
+
+void AudioThread::NextFrame() noexcept {
+  for (int i = 0; i < mSoundCount; i++) mSounds[i].triggers = 0;
+}
+
+bool AudioThread::PollEvent(AudioQueue::Message& event) noexcept {
+  return mEvents.Pop(event);
+}
+
+int AudioThread::Dropped() noexcept { return mDropped; }
+
+long long AudioThread::Played() noexcept {
+  return mPlayed - mMixer->Skipped();
+}
+
+long long AudioThread::Stolen() noexcept {
+  return mStolen + mMixer->Stolen();
+}
+
+long long AudioThread::Skipped() noexcept {
+  return mSkipped + mMixer->Skipped();
+}
+
+int AudioThread::Limited() noexcept { return mLimited; }
+
+int AudioThread::Voices() noexcept { return mVoicesPlaying; }
+
+int AudioThread::TotalVoices() noexcept {
+  return mMixing ? SoftwareMixer::MAX_VOICES : VOICES;
+}
+
+int AudioThread::PeakVoices() noexcept { return mPeakVoices; }
+
+MusicStream* AudioThread::Music() noexcept { return mMusic; }
+
+float AudioThread::MixerLoad() noexcept {
+  const long long polls = mPolls;
+  if (polls == 0) return 0.0f;
+
+  return static_cast<float>(mVoiceTotal) / (polls * TotalVoices());
+}
+
+SoftwareMixer* AudioThread::Mixer() noexcept { return mMixer; }
+
+void AudioThread::ResetStatistics() noexcept {
+  mPlayed = 0;
+  mStolen = 0;
+  mSkipped = 0;
+  mLimited = 0;
+  mVoicesPlaying = 0;
+  mPeakVoices = 0;
+  mVoiceTotal = 0;
+  mPolls = 0;
+  mMixer->ResetStatistics();
+}
+
+void AudioThread::Send(const AudioQueue::Message& command) noexcept {
+  if (!mCommands.Push(command)) mDropped++;
+}
+
+void AudioThread::Run() {
+  const std::chrono::microseconds period(1000000 / POLL_RATE);
+  AllocationAudit::Tag("audio");
+
+  while (!mQuit) {
+    AudioQueue::Message command;
+    while (mCommands.Pop(command)) Play(command);
+
+    if (mMusicFinished.exchange(false))
+      mEvents.Push({AudioQueue::musicFinished, nullptr, 0, 0});
+
+    // Topped up every poll, well inside the time the ring lasts
+    if (mStreaming) {
+      mMusic->Decode();
+      if (mMusic->Finished()) {
+        StopStream();
+        mMusicFinished = true;
+      }
+    }
+
+    CountVoices();
+
+    std::this_thread::sleep_for(period);
+  }
+}
+
+void AudioThread::Play(const AudioQueue::Message& command) {
+  // C26812: Changing 'enum' to 'enum class' would cause compilation
+  // error, making all types into undeclared identifiers
+  switch (command.type) {
+    case AudioQueue::playMusic:
+
+      StopStream();
+      if (StartStream(command.filename, command.loops)) break;
+
+      mAudio->PlayMusic(command.filename, command.loops);
+
+      // Music that failed to load never finishes, so it is finished now
+      if (!Mix_PlayingMusic()) mMusicFinished = true;
+      break;
+
+    case AudioQueue::pauseMusic:
+
+      if (mStreaming)
+        mMusic->Pause(true);
+      else
+        mAudio->PauseMusic();
+      break;
+
+    case AudioQueue::resumeMusic:
+
+      if (mStreaming)
+        mMusic->Pause(false);
+      else
+        mAudio->ResumeMusic();
+      break;
+
+    case AudioQueue::loadSFX:
+
+      mSounds[command.sound].chunk =
+          AssetManager::Instance()->GetSFX(command.filename);
+      break;
+
+    case AudioQueue::playSFX: {
+      Mix_Chunk* chunk = mSounds[command.sound].chunk;
+      if (chunk == nullptr) break;
+
+      if (mMixing) {
+        const Sound& played = mSounds[command.sound];
+        if (mMixer->Play(chunk, command.sound, played.priority,
+                         played.maxVoices, command.loops, command.gain,
+                         command.pan))
+          mPlayed++;
+        else
+          mSkipped++;
+        break;
+      }
+
+      const int voice = PickVoice(command.sound);
+      if (voice < 0) break;
+
+      // Panned to the centre the mixer takes the channel's panning off
+      const float pan = command.pan;
+      Mix_Volume(voice, static_cast<int>(command.gain * MIX_MAX_VOLUME));
+      Mix_SetPanning(voice, static_cast<Uint8>(255 * std::min(1.0f, 1 - pan)),
+                     static_cast<Uint8>(255 * std::min(1.0f, 1 + pan)));
+      Mix_PlayChannel(voice, chunk, command.loops);
+      mVoices[voice] = {command.sound, mSounds[command.sound].priority,
+                        mVoiceOrder++};
+      mPlayed++;
+      break;
+    }
+
+    default:
+
+      break;
+  }
+}
+
+bool AudioThread::StartStream(const char* filename, int loops) {
+  int rate = 0;
+  Uint16 format = 0;
+  int channels = 0;
+  if (Mix_QuerySpec(&rate, &format, &channels) == 0 || format != AUDIO_S16SYS)
+    return false;
+
+  // Same folder the asset manager loads music from
+  char* base = SDL_GetBasePath();
+  std::string path = base != nullptr ? base : "";
+  SDL_free(base);
+  path.append("Assets/").append(filename);
+
+  if (!mMusic->Open(path.c_str(), loops, rate, channels)) return false;
+
+  // Full before the mixer's first call, so the first sample is not late
+  mMusic->Decode();
+
+  // Halting calls the finished hook, which would report the new music ended
+  Mix_HookMusicFinished(nullptr);
+  Mix_HaltMusic();
+  Mix_HookMusicFinished(MusicFinished);
+  Mix_HookMusic(MusicStream::Callback, mMusic);
+  mStreaming = true;
+  return true;
+}
+
+void AudioThread::StopStream() noexcept {
+  if (!mStreaming) return;
+
+  // Unhooking waits for the mixer to finish any call into the stream
+  Mix_HookMusic(nullptr, nullptr);
+  mMusic->Close();
+  mStreaming = false;
+}
+
+int AudioThread::PickVoice(int sound) noexcept {
+  const Sound& played = mSounds[sound];
+  int free = -1;
+  int instances = 0;
+  int oldestInstance = -1;
+  int victim = -1;
+
+  for (int i = 0; i < VOICES; i++) {
+    const Voice& voice = mVoices[i];
+    if (!Mix_Playing(i)) {
+      if (free < 0) free = i;
+      continue;
+    }
+
+    if (voice.sound == sound) {
+      instances++;
+      if (oldestInstance < 0 || voice.order < mVoices[oldestInstance].order)
+        oldestInstance = i;
+    }
+
+    // Lowest priority first, the oldest of those
+    if (victim < 0 || voice.priority < mVoices[victim].priority ||
+        (voice.priority == mVoices[victim].priority &&
+         voice.order < mVoices[victim].order))
+      victim = i;
+  }
+
+  // A sound at its cap starts over on its oldest instance
+  if (instances >= played.maxVoices) {
+    mStolen++;
+    return oldestInstance;
+  }
+
+  if (free >= 0) return free;
+
+  if (mVoices[victim].priority > played.priority) {
+    mSkipped++;
+    return -1;
+  }
+
+  mStolen++;
+  return victim;
+}
+
+void AudioThread::CountVoices() noexcept {
+  int playing = 0;
+  if (mMixing) {
+    playing = mMixer->Voices();
+  } else {
+    for (int i = 0; i < VOICES; i++) {
+      if (Mix_Playing(i)) playing++;
+    }
+  }
+
+  mVoicesPlaying = playing;
+  if (playing > mPeakVoices) mPeakVoices = playing;
+  mVoiceTotal += playing;
+  mPolls++;
+}
+
+void AudioThread::MusicFinished() {
+  if (sInstance != nullptr) sInstance->mMusicFinished = true;
+}
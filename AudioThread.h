@@ -0,0 +1,503 @@
+/** @file AudioThread.h
+ *  @brief Header file for the audio thread
+ *
+ * This program is responsible for playing music and sound effects on a
+ * thread of its own, so gameplay never waits on the mixer.
+ *
+ *  @author Michael Martinez
+ *  @bug No known bugs.
+ */
+#ifndef _AUDIOTHREAD_H
+#define _AUDIOTHREAD_H
+#include <atomic>
+#include <thread>
+
+#include "AudioManager.h"
+#include "AudioQueue.h"
+#include "MusicStream.h"
+#include "SoftwareMixer.h"
+
+using namespace QuickSDL;
+
+/**
+ * @brief The AudioThread class
+ * @author Michael Martinez
+ *
+ * AudioThread class which is used in place of the audio manager by gameplay
+ * code. Playing music or a sound effect only queues a command, which the
+ * audio thread hands to the mixer. Music finishing is queued back as an
+ * event. Commands are sent from the simulation thread only, and events are
+ * read there too.
+ *
+ * Music in 16 bit WAV files is streamed, decoded a chunk at a time on the
+ * audio thread into a ring buffer the mixer plays from. Any other music is
+ * loaded whole by the audio manager.
+ *
+ * Sound effects are loaded once into handles and play on a fixed pool of
+ * voices. A sound at its voice cap restarts its oldest instance, and with
+ * every voice busy the lowest priority, oldest voice is stolen unless it
+ * outranks the new sound. Each sound is also limited to a number of plays
+ * per frame. Builds with SOFTWARE_MIXER defined play sound effects on the
+ * software mixer's voices instead, where there are enough voices that caps
+ * and priorities are left out.
+ *
+ */
+class AudioThread {
+ public:
+  /** @brief Poll rate variable
+   *
+   * Times per second the audio thread checks for commands.
+   *
+   */
+  static const int POLL_RATE = 1000;
+
+  /** @brief Voices variable
+   *
+   * Number of mixer channels sound effects play on.
+   *
+   */
+  static const int VOICES = 8;
+
+  /** @brief Max sounds variable
+   *
+   * Number of sound effects that can be loaded.
+   *
+   */
+  static const int MAX_SOUNDS = 32;
+
+ private:
+  /** @brief Sound struct
+   *
+   * One loaded sound effect. The game fills it in before queuing the load,
+   * then only touches 'triggers'. The audio thread only sets 'chunk'.
+   *
+   */
+  struct Sound {
+    const char* filename;
+    Mix_Chunk* chunk;
+    int priority;
+    int maxVoices;
+    int maxPerFrame;
+    int triggers;
+  };
+
+  /** @brief Voice struct
+   *
+   * Sound last started on a mixer channel, its priority and when it started.
+   *
+   */
+  struct Voice {
+    int sound;
+    int priority;
+    long long order;
+  };
+
+  /** @brief Static instance variable
+   *
+   * Used within the Instance function to check if required to create a new
+   * audio thread.
+   *
+   */
+  static AudioThread* sInstance;
+
+  /** @brief Audio variable
+   *
+   * Audio manager the commands are played through. Only used on the audio
+   * thread.
+   *
+   */
+  AudioManager* mAudio;
+
+  /** @brief Commands variable
+   *
+   * Commands from the game to the audio thread.
+   *
+   */
+  AudioQueue mCommands;
+
+  /** @brief Events variable
+   *
+   * Events from the mixer back to the game.
+   *
+   */
+  AudioQueue mEvents;
+
+  /** @brief Music finished variable
+   *
+   * Set by the mixer when music ends and turned into an event by the audio
+   * thread, which keeps the audio thread the only one pushing events.
+   *
+   */
+  std::atomic<bool> mMusicFinished;
+
+  /** @brief Music variable
+   *
+   * Stream the music plays from. Only used on the audio thread and the
+   * mixer's.
+   *
+   */
+  MusicStream* mMusic;
+
+  /** @brief Streaming variable
+   *
+   * True while the mixer is hooked to the stream. Only used on the audio
+   * thread.
+   *
+   */
+  bool mStreaming;
+
+  /** @brief Mixer variable
+   *
+   * Software mixer sound effects play on when 'mMixing' is true.
+   *
+   */
+  SoftwareMixer* mMixer;
+
+  /** @brief Mixing variable
+   *
+   * True when the software mixer is hooked to the device.
+   *
+   */
+  bool mMixing;
+
+  /** @brief Dropped variable
+   *
+   * Number of commands lost because the queue was full.
+   *
+   */
+  int mDropped;
+
+  /** @brief Sounds variable
+   *
+   * Every loaded sound effect by handle.
+   *
+   */
+  Sound mSounds[MAX_SOUNDS];
+
+  /** @brief Sound count variable
+   *
+   * Number of sound effects loaded.
+   *
+   */
+  int mSoundCount;
+
+  /** @brief Limited variable
+   *
+   * Plays turned away by a sound's per frame limit.
+   *
+   */
+  int mLimited;
+
+  /** @brief Voices variable
+   *
+   * What each mixer channel is playing. Only used on the audio thread.
+   *
+   */
+  Voice mVoices[VOICES];
+
+  /** @brief Voice order variable
+   *
+   * Number of voices started so far. Only used on the audio thread.
+   *
+   */
+  long long mVoiceOrder;
+
+  /** @brief Voice statistics variables
+   *
+   * Sounds played, voices stolen and sounds skipped because every voice
+   * outranked them, then voices playing at the last poll, at most, and
+   * summed over every poll with the number of polls.
+   *
+   */
+  std::atomic<long long> mPlayed;
+  std::atomic<long long> mStolen;
+  std::atomic<long long> mSkipped;
+  std::atomic<int> mVoicesPlaying;
+  std::atomic<int> mPeakVoices;
+  std::atomic<long long> mVoiceTotal;
+  std::atomic<long long> mPolls;
+
+  /** @brief Quit variable
+   *
+   * Set to stop the audio thread.
+   *
+   */
+  std::atomic<bool> mQuit;
+
+  /** @brief Thread variable
+   *
+   * Thread playing the commands.
+   *
+   */
+  std::thread mThread;
+
+ public:
+  /** @brief Instance function
+   *
+   * Used to create and return an audio thread if the static instance is
+   * null.
+   *
+   */
+  static AudioThread* Instance();
+
+  /** @brief Release function
+   *
+   * Stops the thread and frees the static instance.
+   *
+   *  @return void
+   */
+  static void Release() noexcept;
+
+  /** @brief Play music function
+   *
+   * Queues music to play 'loops' more times after the first, -1 for forever.
+   * A 'music finished' event is sent when it ends.
+   *
+   *  @param filename, loops
+   *  @return void
+   */
+  void PlayMusic(const char* filename, int loops = -1) noexcept;
+
+  /** @brief Pause music function
+   *
+   * Queues pausing the music.
+   *
+   *  @return void
+   */
+  void PauseMusic() noexcept;
+
+  /** @brief Resume music function
+   *
+   * Queues resuming the music.
+   *
+   *  @return void
+   */
+  void ResumeMusic() noexcept;
+
+  /** @brief Load SFX function
+   *
+   * Used to return the handle of a sound effect, queuing its load the first
+   * time. Higher 'priority' sounds may steal voices from lower ones. At most
+   * 'maxVoices' instances play at once and 'maxPerFrame' start each frame.
+   * Loading a sound again returns its handle and keeps its first settings.
+   *
+   *  @param filename, priority, maxVoices, maxPerFrame
+   *  @return int handle, or -1 if every sound slot is taken
+   */
+  int LoadSFX(const char* filename, int priority = 0, int maxVoices = VOICES,
+              int maxPerFrame = 1) noexcept;
+
+  /** @brief Play SFX function
+   *
+   * Queues a loaded sound effect at 'gain' from 0 to 1 and 'pan' from -1
+   * for left to 1 for right, unless it already played as often as it may
+   * this frame.
+   *
+   *  @param sound, loops, gain, pan
+   *  @return void
+   */
+  void PlaySFX(int sound, int loops = 0, float gain = 1.0f,
+               float pan = 0.0f) noexcept;
+
+  /** @brief Next frame function
+   *
+   * Starts a new frame for the per frame sound limits.
+   *
+   *  @return void
+   */
+  void NextFrame() noexcept;
+
+  /** @brief Poll event function
+   *
+   * Takes the oldest event sent back from the mixer.
+   *
+   *  @param event
+   *  @return bool false if there are no events
+   */
+  bool PollEvent(AudioQueue::Message& event) noexcept;
+
+  /** @brief Dropped function
+   *
+   * Used to return the number of commands lost because the queue was full.
+   *
+   *  @return int
+   */
+  int Dropped() noexcept;
+
+  /** @brief Played function
+   *
+   * Used to return the number of sound effects started on a voice.
+   *
+   *  @return long long
+   */
+  long long Played() noexcept;
+
+  /** @brief Stolen function
+   *
+   * Used to return the number of voices cut off to play another sound.
+   *
+   *  @return long long
+   */
+  long long Stolen() noexcept;
+
+  /** @brief Skipped function
+   *
+   * Used to return the number of sound effects not played because every
+   * voice outranked them.
+   *
+   *  @return long long
+   */
+  long long Skipped() noexcept;
+
+  /** @brief Limited function
+   *
+   * Used to return the number of plays turned away by per frame limits.
+   *
+   *  @return int
+   */
+  int Limited() noexcept;
+
+  /** @brief Voices function
+   *
+   * Used to return the number of voices playing at the last poll.
+   *
+   *  @return int
+   */
+  int Voices() noexcept;
+
+  /** @brief Total voices function
+   *
+   * Used to return the number of voices sound effects can play on.
+   *
+   *  @return int
+   */
+  int TotalVoices() noexcept;
+
+  /** @brief Peak voices function
+   *
+   * Used to return the most voices that played at once.
+   *
+   *  @return int
+   */
+  int PeakVoices() noexcept;
+
+  /** @brief Mixer load function
+   *
+   * Used to return the average share of voices in use, from 0 to 1.
+   *
+   *  @return float
+   */
+  float MixerLoad() noexcept;
+
+  /** @brief Mixer function
+   *
+   * Used to return the software mixer, for its statistics.
+   *
+   *  @return SoftwareMixer*
+   */
+  SoftwareMixer* Mixer() noexcept;
+
+  /** @brief Music stream function
+   *
+   * Used to return the music stream, for its statistics.
+   *
+   *  @return MusicStream*
+   */
+  MusicStream* Music() noexcept;
+
+  /** @brief Reset statistics function
+   *
+   * Sets every voice statistic back to zero.
+   *
+   *  @return void
+   */
+  void ResetStatistics() noexcept;
+
+ private:
+  /** @brief Send function
+   *
+   * Queues a command, counting it if the queue is full.
+   *
+   *  @param command
+   *  @return void
+   */
+  void Send(const AudioQueue::Message& command) noexcept;
+
+  /** @brief Run function
+   *
+   * Audio thread loop playing queued commands until told to quit.
+   *
+   *  @return void
+   */
+  void Run();
+
+  /** @brief Play function
+   *
+   * Hands one command to the audio manager or the mixer.
+   *
+   *  @param command
+   *  @return void
+   */
+  void Play(const AudioQueue::Message& command);
+
+  /** @brief Start stream function
+   *
+   * Hooks the mixer to music streamed from 'filename', decoding the first
+   * part before it plays.
+   *
+   *  @param filename, loops
+   *  @return bool false if the mixer or the file can not be streamed
+   */
+  bool StartStream(const char* filename, int loops);
+
+  /** @brief Stop stream function
+   *
+   * Unhooks the mixer from the stream and closes it.
+   *
+   *  @return void
+   */
+  void StopStream() noexcept;
+
+  /** @brief Pick voice function
+   *
+   * Used to return the voice a sound should play on, following its voice
+   * cap and priority.
+   *
+   *  @param sound
+   *  @return int voice, or -1 if the sound should not play
+   */
+  int PickVoice(int sound) noexcept;
+
+  /** @brief Count voices function
+   *
+   * Adds the voices playing right now to the statistics.
+   *
+   *  @return void
+   */
+  void CountVoices() noexcept;
+
+  /** @brief Music finished function
+   *
+   * Called by the mixer on its own thread when music ends. Only flags it for
+   * the audio thread.
+   *
+   *  @return void
+   */
+  static void MusicFinished();
+
+  /** @brief Constructor
+   *
+   * Starts the audio thread.
+   *
+   */
+  AudioThread();
+
+  /** @brief Deconstructor
+   *
+   * Stops the audio thread.
+   *
+   */
+  ~AudioThread();
+};
+
+#endif
@@ -0,0 +1,149 @@
+/** @file BehaviorTree.cpp
+ *  @brief Source file for virus behavior trees
+ *
+ * This program is responsible for compiling authored behavior trees into flat
+ * node tables and ticking every agent that runs them in one loop.
+ *
+ *  @author Michael Martinez
+ *  @bug No known bugs.
+ */
+#include "BehaviorTree.h"
+
+BehaviorTree::BehaviorTree() noexcept { mNodeTicks = 0; }
+
+int BehaviorTree::Leaves(const Node& node) {
+  if (node.type != sequence && node.type != selector) return 1;
+
+  int leaves = 0;
+  for (const Node& child : node.children) leaves += Leaves(child);
+  return leaves;
+}
+
+void BehaviorTree::Emit(const Node& node) {
+  if (node.type == sequence || node.type == selector) {
+    for (const Node& child : node.children) Emit(child);
+    return;
+  }
+
+  mTypes.push_back(static_cast<char>(node.type));
+  mParams.push_back(node.param);
+  mSuccess.push_back(-1);
+  mFailure.push_back(-1);
+}
+
+void BehaviorTree::Link(const Node& node, int start, int success,
+                        int failure) {
+  const int count = node.children.size();
+
+  // C26812: Changing 'enum' to 'enum class' would cause compilation error,
+  // making all types into undeclared identifiers
+  switch (node.type) {
+    case sequence:
+      // A child that succeeds moves on to its next sibling
+      for (int i = 0; i < count; i++) {
+        const int leaves = Leaves(node.children[i]);
+        const int next = (i + 1 < count) ? start + leaves : success;
+        Link(node.children[i], start, next, failure);
+        start += leaves;
+      }
+      break;
+
+    case selector:
+      // A child that fails moves on to its next sibling
+      for (int i = 0; i < count; i++) {
+        const int leaves = Leaves(node.children[i]);
+        const int next = (i + 1 < count) ? start + leaves : failure;
+        Link(node.children[i], start, success, next);
+        start += leaves;
+      }
+      break;
+
+    default:
+      mSuccess[start] = success;
+      mFailure[start] = failure;
+      break;
+  }
+}
+
+int BehaviorTree::Compile(const Node& root) {
+  if (Leaves(root) == 0) return -1;
+
+  const int entry = mTypes.size();
+  Emit(root);
+  Link(root, entry, entry, entry);
+
+  return entry;
+}
+
+void BehaviorTree::Tick(Agents& agents, float deltaTime) noexcept {
+  Tick(agents, 0, agents.count, deltaTime);
+}
+
+void BehaviorTree::Tick(Agents& agents, int begin, int end,
+                        float deltaTime) noexcept {
+  long long ticks = 0;
+
+  for (int i = begin; i < end; i++) {
+    int node = agents.cursor[i];
+    float timer = agents.timer[i];
+    int row = agents.row[i];
+    agents.firing[i] = 0;
+
+    for (int step = 0; step < MAX_STEPS; step++) {
+      ticks++;
+      bool passed = true;
+
+      // C26812: Changing 'enum' to 'enum class' would cause compilation
+      // error, making all types into undeclared identifiers
+      switch (mTypes[node]) {
+        case wait:
+          if (timer == FRESH) {
+            timer = mParams[node];
+            passed = false;
+          } else {
+            timer -= deltaTime;
+            passed = timer <= 0.0f;
+          }
+          break;
+
+        case move:
+          row = (row + static_cast<int>(mParams[node]) + agents.rows) %
+                agents.rows;
+          break;
+
+        case aligned:
+          passed = row == agents.targetRow;
+          break;
+
+        case approach:
+          if (row < agents.targetRow)
+            row++;
+          else if (row > agents.targetRow)
+            row--;
+          break;
+
+        case fire:
+          agents.firing[i] = 1;
+          break;
+      }
+
+      // A wait that has not finished keeps the agent on this node
+      if (mTypes[node] == wait && !passed) break;
+
+      node = passed ? mSuccess[node] : mFailure[node];
+      timer = FRESH;
+    }
+
+    agents.cursor[i] = node;
+    agents.timer[i] = timer;
+    agents.row[i] = row;
+  }
+
+  mNodeTicks += ticks;
+}
+
+int BehaviorTree::NodeCount() noexcept { return mTypes.size(); }
+
+long long BehaviorTree::NodeTicks() noexcept { return mNodeTicks; }
+
+void BehaviorTree::ResetNodeTicks() noexcept { mNodeTicks = 0; }
@@ -0,0 +1,185 @@
+/** @file BehaviorTree.h
+ *  @brief Header file for virus behavior trees
+ *
+ * This program is responsible for compiling authored behavior trees into flat
+ * node tables and ticking every agent that runs them in one loop.
+ *
+ *  @author Michael Martinez
+ *  @bug No known bugs.
+ */
+#ifndef _BEHAVIORTREE_H
+#define _BEHAVIORTREE_H
+#include <atomic>
+#include <vector>
+
+/**
+ * @brief The BehaviorTree class
+ * @author Michael Martinez
+ *
+ * BehaviorTree class which is used to turn nested behavior nodes into linear
+ * tables. Composite nodes are removed while compiling; every leaf keeps the
+ * index of the leaf to run after it succeeds and after it fails.
+ *
+ */
+class BehaviorTree {
+ public:
+  /** @brief enum for node types
+   *
+   * Sequence and selector are composites, everything else is a leaf.
+   *
+   */
+  enum NODE_TYPES { sequence, selector, wait, move, aligned, approach, fire };
+
+  /** @brief Node struct
+   *
+   * Authored node. 'param' is the wait time for 'wait' and the row step for
+   * 'move'.
+   *
+   */
+  struct Node {
+    NODE_TYPES type;
+    float param;
+    std::vector<Node> children;
+  };
+
+  /** @brief Agents struct
+   *
+   * Packed per agent state ticked by 'Tick'. Every pointer addresses 'count'
+   * elements.
+   *
+   */
+  struct Agents {
+    int count;
+    int* cursor;
+    float* timer;
+    int* row;
+    char* firing;
+    int rows;
+    int targetRow;
+  };
+
+  /** @brief Fresh timer variable
+   *
+   * Timer value of an agent that just moved onto a node.
+   *
+   */
+  static constexpr float FRESH = -1.0f;
+
+ private:
+  /** @brief Max steps variable
+   *
+   * Most leaves one agent may run in a single tick, so a tree without a
+   * 'wait' cannot spin forever.
+   *
+   */
+  static const int MAX_STEPS = 16;
+
+  /** @brief Compiled node tables
+   *
+   * One entry per leaf, indexed by node.
+   *
+   */
+  std::vector<char> mTypes;
+  std::vector<float> mParams;
+  std::vector<int> mSuccess;
+  std::vector<int> mFailure;
+
+  /** @brief Node ticks variable
+   *
+   * Number of leaves run since the last reset. Ranges of agents may tick on
+   * different threads, so it is atomic.
+   *
+   */
+  std::atomic<long long> mNodeTicks;
+
+ private:
+  /** @brief Leaf count function
+   *
+   * Used to return the number of leaves under a node.
+   *
+   *  @param node
+   *  @return int
+   */
+  static int Leaves(const Node& node);
+
+  /** @brief Emit function
+   *
+   * Appends the leaves under a node in the order they run.
+   *
+   *  @param node
+   *  @return void
+   */
+  void Emit(const Node& node);
+
+  /** @brief Link function
+   *
+   * Fills the success and failure targets of the leaves under a node.
+   *
+   *  @param node, start, success, failure
+   *  @return void
+   */
+  void Link(const Node& node, int start, int success, int failure);
+
+ public:
+  /** @brief Constructor
+   *
+   * Creates an empty node table.
+   *
+   */
+  BehaviorTree() noexcept;
+
+  /** @brief Compile function
+   *
+   * Flattens an authored tree into the node table. The tree restarts from its
+   * first leaf once its root succeeds or fails.
+   *
+   *  @param root
+   *  @return int index of the tree's first leaf, or -1 if it has no leaves
+   */
+  int Compile(const Node& root);
+
+  /** @brief Tick function
+   *
+   * Runs every agent until it reaches a running leaf.
+   *
+   *  @param agents, deltaTime
+   *  @return void
+   */
+  void Tick(Agents& agents, float deltaTime) noexcept;
+
+  /** @brief Tick range function
+   *
+   * Runs the agents from begin to end until each reaches a running leaf.
+   * Separate ranges can tick on separate threads.
+   *
+   *  @param agents, begin, end, deltaTime
+   *  @return void
+   */
+  void Tick(Agents& agents, int begin, int end, float deltaTime) noexcept;
+
+  /** @brief Node count function
+   *
+   * Used to return the number of compiled leaves.
+   *
+   *  @return int
+   */
+  int NodeCount() noexcept;
+
+  /** @brief Node ticks function
+   *
+   * Used to return the number of leaves run since the last reset.
+   *
+   *  @return long long
+   */
+  long long NodeTicks() noexcept;
+
+  /** @brief Reset node ticks function
+   *
+   * Sets the node tick counter back to zero.
+   *
+   *  @return void
+   */
+  void ResetNodeTicks() noexcept;
+};
+
+#endif
@@ -0,0 +1,1048 @@
+/** @file Benchmark.cpp
+ *  @brief Source file for benchmarks
+ *
+ * This program is responsible for timing game subsystems under load and
+ * printing the results to the console. Benchmarks only run in builds with
+ * BENCHMARK defined.
+ *
+ *  @author Michael Martinez
+ *  @bug No known bugs.
+ */
+#include "Benchmark.h"
+
+#include <atomic>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__linux__)
+#include <unistd.h>
+#endif
+
+#include "AllocationAudit.h"
+#include "Animations.h"
+#include "AttackVM.h"
+#include "AudioThread.h"
+#include "Bullet.h"
+#include "Controls.h"
+#include "EntityStore.h"
+#include "FrameArena.h"
+#include "InputWatch.h"
+#include "JobSystem.h"
+#include "Level.h"
+#include "MusicStream.h"
+#include "Particles.h"
+#include "PlayScreen.h"
+#include "Projectiles.h"
+#include "RenderBuffers.h"
+#include "Scheduler.h"
+#include "SlabPool.h"
+#include "SoftwareMixer.h"
+#include "StateHash.h"
+#include "Transforms.h"
+#include "Viruses.h"
+
+namespace {
+
+// Repeating timer written as a script, like the stage flag sequence
+Scheduler::Task Repeat(Scheduler* scheduler, float interval, int* ticks) {
+  while (true) {
+    co_await scheduler->Wait(interval);
+    (*ticks)++;
+  }
+}
+
+// Heap calls made through 'CountingAllocator'
+long long gHeapCalls = 0;
+
+// Standard allocator that counts its heap calls
+template <class T>
+class CountingAllocator {
+ public:
+  using value_type = T;
+
+  CountingAllocator() noexcept {}
+
+  template <class U>
+  CountingAllocator(const CountingAllocator<U>&) noexcept {}
+
+  T* allocate(std::size_t count) {
+    gHeapCalls++;
+    return std::allocator<T>().allocate(count);
+  }
+
+  void deallocate(T* pointer, std::size_t count) noexcept {
+    std::allocator<T>().deallocate(pointer, count);
+  }
+};
+
+template <class T, class U>
+bool operator==(const CountingAllocator<T>&,
+                const CountingAllocator<U>&) noexcept {
+  return true;
+}
+
+template <class T, class U>
+bool operator!=(const CountingAllocator<T>&,
+                const CountingAllocator<U>&) noexcept {
+  return false;
+}
+
+// Transient data of one frame, built the way gameplay code would
+template <template <class> class Allocator>
+void BuildFrame(int count) {
+  std::vector<Vector2, Allocator<Vector2>> hits;
+  std::vector<std::pair<int, int>, Allocator<std::pair<int, int>>> pairs;
+  std::vector<float, Allocator<float>> spawns;
+
+  for (int i = 0; i < count; i++) {
+    hits.push_back(Vector2(static_cast<float>(i), 0.0f));
+    pairs.push_back(std::make_pair(i, count - i));
+    spawns.push_back(i * 0.5f);
+  }
+}
+
+// Enter on a screen and its first frame, recorded but not drawn
+void FirstFrame(PlayScreen* screen, RenderList& list) {
+  screen->StartNewGame();
+  screen->Update();
+  list.Begin();
+  screen->Render();
+  list.End();
+}
+
+void FirstFrame(Controls* screen, RenderList& list) {
+  screen->Update();
+  list.Begin();
+  screen->Render();
+  list.End();
+}
+
+}  // namespace
+
+double Benchmark::Elapsed(Clock::time_point start) noexcept {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start)
+      .count();
+}
+
+std::size_t Benchmark::ResidentMemory() noexcept {
+#ifdef _WIN32
+  PROCESS_MEMORY_COUNTERS counters;
+  if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    return 0;
+  return counters.WorkingSetSize;
+#elif defined(__linux__)
+  // Second number in statm is the resident page count
+  std::FILE* statm = std::fopen("/proc/self/statm", "r");
+  if (statm == nullptr) return 0;
+
+  long size = 0;
+  long pages = 0;
+  const int read = std::fscanf(statm, "%ld %ld", &size, &pages);
+  std::fclose(statm);
+  if (read != 2) return 0;
+  return static_cast<std::size_t>(pages) * sysconf(_SC_PAGESIZE);
+#else
+  return 0;
+#endif
+}
+
+template <class T>
+void Benchmark::ScreenLoad(const char* name) {
+  const int loads = 100;
+  RenderList list;
+
+  // Built once first, so loading assets the first time is not timed below
+  const std::size_t before = ResidentMemory();
+  T* held = new T();
+  const std::size_t after = ResidentMemory();
+
+  double built = 0.0;
+  double preloaded = 0.0;
+  for (int i = 0; i < loads; i++) {
+    Clock::time_point start = Clock::now();
+    T* screen = new T();
+    FirstFrame(screen, list);
+    built += Elapsed(start);
+    delete screen;
+
+    start = Clock::now();
+    FirstFrame(held, list);
+    preloaded += Elapsed(start);
+  }
+  delete held;
+
+  std::printf("  %-8s built on Enter %.4f ms, preloaded %.4f ms, %zu KB "
+              "resident\n",
+              name, built / loads, preloaded / loads,
+              after > before ? (after - before) / 1024 : 0);
+}
+
+void Benchmark::RunAll() {
+  VirusUpdate();
+  BehaviorTicks();
+  AttackPatterns();
+  EntityUpdate();
+  ParticleUpdate();
+  JobScaling();
+  FramePipeline();
+  InputLatency();
+  ScriptedSequences();
+  AnimationAdvance();
+  WorldTransforms();
+  StateHashing();
+  FrameAllocations();
+  PoolIteration();
+  StageTransition();
+  NewGame();
+  SoundEffects();
+  MusicStreaming();
+  SoftwareMixing();
+  ScreenLoading();
+}
+
+void Benchmark::VirusUpdate() {
+  const int counts[] = {3, 100, 1000, 10000};
+
+  std::printf("Virus update (ms per frame)\n");
+  for (const int count : counts) {
+    // Extended 100x100 grid so every virus gets its own panel
+    Viruses viruses(count, 100, 100);
+    for (int i = 0; i < count; i++) {
+      viruses.Spawn(i % 100, i / 100, 1,
+                    static_cast<Viruses::VIRUS_BEHAVIORS>(i % 3));
+    }
+    viruses.TargetRow(50);
+
+    const Clock::time_point start = Clock::now();
+    for (int frame = 0; frame < FRAMES; frame++) viruses.Simulate(FRAME_TIME);
+    const double total = Elapsed(start);
+
+    std::printf("  %6d viruses: %.4f ms\n", count, total / FRAMES);
+  }
+}
+
+void Benchmark::BehaviorTicks() {
+  const int counts[] = {1000, 10000};
+
+  std::printf("Behavior tree ticks\n");
+  for (const int count : counts) {
+    Viruses viruses(count, 100, 100);
+    for (int i = 0; i < count; i++) {
+      viruses.Spawn(i % 100, i / 100, 1,
+                    static_cast<Viruses::VIRUS_BEHAVIORS>(i % 3));
+    }
+    viruses.TargetRow(50);
+
+    const long long before = viruses.NodeTicks();
+    const Clock::time_point start = Clock::now();
+    for (int frame = 0; frame < FRAMES; frame++) viruses.Simulate(FRAME_TIME);
+    const double total = Elapsed(start);
+    const long long ticks = viruses.NodeTicks() - before;
+
+    std::printf("  %6d agents: %.1f million node ticks per second\n", count,
+                ticks / total / 1000.0);
+  }
+}
+
+void Benchmark::AttackPatterns() {
+  const int counts[] = {100, 1000, 10000};
+
+  std::printf("Attack VM\n");
+  for (const int count : counts) {
+    Projectiles projectiles(count * 4);
+    AttackVM attacks(&projectiles, count);
+
+    // Endless wave so every emitter keeps running for the whole benchmark
+    const int script = attacks.Compile(
+        "set r1 300\n"
+        "wave:\n"
+        "sin r4 r3\n"
+        "muli r4 r4 0.3\n"
+        "addi r4 r4 3.14159\n"
+        "fire r4 r1 0\n"
+        "addi r3 r3 1.2\n"
+        "wait 0.05\n"
+        "jmp wave\n");
+    for (int i = 0; i < count; i++)
+      attacks.Emit(script, Vector2(500.0f, 300.0f));
+
+    const Clock::time_point start = Clock::now();
+    for (int frame = 0; frame < FRAMES; frame++) {
+      attacks.Run(FRAME_TIME);
+      projectiles.Clear();
+    }
+    const double total = Elapsed(start);
+
+    std::printf(
+        "  %6d emitters: %.1f million instructions per second, %.0f emitters "
+        "per ms\n",
+        count, attacks.Instructions() / total / 1000.0,
+        static_cast<double>(count) * FRAMES / total);
+  }
+}
+
+void Benchmark::EntityUpdate() {
+  const int counts[] = {10000, 50000};
+  const float speed = 1500.0f;
+
+  std::printf("Bullets, GameEntity against entity store (ms per frame)\n");
+  for (const int count : counts) {
+    // Inheritance model: one heap allocated Bullet per shot, updated through
+    // virtual calls
+    std::vector<GameEntity*> bullets;
+    for (int i = 0; i < count; i++) bullets.push_back(new Bullet());
+
+    Clock::time_point start = Clock::now();
+    for (int frame = 0; frame < FRAMES; frame++) {
+      for (int i = 0; i < count; i++) {
+        Bullet* bullet = static_cast<Bullet*>(bullets[i]);
+        if (!bullet->Active())
+          bullet->Fire(Vector2(0.0f, static_cast<float>(i % 640)));
+        bullets[i]->Update();
+      }
+    }
+    const double inheritance = Elapsed(start);
+
+    for (GameEntity* bullet : bullets) delete bullet;
+
+    // Entity store: the same bullets as rows in one archetype
+    Texture texture("bullet.png");
+    EntityStore store(count);
+    for (int i = 0; i < count; i++) {
+      store.SpawnBullet(Vector2(0.0f, static_cast<float>(i % 640)), speed,
+                        &texture, 0);
+    }
+
+    start = Clock::now();
+    for (int frame = 0; frame < FRAMES; frame++) {
+      store.Move(FRAME_TIME);
+      store.Cull();
+      for (int i = store.Count(); i < count; i++) {
+        store.SpawnBullet(Vector2(0.0f, static_cast<float>(i % 640)), speed,
+                          &texture, 0);
+      }
+    }
+    const double components = Elapsed(start);
+
+    std::printf("  %6d bullets: GameEntity %.4f ms, entity store %.4f ms\n",
+                count, inheritance / FRAMES, components / FRAMES);
+  }
+}
+
+void Benchmark::ParticleUpdate() {
+  const int count = 100000;
+
+  Particles particles(count);
+  double total = 0.0;
+  for (int frame = 0; frame < FRAMES; frame++) {
+    // Refill faded particles so the pool stays full
+    while (particles.Count() < count)
+      particles.DeletionBurst(Vector2(480.0f, 320.0f));
+
+    const Clock::time_point start = Clock::now();
+    particles.Simulate(FRAME_TIME);
+    total += Elapsed(start);
+  }
+
+  std::printf("Particles (ms per frame)\n");
+  std::printf("  %6d particles: %.4f ms\n", count, total / FRAMES);
+}
+
+void Benchmark::JobScaling() {
+  const int count = 100000;
+  const int cores = std::thread::hardware_concurrency();
+
+  std::printf("Job scaling, %d particles (ms per frame)\n", count);
+  for (int threads = 1; threads <= (cores > 0 ? cores : 1); threads++) {
+    JobSystem jobs(threads);
+    Particles particles(count, &jobs);
+
+    double total = 0.0;
+    for (int frame = 0; frame < FRAMES; frame++) {
+      while (particles.Count() < count)
+        particles.DeletionBurst(Vector2(480.0f, 320.0f));
+
+      const Clock::time_point start = Clock::now();
+      particles.Simulate(FRAME_TIME);
+      total += Elapsed(start);
+    }
+
+    std::printf("  %2d threads: %.4f ms\n", threads, total / FRAMES);
+  }
+}
+
+void Benchmark::FramePipeline() {
+  const int count = 100000;
+  Particles particles(count);
+  RenderBuffers buffers;
+
+  std::printf("Frame pipeline, %d particles (ms per frame)\n", count);
+
+  // Simulate, record and draw one after the other
+  Clock::time_point start = Clock::now();
+  for (int frame = 0; frame < FRAMES; frame++) {
+    while (particles.Count() < count)
+      particles.DeletionBurst(Vector2(480.0f, 320.0f));
+
+    particles.Simulate(FRAME_TIME);
+    RenderList& list = buffers.Back();
+    list.Begin();
+    particles.Render();
+    list.End();
+    list.Execute();
+  }
+  std::printf("  serial:    %.4f ms\n", Elapsed(start) / FRAMES);
+
+  // Simulate and record on a second thread while this one draws
+  std::atomic<int> published(0);
+  start = Clock::now();
+  std::thread simulation([&] {
+    for (int frame = 0; frame < FRAMES; frame++) {
+      while (particles.Count() < count)
+        particles.DeletionBurst(Vector2(480.0f, 320.0f));
+
+      particles.Simulate(FRAME_TIME);
+      RenderList& list = buffers.Back();
+      list.Begin();
+      particles.Render();
+      list.End();
+      buffers.Publish();
+      published++;
+    }
+  });
+
+  int drawn = 0;
+  while (drawn < FRAMES) {
+    // Draw each published frame once, like a display that waits for it
+    if (published > drawn) {
+      buffers.Front().Execute();
+      drawn = published;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  simulation.join();
+  std::printf("  pipelined: %.4f ms\n", Elapsed(start) / FRAMES);
+}
+
+void Benchmark::InputLatency() {
+  const int frames = 90;
+  const std::chrono::microseconds frameTime(1000000 / 30);
+  const int presses = 1024;
+
+  std::printf("Input latency at 30 frames per second\n");
+  for (int watched = 0; watched < 2; watched++) {
+    std::atomic<bool> held(false);
+    std::vector<Clock::time_point> pressTimes(presses);
+    std::atomic<int> pressCount(0);
+    std::atomic<bool> done(false);
+
+    InputQueue queue;
+    InputWatch* watch = watched ? new InputWatch(&queue) : nullptr;
+
+    // Scripted player tapping one key for 5 to 30 ms every 15 to 70 ms
+    std::thread player([&] {
+      unsigned int seed = 2463534242u;
+      while (!done && pressCount < presses) {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+
+        pressTimes[pressCount] = Clock::now();
+        pressCount++;
+        held = true;
+
+        // Handed to the watch the way SDL does while pumping events
+        if (watched) {
+          SDL_Event event = {};
+          event.type = SDL_KEYDOWN;
+          event.key.timestamp = SDL_GetTicks();
+          event.key.keysym.scancode = SDL_SCANCODE_SPACE;
+          InputWatch::Watch(watch, &event);
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(5 + seed % 26));
+        held = false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10 + seed % 41));
+      }
+    });
+
+    bool wasHeld = false;
+    std::vector<float> latencies;
+
+    // Latency is measured from the moment the key really went down
+    const auto latency = [&](Clock::time_point seen) {
+      const int count = pressCount;
+      int press = 0;
+      while (press + 1 < count && pressTimes[press + 1] <= seen) press++;
+      latencies.push_back(static_cast<float>(Elapsed(pressTimes[press])));
+    };
+
+    Clock::time_point next = Clock::now();
+    for (int frame = 0; frame < frames; frame++) {
+      next += frameTime;
+      std::this_thread::sleep_until(next);
+
+      if (watched) {
+        // Measured from the time SDL stamped the press with
+        InputQueue::Event event;
+        while (queue.Pop(event))
+          latencies.push_back(static_cast<float>(Elapsed(event.time)));
+      } else {
+        const bool key = held;
+        if (key && !wasHeld) latency(Clock::now());
+        wasHeld = key;
+      }
+    }
+
+    done = true;
+    player.join();
+    delete watch;
+
+    std::sort(latencies.begin(), latencies.end());
+    const int seen = latencies.size();
+    std::printf("  %s: %d of %d presses seen", watched ? "events" : "polled",
+                seen, pressCount.load());
+    if (seen > 0) {
+      std::printf(", p50 %.2f ms, p99 %.2f ms", latencies[seen / 2],
+                  latencies[std::min(seen - 1, seen * 99 / 100)]);
+    }
+    std::printf("\n");
+  }
+}
+
+void Benchmark::ScriptedSequences() {
+  const int counts[] = {1000, 10000, 100000};
+
+  std::printf("Scripted sequences (ms per frame)\n");
+  for (const int count : counts) {
+    // Intervals from half a second to three seconds, like the level timers
+    std::vector<float> intervals(count);
+    for (int i = 0; i < count; i++) intervals[i] = 0.5f + (i % 11) * 0.25f;
+
+    std::vector<float> timers(count, 0.0f);
+    int timerTicks = 0;
+    Clock::time_point start = Clock::now();
+    for (int frame = 0; frame < FRAMES; frame++) {
+      for (int i = 0; i < count; i++) {
+        timers[i] += FRAME_TIME;
+        if (timers[i] >= intervals[i]) {
+          timers[i] -= intervals[i];
+          timerTicks++;
+        }
+      }
+    }
+    const double timerTotal = Elapsed(start);
+
+    Scheduler scheduler;
+    int scriptTicks = 0;
+    for (int i = 0; i < count; i++)
+      scheduler.Spawn(Repeat(&scheduler, intervals[i], &scriptTicks));
+
+    start = Clock::now();
+    for (int frame = 0; frame < FRAMES; frame++) scheduler.Advance(FRAME_TIME);
+    const double scriptTotal = Elapsed(start);
+
+    std::printf("  %6d sequences: timers %.4f ms (%d ticks), scripts %.4f ms "
+                "(%d ticks)\n",
+                count, timerTotal / FRAMES, timerTicks, scriptTotal / FRAMES,
+                scriptTicks);
+  }
+}
+
+void Benchmark::AnimationAdvance() {
+  const int counts[] = {1000, 10000, 50000};
+  Animations* animations = Animations::Instance();
+
+  std::printf("Animations, AnimatedTexture against registry (ms per frame)\n");
+  for (const int count : counts) {
+    // Every sprite updating its own animated texture
+    std::vector<AnimatedTexture*> textures;
+    for (int i = 0; i < count; i++) {
+      textures.push_back(new AnimatedTexture("arrow.png", 0, 0, 52, 64, 3,
+                                             0.25f, AnimatedTexture::vertical));
+    }
+
+    Clock::time_point start = Clock::now();
+    for (int frame = 0; frame < FRAMES; frame++) {
+      for (AnimatedTexture* texture : textures) texture->Update();
+    }
+    const double separate = Elapsed(start);
+
+    for (AnimatedTexture* texture : textures) delete texture;
+
+    // The same sprites as clips in the registry
+    std::vector<Texture*> sprites;
+    std::vector<int> clips;
+    for (int i = 0; i < count; i++) {
+      sprites.push_back(new Texture("arrow.png", 0, 0, 52, 64));
+      clips.push_back(
+          animations->Add(sprites[i], 3, 0.25f, AnimatedTexture::vertical));
+    }
+
+    start = Clock::now();
+    for (int frame = 0; frame < FRAMES; frame++) animations->Advance(FRAME_TIME);
+    const double registry = Elapsed(start);
+
+    // Paused clips are skipped without being touched
+    for (int i = 0; i < count; i++) {
+      if (i % 10 != 0) animations->Pause(clips[i], true);
+    }
+
+    start = Clock::now();
+    for (int frame = 0; frame < FRAMES; frame++) animations->Advance(FRAME_TIME);
+    const double paused = Elapsed(start);
+
+    for (int i = 0; i < count; i++) {
+      animations->Remove(clips[i]);
+      delete sprites[i];
+    }
+
+    std::printf("  %6d sprites: AnimatedTexture %.4f ms, registry %.4f ms, "
+                "90%% paused %.4f ms\n",
+                count, separate / FRAMES, registry / FRAMES, paused / FRAMES);
+  }
+}
+
+void Benchmark::WorldTransforms() {
+  const int depths[] = {1, 4, 8};
+  const int siblings = 10000;
+  Transforms* transforms = Transforms::Instance();
+
+  std::printf("World transforms, %d siblings (ms per frame)\n", siblings);
+  for (const int depth : depths) {
+    // A chain of nested entities with every sibling on the deepest one
+    std::vector<GameEntity*> chain;
+    for (int i = 0; i < depth; i++) {
+      chain.push_back(new GameEntity(Vector2(10.0f, 10.0f)));
+      if (i > 0) chain[i]->Parent(chain[i - 1]);
+    }
+
+    std::vector<GameEntity*> leaves;
+    for (int i = 0; i < siblings; i++) {
+      leaves.push_back(new GameEntity(Vector2(i % 960, i / 960)));
+      leaves[i]->Parent(chain.back());
+    }
+
+    // What RenderList::Add reads for every draw
+    std::vector<Transforms::World> worlds(siblings);
+    Clock::time_point start = Clock::now();
+    for (int frame = 0; frame < FRAMES; frame++) {
+      for (int i = 0; i < siblings; i++) {
+        worlds[i].pos = leaves[i]->Pos(GameEntity::world);
+        worlds[i].scale = leaves[i]->Scale(GameEntity::world);
+        worlds[i].rotation = leaves[i]->Rotation(GameEntity::world);
+      }
+    }
+    const double walked = Elapsed(start);
+
+    int rebuilds = 0;
+    start = Clock::now();
+    for (int frame = 0; frame < FRAMES; frame++) {
+      transforms->NextFrame();
+      for (int i = 0; i < siblings; i++) worlds[i] = transforms->Get(leaves[i]);
+      rebuilds = transforms->Rebuilds();
+    }
+    const double cached = Elapsed(start);
+
+    for (GameEntity* leaf : leaves) delete leaf;
+    for (GameEntity* entity : chain) delete entity;
+    transforms->Clear();
+
+    std::printf("  depth %d: GameEntity %.4f ms, cached %.4f ms, %d rebuilds "
+                "per frame when still\n",
+                depth, walked / FRAMES, cached / FRAMES, rebuilds);
+  }
+}
+
+void Benchmark::StateHashing() {
+  const int counts[] = {100, 1000, 10000};
+  StateHash* hash = StateHash::Instance();
+  const bool enabled = hash->Enabled();
+
+  std::printf("State hashing, logged every frame (ms per frame)\n");
+  for (const int count : counts) {
+    // A stage far busier than the real ones, with ten projectiles per virus
+    Viruses viruses(count, 100, 100);
+    for (int i = 0; i < count; i++) {
+      viruses.Spawn(i % 100, i / 100, 1,
+                    static_cast<Viruses::VIRUS_BEHAVIORS>(i % 3));
+    }
+
+    Projectiles projectiles(count * 10);
+    for (int i = 0; i < count * 10; i++)
+      projectiles.Spawn(i % 960, i % 640, 180.0f, 300.0f, 0);
+
+    // Only when the game is not already hashing into the real log
+    if (!enabled) hash->Log("statehash_benchmark.log");
+
+    const Clock::time_point start = Clock::now();
+    for (int frame = 0; frame < FRAMES; frame++) {
+      hash->Begin();
+      viruses.Hash(hash);
+      projectiles.Hash(hash);
+      hash->End();
+    }
+    const double total = Elapsed(start);
+
+    std::printf("  %6d viruses, %6d projectiles: %.4f ms\n", count,
+                count * 10, total / FRAMES);
+  }
+
+  if (!enabled) {
+    hash->Close();
+    std::remove("statehash_benchmark.log");
+  }
+}
+
+void Benchmark::FrameAllocations() {
+  const int counts[] = {100, 1000, 10000};
+  FrameArena* arena = FrameArena::Instance();
+
+  std::printf("Frame allocations (ms and heap calls per frame)\n");
+  for (const int count : counts) {
+    gHeapCalls = 0;
+    Clock::time_point start = Clock::now();
+    for (int frame = 0; frame < FRAMES; frame++)
+      BuildFrame<CountingAllocator>(count);
+    const double heapTotal = Elapsed(start);
+    const long long heapCalls = gHeapCalls;
+
+    // The first frames grow the arena, later ones reuse its blocks
+    int arenaCalls = 0;
+    start = Clock::now();
+    for (int frame = 0; frame < FRAMES; frame++) {
+      BuildFrame<ArenaAllocator>(count);
+      arena->Reset();
+      arenaCalls += arena->HeapCalls();
+    }
+    const double arenaTotal = Elapsed(start);
+
+    std::printf("  %6d events: heap %.4f ms (%.1f calls), arena %.4f ms "
+                "(%.2f calls, %zu KB held)\n",
+                count, heapTotal / FRAMES,
+                static_cast<double>(heapCalls) / FRAMES, arenaTotal / FRAMES,
+                static_cast<double>(arenaCalls) / FRAMES,
+                arena->Capacity() / 1024);
+  }
+}
+
+void Benchmark::PoolIteration() {
+  const int counts[] = {1000, 10000, 100000};
+
+  std::printf("Entities, global new against slab pool (ns per entity)\n");
+  for (const int count : counts) {
+    // Other allocations in between scatter the entities like a running game
+    std::vector<GameEntity*> entities;
+    std::vector<char*> filler;
+    unsigned int seed = 2463534242u;
+    for (int i = 0; i < count; i++) {
+      entities.push_back(new GameEntity());
+
+      seed ^= seed << 13;
+      seed ^= seed >> 17;
+      seed ^= seed << 5;
+      filler.push_back(new char[16 + seed % 240]);
+    }
+
+    Clock::time_point start = Clock::now();
+    for (int frame = 0; frame < FRAMES; frame++) {
+      for (GameEntity* entity : entities)
+        entity->Translate(VEC2_RIGHT * FRAME_TIME);
+    }
+    const double scattered = Elapsed(start);
+
+    for (GameEntity* entity : entities) delete entity;
+    for (char* bytes : filler) delete[] bytes;
+    entities.clear();
+    filler.clear();
+
+    // The same entities side by side in slabs, the filler goes elsewhere
+    for (int i = 0; i < count; i++) {
+      entities.push_back(ObjectPool<GameEntity>::Create());
+
+      seed ^= seed << 13;
+      seed ^= seed >> 17;
+      seed ^= seed << 5;
+      filler.push_back(new char[16 + seed % 240]);
+    }
+
+    start = Clock::now();
+    for (int frame = 0; frame < FRAMES; frame++) {
+      for (GameEntity* entity : entities)
+        entity->Translate(VEC2_RIGHT * FRAME_TIME);
+    }
+    const double pooled = Elapsed(start);
+
+    for (GameEntity* entity : entities)
+      ObjectPool<GameEntity>::Destroy(entity);
+    for (char* bytes : filler) delete[] bytes;
+
+    const double perEntity = 1000000.0 / FRAMES / count;
+    std::printf("  %6d entities: global new %.2f ns, slab pool %.2f ns\n",
+                count, scattered * perEntity, pooled * perEntity);
+  }
+}
+
+void Benchmark::StageTransition() {
+  const int TRANSITIONS = 1000;
+  AllocationAudit* audit = AllocationAudit::Instance();
+
+  PlayBG* playBG = new PlayBG();
+  Particles* particles = new Particles();
+  Player* player = new Player(particles);
+  Level* level = new Level(1, playBG, player, particles);
+
+  std::printf("Stage transitions, rebuilt against reset (ms per transition)\n");
+
+  // A new level every stage, like skipping stages before levels were reset
+  long long allocations = audit->Allocations();
+  Clock::time_point start = Clock::now();
+  for (int i = 0; i < TRANSITIONS; i++) {
+    delete level;
+    level = new Level(i + 2, playBG, player, particles);
+  }
+  const double rebuilt = Elapsed(start);
+  const long long rebuiltAllocations = audit->Allocations() - allocations;
+
+  // The same level reset in place
+  allocations = audit->Allocations();
+  start = Clock::now();
+  for (int i = 0; i < TRANSITIONS; i++) level->Reset(i + 2);
+  const double reset = Elapsed(start);
+  const long long resetAllocations = audit->Allocations() - allocations;
+
+  std::printf("  rebuilt %.4f ms, reset %.4f ms\n", rebuilt / TRANSITIONS,
+              reset / TRANSITIONS);
+  if (AllocationAudit::Enabled()) {
+    std::printf("  rebuilt %.1f allocations, reset %.1f allocations\n",
+                static_cast<double>(rebuiltAllocations) / TRANSITIONS,
+                static_cast<double>(resetAllocations) / TRANSITIONS);
+  }
+
+  delete level;
+  delete player;
+  delete particles;
+  delete playBG;
+}
+
+void Benchmark::NewGame() {
+  const int GAMES = 1000;
+  AllocationAudit* audit = AllocationAudit::Instance();
+
+  Particles* particles = new Particles();
+  Player* player = new Player(particles);
+
+  std::printf("New games, player rebuilt against reset (ms per game)\n");
+
+  // A new player every game, like before players were reset
+  long long allocations = audit->Allocations();
+  Clock::time_point start = Clock::now();
+  for (int i = 0; i < GAMES; i++) {
+    delete player;
+    player = new Player(particles);
+  }
+  const double rebuilt = Elapsed(start);
+  const long long rebuiltAllocations = audit->Allocations() - allocations;
+
+  // The same player reset in place
+  allocations = audit->Allocations();
+  start = Clock::now();
+  for (int i = 0; i < GAMES; i++) player->Reset();
+  const double reset = Elapsed(start);
+  const long long resetAllocations = audit->Allocations() - allocations;
+
+  std::printf("  rebuilt %.4f ms, reset %.4f ms\n", rebuilt / GAMES,
+              reset / GAMES);
+  if (AllocationAudit::Enabled()) {
+    std::printf("  rebuilt %.1f allocations, reset %.1f allocations\n",
+                static_cast<double>(rebuiltAllocations) / GAMES,
+                static_cast<double>(resetAllocations) / GAMES);
+  }
+
+  delete player;
+  delete particles;
+}
+
+void Benchmark::SoundEffects() {
+  const int shotsPerSecond = 1000;
+  const int framesPerSecond = 60;
+  const std::chrono::microseconds frameTime(1000000 / framesPerSecond);
+  AudioThread* audio = AudioThread::Instance();
+
+  // Same sounds and settings as the game
+  const int fire = audio->LoadSFX("fire.wav", 0, 2, 1);
+  const int flag = audio->LoadSFX("StageSE.wav", 1, 1, 1);
+  const int death = audio->LoadSFX("death.wav", 2, 1, 1);
+
+  std::printf("Sound effects at %d shots per second for a second\n",
+              shotsPerSecond);
+  audio->ResetStatistics();
+  const int dropped = audio->Dropped();
+
+  // Every shot due by the end of a frame is fired during it
+  int shots = 0;
+  Clock::time_point next = Clock::now();
+  for (int frame = 0; frame < framesPerSecond; frame++) {
+    const int due = (frame + 1) * shotsPerSecond / framesPerSecond;
+    for (; shots < due; shots++) audio->PlaySFX(fire);
+
+    if (frame % 10 == 0) audio->PlaySFX(flag);
+    if (frame % 20 == 0) audio->PlaySFX(death);
+    audio->NextFrame();
+
+    next += frameTime;
+    std::this_thread::sleep_until(next);
+  }
+
+  // The audio thread plays what is left within a poll
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+  std::printf("  %d shots: %lld played, %d limited, %lld stolen, %lld "
+              "skipped, %d dropped\n",
+              shots, audio->Played(), audio->Limited(), audio->Stolen(),
+              audio->Skipped(), audio->Dropped() - dropped);
+  std::printf("  %d of %d voices at peak, %.0f%% mixer load\n",
+              audio->PeakVoices(), AudioThread::VOICES,
+              audio->MixerLoad() * 100.0f);
+
+  audio->ResetStatistics();
+}
+
+void Benchmark::MusicStreaming() {
+  const char* path = "benchmark_music.wav";
+  const int rate = 44100;
+  const int seconds = 60;
+  const int frames = rate * seconds;
+
+  // A minute of stereo sine, whole cycles so a loop joins up smoothly
+  std::FILE* file = std::fopen(path, "wb");
+  if (file == nullptr) return;
+
+  // RIFF, format and data headers for 16 bit PCM, little endian
+  const unsigned int dataBytes = frames * 4;
+  const unsigned int header[] = {0x46464952, 36 + dataBytes, 0x45564157,
+                                 0x20746d66, 16, 0x00020001, rate, rate * 4,
+                                 0x00100004, 0x61746164, dataBytes};
+  std::fwrite(header, sizeof(header), 1, file);
+  std::vector<Sint16> samples(frames * 2);
+  for (int i = 0; i < frames; i++) {
+    samples[i * 2] = static_cast<Sint16>(
+        10000.0f * std::sin(i % 100 * 2.0f * PI / 100.0f));
+    samples[i * 2 + 1] = samples[i * 2];
+  }
+  std::fwrite(samples.data(), 2, samples.size(), file);
+  std::fclose(file);
+
+  std::printf("Music, a minute of 44.1 kHz stereo decoded whole against "
+              "streamed\n");
+  std::unique_ptr<MusicStream> stream = std::make_unique<MusicStream>();
+  std::vector<Sint16> ring(MusicStream::RING_FRAMES * 2);
+
+  // Decoded whole before the first sample, like loading it all at once
+  std::vector<Sint16> decoded;
+  Clock::time_point start = Clock::now();
+  stream->Open(path, 0, rate, 2);
+  while (!stream->Finished()) {
+    stream->Decode();
+    const int buffered = stream->Buffered();
+    stream->Mix(reinterpret_cast<Uint8*>(ring.data()), buffered * 4);
+    decoded.insert(decoded.end(), ring.begin(), ring.begin() + buffered * 2);
+  }
+  const double whole = Elapsed(start);
+
+  // Streamed, playing as soon as the ring is first filled
+  start = Clock::now();
+  stream->Open(path, 0, rate, 2);
+  stream->Decode();
+  const double streamed = Elapsed(start);
+
+  std::printf("  whole %.2f ms to the first sample, %lld KB held\n", whole,
+              stream->DecodedBytes() / 1024);
+  std::printf("  streamed %.2f ms to the first sample, %zu KB held\n",
+              streamed, MusicStream::ResidentBytes() / 1024);
+
+  // Played twice, the join should step no further than the sine itself does
+  long long played = 0;
+  int previous = 0;
+  int largestStep = 0;
+  stream->Open(path, 1, rate, 2);
+  while (!stream->Finished()) {
+    stream->Decode();
+    const int buffered = stream->Buffered();
+    stream->Mix(reinterpret_cast<Uint8*>(ring.data()), buffered * 4);
+    for (int i = 0; i < buffered; i++) {
+      if (played + i > 0)
+        largestStep = std::max(largestStep, std::abs(ring[i * 2] - previous));
+      previous = ring[i * 2];
+    }
+    played += buffered;
+  }
+  stream->Close();
+
+  std::printf("  looped %lld of %d frames, largest step %d\n", played,
+              frames * 2, largestStep);
+  std::remove(path);
+}
+
+void Benchmark::SoftwareMixing() {
+  const int counts[] = {8, 64, 256};
+  const int rate = 44100;
+  const int bufferFrames = 1024;
+  const int callbacks = 1000;
+
+  // A second of stereo noise, looped so every voice plays throughout
+  std::vector<Sint16> samples(rate * 2);
+  unsigned int seed = 2463534242u;
+  for (Sint16& sample : samples) {
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    sample = static_cast<Sint16>(seed >> 20) - 2048;
+  }
+  Mix_Chunk chunk = {0, reinterpret_cast<Uint8*>(samples.data()),
+                     static_cast<Uint32>(samples.size() * 2), MIX_MAX_VOLUME};
+  std::vector<Sint16> buffer(bufferFrames * 2);
+  const double bufferTime = 1000.0 * bufferFrames / rate;
+
+  std::printf("Software mixer, %d frame buffers (voices per ms of callback "
+              "time)\n",
+              bufferFrames);
+  for (const int count : counts) {
+    std::unique_ptr<SoftwareMixer> mixer = std::make_unique<SoftwareMixer>();
+    for (int i = 0; i < count; i++) {
+      const float pan = (i % 9) / 4.0f - 1.0f;
+      mixer->Play(&chunk, i, 0, 1, -1, 0.5f, pan);
+    }
+
+    const Clock::time_point start = Clock::now();
+    for (int i = 0; i < callbacks; i++) {
+      std::fill(buffer.begin(), buffer.end(), static_cast<Sint16>(0));
+      mixer->Mix(reinterpret_cast<Uint8*>(buffer.data()),
+                 bufferFrames * 4);
+    }
+    const double total = Elapsed(start) / callbacks;
+
+    std::printf("  %3d voices: %.4f ms per callback, %.0f voices per ms, "
+                "%.1f%% of the buffer's %.1f ms\n",
+                count, total, mixer->VoicesPerMs(), total / bufferTime * 100.0,
+                bufferTime);
+  }
+}
+
+void Benchmark::ScreenLoading() {
+  std::printf("Screens, Enter to the first frame\n");
+  ScreenLoad<PlayScreen>("play");
+  ScreenLoad<Controls>("controls");
+}
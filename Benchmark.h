@@ -0,0 +1,274 @@
+/** @file Benchmark.h
+ *  @brief Header file for benchmarks
+ *
+ * This program is responsible for timing game subsystems under load and
+ * printing the results to the console. Benchmarks only run in builds with
+ * BENCHMARK defined.
+ *
+ *  @author Michael Martinez
+ *  @bug No known bugs.
+ */
+#ifndef _BENCHMARK_H
+#define _BENCHMARK_H
+#include <chrono>
+#include <cstddef>
+
+/**
+ * @brief The Benchmark class
+ * @author Michael Martinez
+ *
+ * Benchmark class which is used to measure the per frame cost of game
+ * subsystems.
+ *
+ */
+class Benchmark {
+ private:
+  /** @brief Frames variable
+   *
+   * Number of simulated frames each benchmark averages over.
+   *
+   */
+  static const int FRAMES = 600;
+
+  /** @brief Frame time variable
+   *
+   * Delta time of one simulated frame.
+   *
+   */
+  static constexpr float FRAME_TIME = 1.0f / 60.0f;
+
+  /** @brief Clock type
+   *
+   * Clock used for every measurement.
+   *
+   */
+  using Clock = std::chrono::steady_clock;
+
+  /** @brief Elapsed function
+   *
+   * Used to return milliseconds passed since a start time.
+   *
+   *  @param start
+   *  @return double
+   */
+  static double Elapsed(Clock::time_point start) noexcept;
+
+  /** @brief Screen load function
+   *
+   * Prints the time from Enter to the first frame of a screen of type 'T'
+   * built on Enter and preloaded, and the memory one screen holds.
+   *
+   *  @param name
+   *  @return void
+   */
+  template <class T>
+  static void ScreenLoad(const char* name);
+
+ public:
+  /** @brief Run all function
+   *
+   * Runs every benchmark in order.
+   *
+   *  @return void
+   */
+  static void RunAll();
+
+  /** @brief Resident memory function
+   *
+   * Used to return the bytes of memory the process has resident, or 0 where
+   * that can not be read.
+   *
+   *  @return std::size_t
+   */
+  static std::size_t ResidentMemory() noexcept;
+
+  /** @brief Virus update benchmark
+   *
+   * Prints the per frame cost of updating 3 up to 10,000 viruses on an
+   * extended grid.
+   *
+   *  @return void
+   */
+  static void VirusUpdate();
+
+  /** @brief Behavior tick benchmark
+   *
+   * Prints how many behavior tree nodes per second thousands of viruses run.
+   *
+   *  @return void
+   */
+  static void BehaviorTicks();
+
+  /** @brief Attack VM benchmark
+   *
+   * Prints attack VM instructions per second and emitters updated per
+   * millisecond.
+   *
+   *  @return void
+   */
+  static void AttackPatterns();
+
+  /** @brief Entity store benchmark
+   *
+   * Prints the per frame cost of moving bullets as Bullet objects against
+   * the same bullets in the entity store.
+   *
+   *  @return void
+   */
+  static void EntityUpdate();
+
+  /** @brief Particle benchmark
+   *
+   * Prints the per frame cost of integrating 100,000 particles.
+   *
+   *  @return void
+   */
+  static void ParticleUpdate();
+
+  /** @brief Job scaling benchmark
+   *
+   * Prints the per frame cost of particle and virus updates with 1 up to
+   * every core running jobs.
+   *
+   *  @return void
+   */
+  static void JobScaling();
+
+  /** @brief Frame pipeline benchmark
+   *
+   * Prints the per frame cost of simulating, recording and drawing 100,000
+   * particles back to back and with simulation on its own thread.
+   *
+   *  @return void
+   */
+  static void FramePipeline();
+
+  /** @brief Input latency benchmark
+   *
+   * Prints how many scripted key presses a 30 frames per second update sees
+   * and how long they wait, polled once per frame and taken from key down
+   * events through the input watch.
+   *
+   *  @return void
+   */
+  static void InputLatency();
+
+  /** @brief Scripted sequences benchmark
+   *
+   * Prints the per frame cost of 1,000 to 100,000 repeating sequences run as
+   * per frame float timers and as scripts sleeping in the scheduler.
+   *
+   *  @return void
+   */
+  static void ScriptedSequences();
+
+  /** @brief Animation advance benchmark
+   *
+   * Prints the per frame cost of animating 1,000 to 50,000 sprites through
+   * their own animated textures and through the animation registry, with
+   * every clip running and with most of them paused.
+   *
+   *  @return void
+   */
+  static void AnimationAdvance();
+
+  /** @brief World transforms benchmark
+   *
+   * Prints the per frame cost of finding the world transform of 10,000
+   * siblings nested 1 to 8 deep, walking the parents every time and through
+   * the transform cache, and how many cached transforms were rebuilt.
+   *
+   *  @return void
+   */
+  static void WorldTransforms();
+
+  /** @brief State hashing benchmark
+   *
+   * Prints the per frame cost of hashing and logging 100 to 10,000 viruses
+   * with ten times as many projectiles.
+   *
+   *  @return void
+   */
+  static void StateHashing();
+
+  /** @brief Frame allocations benchmark
+   *
+   * Prints the per frame cost and heap calls of building 100 to 10,000 hit
+   * events, collision pairs and spawn requests in new vectors every frame,
+   * first on the heap and then in the frame arena.
+   *
+   *  @return void
+   */
+  static void FrameAllocations();
+
+  /** @brief Pool iteration benchmark
+   *
+   * Prints the per entity cost of moving 1,000 to 100,000 entities every
+   * frame, made with the global new between other allocations and made in a
+   * slab pool. Time per entity stands in for cache misses.
+   *
+   *  @return void
+   */
+  static void PoolIteration();
+
+  /** @brief Stage transition benchmark
+   *
+   * Prints the cost of going to the next stage by building a new level and by
+   * resetting the level in place, with the allocations each makes in builds
+   * with the allocation audit.
+   *
+   *  @return void
+   */
+  static void StageTransition();
+
+  /** @brief New game benchmark
+   *
+   * Prints the cost of starting a new game by building a new player and by
+   * resetting the player in place, with the allocations each makes in builds
+   * with the allocation audit.
+   *
+   *  @return void
+   */
+  static void NewGame();
+
+  /** @brief Sound effects benchmark
+   *
+   * Prints how many sounds play, are limited, steal a voice or are skipped
+   * with 1,000 shots fired per second, and the voices and mixer load it
+   * takes.
+   *
+   *  @return void
+   */
+  static void SoundEffects();
+
+  /** @brief Music streaming benchmark
+   *
+   * Prints the memory and time to the first sample of a minute of music
+   * decoded whole against streamed, and checks a streamed loop has no gap.
+   *
+   *  @return void
+   */
+  static void MusicStreaming();
+
+  /** @brief Software mixing benchmark
+   *
+   * Prints the voices the software mixer mixes per millisecond of callback
+   * time with up to every voice playing, and the share of each buffer's
+   * playing time the callback takes.
+   *
+   *  @return void
+   */
+  static void SoftwareMixing();
+
+  /** @brief Screen loading benchmark
+   *
+   * Prints the time from Enter to the first frame of the play and controls
+   * screens when they are built on Enter and when they were preloaded, and
+   * the memory each holds while loaded.
+   *
+   *  @return void
+   */
+  static void ScreenLoading();
+};
+
+#endif
@@ -15,14 +15,13 @@
 // in the first place.
 //(https://docs.microsoft.com/en-us/cpp/code-quality/c26447?view=msvc-170)
 Bullet::Bullet() {
-  mTimer = Timer::Instance();
+  mTimer = FixedTimer::Instance();
 
   mSpeed = 1500.0f;
+  mPrevPos = VEC2_ZERO;
 
   // Bullet Entity
-  // C26409: Fixing warning to replace 'new' requires editing included framework
-  // library 'QuickSDL"
-  mTexture = new Texture("bullet.png");
+  mTexture = ObjectPool<Texture>::Create("bullet.png");
   mTexture->Parent(this);
   mTexture->Pos(VEC2_ZERO);
 
@@ -34,21 +33,36 @@ Bullet::Bullet() {
 Bullet::~Bullet() {
   mTimer = nullptr;
 
-  delete mTexture;
+  ObjectPool<Texture>::Destroy(mTexture);
   mTexture = nullptr;
 }
 
+void* Bullet::operator new(std::size_t size) {
+  return ObjectPool<Bullet>::Allocate(size);
+}
+
+void Bullet::operator delete(void* object) noexcept {
+  ObjectPool<Bullet>::Free(object);
+}
+
 void Bullet::Fire(Vector2 pos) {
   Pos(pos);
+  mPrevPos = Pos();
   Active(true);
 }
 
 void Bullet::Reload() { Active(false); }
 
+void Bullet::Hash(StateHash* hash) {
+  hash->Add("player.bullets", Active());
+  if (Active()) hash->Add("player.bullets", Pos(local));
+}
+
 // C26433: Method is not a virtual function to use override.
 void Bullet::Update() {
   // Bullet direction
   if (Active()) {
+    mPrevPos = Pos();
     Translate(-VEC2_UP * mSpeed * mTimer->DeltaTime(), local);
 
     Vector2 const pos = Pos();
@@ -65,6 +79,7 @@ void Bullet::Update() {
 // C26433: Method is not a virtual function to use override.
 void Bullet::Render() {
   if (Active()) {
-    mTexture->Render();
+    // Between the last two steps, the bullet itself stays where it is
+    RenderList::Draw(mTexture, (mPrevPos - Pos()) * (1.0f - mTimer->Alpha()));
   }
 }
\ No newline at end of file
@@ -10,8 +10,11 @@
 
 #ifndef _BULLET_H
 #define _BULLET_H
+#include "FixedTimer.h"
+#include "RenderList.h"
+#include "SlabPool.h"
+#include "StateHash.h"
 #include "Texture.h"
-#include "Timer.h"
 
 using namespace QuickSDL;
 
@@ -36,7 +39,7 @@ class Bullet : public GameEntity {
    * Used to keep track of time between resets.
    *
    */
-  Timer* mTimer;
+  FixedTimer* mTimer;
 
   /** @brief Projectile speed
    *
@@ -45,6 +48,14 @@ class Bullet : public GameEntity {
    */
   float mSpeed;
 
+  /** @brief Previous position variable
+   *
+   * World position before the last simulation step, drawn towards the
+   * current one.
+   *
+   */
+  Vector2 mPrevPos;
+
   /** @brief Bullet image
    *
    * 'mTexture' is used create the look of the player's bullet.
@@ -68,6 +79,24 @@ class Bullet : public GameEntity {
    */
   virtual ~Bullet();
 
+  /** @brief New operator
+   *
+   * Takes the bullet's memory from its slab pool.
+   *
+   *  @param size
+   *  @return void*
+   */
+  static void* operator new(std::size_t size);
+
+  /** @brief Delete operator
+   *
+   * Gives the bullet's memory back to its slab pool.
+   *
+   *  @param object
+   *  @return void
+   */
+  static void operator delete(void* object) noexcept;
+
   /** @brief Firing function
    *
    * Position for when the bullets are fired.
@@ -85,6 +114,15 @@ class Bullet : public GameEntity {
    */
   void Reload();
 
+  /** @brief Hash function
+   *
+   * Adds whether the bullet is flying and where to the state hash.
+   *
+   *  @param hash
+   *  @return void
+   */
+  void Hash(StateHash* hash);
+
   /** @brief Update function
    *
    * Updating bullet travel direction.
@@ -95,7 +133,7 @@ class Bullet : public GameEntity {
 
   /** @brief Render function
    *
-   * Renders all textures
+   * Renders all textures between the last two simulation steps
    *
    *  @return void
    */
@@ -14,34 +14,35 @@
 //(https://docs.microsoft.com/en-us/cpp/code-quality/c26447?view=msvc-170)
 Controls::Controls() {
   // Control screen text entities
-  // C26409: Fixing warning to replace 'new' requires editing included framework
-  // library 'QuickSDL" C26432: Already deleted underneath deconstructor
-  mControlsMove = new Texture("Arrow Keys - Move Up, Down, Left, Right",
-                              "BN6FontBold.ttf", 45, {255, 255, 255});
+  // C26432: Already deleted underneath deconstructor
+  mControlsMove = ObjectPool<Texture>::Create(
+      "Arrow Keys - Move Up, Down, Left, Right", "BN6FontBold.ttf", 45,
+      SDL_Color{255, 255, 255});
   mControlsMove->Parent(this);
   mControlsMove->Pos(Vector2(Graphics::Instance()->SCREEN_WIDTH * 0.5f,
                              Graphics::Instance()->SCREEN_HEIGHT * 0.1f));
 
-  mControlShoot = new Texture("Spacebar Key - Shoot", "BN6FontBold.ttf", 45,
-                              {255, 255, 255});
+  mControlShoot = ObjectPool<Texture>::Create(
+      "Spacebar Key - Shoot", "BN6FontBold.ttf", 45, SDL_Color{255, 255, 255});
   mControlShoot->Parent(this);
   mControlShoot->Pos(Vector2(Graphics::Instance()->SCREEN_WIDTH * 0.5f,
                              Graphics::Instance()->SCREEN_HEIGHT * 0.2f));
 
-  mControlHit = new Texture("X Key - Lose a life", "BN6FontBold.ttf", 45,
-                            {255, 255, 255});
+  mControlHit = ObjectPool<Texture>::Create(
+      "X Key - Lose a life", "BN6FontBold.ttf", 45, SDL_Color{255, 255, 255});
   mControlHit->Parent(this);
   mControlHit->Pos(Vector2(Graphics::Instance()->SCREEN_WIDTH * 0.5f,
                            Graphics::Instance()->SCREEN_HEIGHT * 0.3f));
 
-  mControlLevel = new Texture("N Key - Skip a level", "BN6FontBold.ttf", 45,
-                              {255, 255, 255});
+  mControlLevel = ObjectPool<Texture>::Create(
+      "N Key - Skip a level", "BN6FontBold.ttf", 45, SDL_Color{255, 255, 255});
   mControlLevel->Parent(this);
   mControlLevel->Pos(Vector2(Graphics::Instance()->SCREEN_WIDTH * 0.5f,
                              Graphics::Instance()->SCREEN_HEIGHT * 0.4f));
 
-  mControlReturn = new Texture("Press Enter to return to title",
-                               "BN6FontBold.ttf", 45, {255, 255, 255});
+  mControlReturn = ObjectPool<Texture>::Create("Press Enter to return to title",
+                                               "BN6FontBold.ttf", 45,
+                                               SDL_Color{255, 255, 255});
   mControlReturn->Parent(this);
   mControlReturn->Pos(Vector2(Graphics::Instance()->SCREEN_WIDTH * 0.5f,
                               Graphics::Instance()->SCREEN_HEIGHT * 0.6f));
@@ -50,27 +51,27 @@ Controls::Controls() {
 // C26432: deleting all would cause compiling error
 Controls::~Controls() {
   // C26433: Method is not a virtual function to use override.
-  delete mControlsMove;
+  ObjectPool<Texture>::Destroy(mControlsMove);
   mControlsMove = nullptr;
 
-  delete mControlShoot;
+  ObjectPool<Texture>::Destroy(mControlShoot);
   mControlShoot = nullptr;
 
-  delete mControlHit;
+  ObjectPool<Texture>::Destroy(mControlHit);
   mControlHit = nullptr;
 
-  delete mControlLevel;
+  ObjectPool<Texture>::Destroy(mControlLevel);
   mControlLevel = nullptr;
 
-  delete mControlReturn;
+  ObjectPool<Texture>::Destroy(mControlReturn);
   mControlReturn = nullptr;
 }
 
 // C26433: Method is not a virtual function to use override.
 void Controls::Render() {
-  mControlsMove->Render();
-  mControlShoot->Render();
-  mControlHit->Render();
-  mControlLevel->Render();
-  mControlReturn->Render();
+  RenderList::Draw(mControlsMove);
+  RenderList::Draw(mControlShoot);
+  RenderList::Draw(mControlHit);
+  RenderList::Draw(mControlLevel);
+  RenderList::Draw(mControlReturn);
 }
\ No newline at end of file
@@ -13,6 +13,7 @@
 #include "Level.h"
 #include "PlayBG.h"
 #include "Player.h"
+#include "SlabPool.h"
 #include "StartScreen.h"
 
 /**
@@ -0,0 +1,224 @@
+/** @file EntityStore.cpp
+ *  @brief Source file for the archetype entity store
+ *
+ * This program is responsible for storing entities as plain components
+ * instead of GameEntity objects. Entities with the same components share an
+ * archetype, and each archetype keeps its components in contiguous chunks so
+ * systems can run over dense arrays.
+ *
+ *  @author Michael Martinez
+ *  @bug No known bugs.
+ */
+#include "EntityStore.h"
+
+#include <cstring>
+
+EntityStore::EntityStore(int capacity) {
+  mLocations.reserve(capacity);
+  mFreeIds.reserve(capacity);
+}
+
+int EntityStore::ComponentSize(int index) noexcept {
+  switch (index) {
+    case 0:
+      return sizeof(Position);
+    case 1:
+      return sizeof(Velocity);
+    case 2:
+      return sizeof(Sprite);
+    case 3:
+      return sizeof(PlayerState);
+    default:
+      return sizeof(ProjectileState);
+  }
+}
+
+int EntityStore::FindArchetype(int mask) {
+  for (unsigned int i = 0; i < mArchetypes.size(); i++) {
+    if (mArchetypes[i].mask == mask) return i;
+  }
+
+  // Each component gets one array of CHUNK_SIZE entries inside a chunk
+  Archetype archetype;
+  archetype.mask = mask;
+  archetype.stride = 0;
+  archetype.used = 0;
+  for (int i = 0; i < TOTAL_COMPONENTS; i++) {
+    archetype.offsets[i] = CHUNK_SIZE * archetype.stride;
+    if (mask & (1 << i)) archetype.stride += ComponentSize(i);
+  }
+
+  mArchetypes.push_back(archetype);
+  return mArchetypes.size() - 1;
+}
+
+int EntityStore::Create(int mask) {
+  const int index = FindArchetype(mask);
+  Archetype& archetype = mArchetypes[index];
+
+  // Move on to the next chunk, reusing one left over from earlier if there is
+  if (archetype.used == 0 ||
+      archetype.chunks[archetype.used - 1].count == CHUNK_SIZE) {
+    if (archetype.used == static_cast<int>(archetype.chunks.size())) {
+      Chunk chunk;
+      chunk.data.resize(CHUNK_SIZE * archetype.stride);
+      chunk.ids.resize(CHUNK_SIZE);
+      chunk.count = 0;
+      archetype.chunks.push_back(std::move(chunk));
+    }
+    archetype.used++;
+  }
+
+  Chunk& chunk = archetype.chunks[archetype.used - 1];
+  const int row = chunk.count++;
+
+  for (int i = 0; i < TOTAL_COMPONENTS; i++) {
+    if (mask & (1 << i)) {
+      const int size = ComponentSize(i);
+      std::memset(chunk.data.data() + archetype.offsets[i] + row * size, 0,
+                  size);
+    }
+  }
+
+  int id = 0;
+  if (!mFreeIds.empty()) {
+    id = mFreeIds.back();
+    mFreeIds.pop_back();
+  } else {
+    id = mLocations.size();
+    mLocations.push_back(Location());
+  }
+
+  mLocations[id] = {index, archetype.used - 1, row};
+  chunk.ids[row] = id;
+
+  return id;
+}
+
+void EntityStore::Destroy(int id) noexcept {
+  if (!Alive(id)) return;
+
+  const Location location = mLocations[id];
+  Archetype& archetype = mArchetypes[location.archetype];
+  Chunk& chunk = archetype.chunks[location.chunk];
+  Chunk& last = archetype.chunks[archetype.used - 1];
+  const int lastRow = last.count - 1;
+
+  // Keep the archetype packed by moving its last entity into the hole
+  if (location.chunk != archetype.used - 1 || location.row != lastRow) {
+    for (int i = 0; i < TOTAL_COMPONENTS; i++) {
+      if (archetype.mask & (1 << i)) {
+        const int size = ComponentSize(i);
+        std::memcpy(chunk.data.data() + archetype.offsets[i] +
+                        location.row * size,
+                    last.data.data() + archetype.offsets[i] + lastRow * size,
+                    size);
+      }
+    }
+
+    const int moved = last.ids[lastRow];
+    chunk.ids[location.row] = moved;
+    mLocations[moved].chunk = location.chunk;
+    mLocations[moved].row = location.row;
+  }
+
+  last.count--;
+  if (last.count == 0) archetype.used--;
+
+  mLocations[id].archetype = -1;
+  mFreeIds.push_back(id);
+}
+
+bool EntityStore::Alive(int id) noexcept {
+  return id >= 0 && id < static_cast<int>(mLocations.size()) &&
+         mLocations[id].archetype >= 0;
+}
+
+int EntityStore::Count() noexcept {
+  return mLocations.size() - mFreeIds.size();
+}
+
+int EntityStore::SpawnPlayer(Vector2 pos, Texture* texture) {
+  const int id = Create(position | sprite | player);
+
+  *Get<Position>(id) = {pos.x, pos.y};
+  Get<Sprite>(id)->texture = texture;
+  *Get<PlayerState>(id) = {2, 0};
+
+  return id;
+}
+
+int EntityStore::SpawnBullet(Vector2 pos, float speed, Texture* texture,
+                             int owner) {
+  const int id = Create(position | velocity | sprite | projectile);
+
+  // Bullets are rotated to fly towards the viruses on the right
+  *Get<Position>(id) = {pos.x, pos.y};
+  *Get<Velocity>(id) = {speed, 0.0f};
+  Get<Sprite>(id)->texture = texture;
+  Get<ProjectileState>(id)->owner = owner;
+
+  return id;
+}
+
+void EntityStore::Move(float deltaTime) noexcept {
+  for (Archetype& archetype : mArchetypes) {
+    if ((archetype.mask & (position | velocity)) != (position | velocity))
+      continue;
+
+    for (int c = 0; c < archetype.used; c++) {
+      Chunk& chunk = archetype.chunks[c];
+      Position* positions = Column<Position>(archetype, chunk);
+      const Velocity* velocities = Column<Velocity>(archetype, chunk);
+
+      for (int i = 0; i < chunk.count; i++) {
+        positions[i].x += velocities[i].x * deltaTime;
+        positions[i].y += velocities[i].y * deltaTime;
+      }
+    }
+  }
+}
+
+void EntityStore::Cull() noexcept {
+  const float minX = static_cast<float>(-OFFSCREEN_BUFFER);
+  const float minY = static_cast<float>(-OFFSCREEN_BUFFER);
+  const float maxX =
+      static_cast<float>(Graphics::Instance()->SCREEN_WIDTH + OFFSCREEN_BUFFER);
+  const float maxY = static_cast<float>(Graphics::Instance()->SCREEN_HEIGHT +
+                                        OFFSCREEN_BUFFER);
+
+  for (Archetype& archetype : mArchetypes) {
+    if ((archetype.mask & (position | projectile)) != (position | projectile))
+      continue;
+
+    // Walk backwards so the entity moved into a destroyed row is one that
+    // was already checked
+    for (int c = archetype.used - 1; c >= 0; c--) {
+      Chunk& chunk = archetype.chunks[c];
+      const Position* positions = Column<Position>(archetype, chunk);
+
+      for (int i = chunk.count - 1; i >= 0; i--) {
+        if (positions[i].x < minX || positions[i].x > maxX ||
+            positions[i].y < minY || positions[i].y > maxY)
+          Destroy(chunk.ids[i]);
+      }
+    }
+  }
+}
+
+void EntityStore::Render() {
+  for (Archetype& archetype : mArchetypes) {
+    if ((archetype.mask & (position | sprite)) != (position | sprite)) continue;
+
+    for (int c = 0; c < archetype.used; c++) {
+      Chunk& chunk = archetype.chunks[c];
+      const Position* positions = Column<Position>(archetype, chunk);
+      const Sprite* sprites = Column<Sprite>(archetype, chunk);
+
+      for (int i = 0; i < chunk.count; i++) {
+        sprites[i].texture->Pos(Vector2(positions[i].x, positions[i].y));
+        RenderList::Draw(sprites[i].texture);
+      }
+    }
+  }
+}
@@ -0,0 +1,340 @@
+/** @file EntityStore.h
+ *  @brief Header file for the archetype entity store
+ *
+ * This program is responsible for storing entities as plain components
+ * instead of GameEntity objects. Entities with the same components share an
+ * archetype, and each archetype keeps its components in contiguous chunks so
+ * systems can run over dense arrays.
+ *
+ *  @author Michael Martinez
+ *  @bug No known bugs.
+ */
+#ifndef _ENTITYSTORE_H
+#define _ENTITYSTORE_H
+#include <type_traits>
+#include <vector>
+
+#include "RenderList.h"
+#include "Texture.h"
+
+using namespace QuickSDL;
+
+/** @brief Position component
+ *
+ * Position on screen.
+ *
+ */
+struct Position {
+  float x;
+  float y;
+};
+
+/** @brief Velocity component
+ *
+ * Movement per second.
+ *
+ */
+struct Velocity {
+  float x;
+  float y;
+};
+
+/** @brief Sprite component
+ *
+ * Shared texture drawn at the entity's position.
+ *
+ */
+struct Sprite {
+  Texture* texture;
+};
+
+/** @brief Player component
+ *
+ * Lives and score of the player.
+ *
+ */
+struct PlayerState {
+  int lives;
+  int score;
+};
+
+/** @brief Projectile component
+ *
+ * Marks an entity that is removed once it leaves the screen.
+ *
+ */
+struct ProjectileState {
+  int owner;
+};
+
+/**
+ * @brief The EntityStore class
+ * @author Michael Martinez
+ *
+ * EntityStore class which is used to create, destroy and update entities made
+ * of components. Chunks are kept after their entities are destroyed, so
+ * steady play adds and removes entities without touching the heap.
+ *
+ */
+class EntityStore {
+ public:
+  /** @brief enum for components
+   *
+   * One bit per component type in an archetype mask.
+   *
+   */
+  enum COMPONENTS {
+    position = 1 << 0,
+    velocity = 1 << 1,
+    sprite = 1 << 2,
+    player = 1 << 3,
+    projectile = 1 << 4
+  };
+
+  /** @brief Chunk size variable
+   *
+   * Number of entities in one chunk.
+   *
+   */
+  static const int CHUNK_SIZE = 256;
+
+ private:
+  /** @brief Total components variable
+   *
+   * Number of component types.
+   *
+   */
+  static const int TOTAL_COMPONENTS = 5;
+
+  /** @brief Offscreen buffer variable
+   *
+   * Distance outside the screen before a projectile is removed.
+   *
+   */
+  const int OFFSCREEN_BUFFER = 10;
+
+  /** @brief Chunk struct
+   *
+   * Storage for CHUNK_SIZE entities. Each component of the archetype has its
+   * own array inside 'data', and 'ids' maps rows back to entities.
+   *
+   */
+  struct Chunk {
+    std::vector<unsigned char> data;
+    std::vector<int> ids;
+    int count;
+  };
+
+  /** @brief Archetype struct
+   *
+   * Every entity with exactly the components in 'mask'. Only the first
+   * 'used' chunks hold entities; the rest are kept for reuse.
+   *
+   */
+  struct Archetype {
+    int mask;
+    int offsets[TOTAL_COMPONENTS];
+    int stride;
+    std::vector<Chunk> chunks;
+    int used;
+  };
+
+  /** @brief Location struct
+   *
+   * Where an entity's components live. 'archetype' is -1 for a free id.
+   *
+   */
+  struct Location {
+    int archetype;
+    int chunk;
+    int row;
+  };
+
+  /** @brief Archetypes variable
+   *
+   * Every archetype created so far.
+   *
+   */
+  std::vector<Archetype> mArchetypes;
+
+  /** @brief Locations variable
+   *
+   * Location of every entity, indexed by id.
+   *
+   */
+  std::vector<Location> mLocations;
+
+  /** @brief Free ids variable
+   *
+   * Ids of destroyed entities, reused before new ids are made.
+   *
+   */
+  std::vector<int> mFreeIds;
+
+ private:
+  /** @brief Component bit function
+   *
+   * Used to return the component bit for a component type.
+   *
+   *  @return int
+   */
+  template <class T>
+  static constexpr int Bit() noexcept;
+
+  /** @brief Component size function
+   *
+   * Used to return the size of the component with a given index.
+   *
+   *  @param index
+   *  @return int
+   */
+  static int ComponentSize(int index) noexcept;
+
+  /** @brief Find archetype function
+   *
+   * Used to return the archetype for a mask, creating it if needed.
+   *
+   *  @param mask
+   *  @return int
+   */
+  int FindArchetype(int mask);
+
+  /** @brief Column function
+   *
+   * Used to return the array of one component inside a chunk.
+   *
+   *  @param archetype, chunk
+   *  @return T*
+   */
+  template <class T>
+  T* Column(Archetype& archetype, Chunk& chunk) noexcept;
+
+ public:
+  /** @brief Constructor
+   *
+   * Reserves room for a number of entities.
+   *
+   *  @param capacity
+   */
+  EntityStore(int capacity = CHUNK_SIZE);
+
+  /** @brief Create function
+   *
+   * Adds an entity with the components in a mask. Components start zeroed.
+   *
+   *  @param mask
+   *  @return int entity id
+   */
+  int Create(int mask);
+
+  /** @brief Destroy function
+   *
+   * Removes an entity by moving the last entity of its archetype into its
+   * row.
+   *
+   *  @param id
+   *  @return void
+   */
+  void Destroy(int id) noexcept;
+
+  /** @brief Alive function
+   *
+   * Used to check if an id belongs to a live entity.
+   *
+   *  @param id
+   *  @return bool
+   */
+  bool Alive(int id) noexcept;
+
+  /** @brief Count function
+   *
+   * Used to return the number of live entities.
+   *
+   *  @return int
+   */
+  int Count() noexcept;
+
+  /** @brief Get function
+   *
+   * Used to return one component of an entity, or nullptr if it has none.
+   *
+   *  @param id
+   *  @return T*
+   */
+  template <class T>
+  T* Get(int id) noexcept;
+
+  /** @brief Spawn player function
+   *
+   * Creates the entity version of Player.
+   *
+   *  @param pos, texture
+   *  @return int entity id
+   */
+  int SpawnPlayer(Vector2 pos, Texture* texture);
+
+  /** @brief Spawn bullet function
+   *
+   * Creates the entity version of a fired Bullet.
+   *
+   *  @param pos, speed, texture, owner
+   *  @return int entity id
+   */
+  int SpawnBullet(Vector2 pos, float speed, Texture* texture, int owner);
+
+  /** @brief Move system
+   *
+   * Adds velocity to position for every entity that has both.
+   *
+   *  @param deltaTime
+   *  @return void
+   */
+  void Move(float deltaTime) noexcept;
+
+  /** @brief Cull system
+   *
+   * Destroys every projectile that left the screen.
+   *
+   *  @return void
+   */
+  void Cull() noexcept;
+
+  /** @brief Render system
+   *
+   * Draws every entity that has a sprite and a position.
+   *
+   *  @return void
+   */
+  void Render();
+};
+
+template <class T>
+constexpr int EntityStore::Bit() noexcept {
+  if constexpr (std::is_same_v<T, Position>) return position;
+  if constexpr (std::is_same_v<T, Velocity>) return velocity;
+  if constexpr (std::is_same_v<T, Sprite>) return sprite;
+  if constexpr (std::is_same_v<T, PlayerState>) return player;
+  if constexpr (std::is_same_v<T, ProjectileState>) return projectile;
+  return 0;
+}
+
+template <class T>
+T* EntityStore::Column(Archetype& archetype, Chunk& chunk) noexcept {
+  int index = 0;
+  while ((1 << index) != Bit<T>()) index++;
+
+  return reinterpret_cast<T*>(chunk.data.data() + archetype.offsets[index]);
+}
+
+template <class T>
+T* EntityStore::Get(int id) noexcept {
+  if (!Alive(id)) return nullptr;
+
+  const Location& location = mLocations[id];
+  Archetype& archetype = mArchetypes[location.archetype];
+  if ((archetype.mask & Bit<T>()) == 0) return nullptr;
+
+  return Column<T>(archetype, archetype.chunks[location.chunk]) + location.row;
+}
+
+#endif
@@ -0,0 +1,50 @@
+/** @file FixedTimer.cpp
+ *  @brief Source file for the fixed step timer
+ *
+ * This program is responsible for splitting real frame time into simulation
+ * steps of equal length.
+ *
+ *  @author Michael Martinez
+ *  @bug No known bugs.
+ */
+#include "FixedTimer.h"
+
+FixedTimer* FixedTimer::sInstance = nullptr;
+
+FixedTimer* FixedTimer::Instance() {
+  // C26409: Fixing warning to replace 'new' requires editing included
+  // framework library 'QuickSDL"
+  if (sInstance == nullptr) sInstance = new FixedTimer();
+
+  return sInstance;
+}
+
+void FixedTimer::Release() noexcept {
+  delete sInstance;
+  sInstance = nullptr;
+}
+
+FixedTimer::FixedTimer() noexcept { Reset(); }
+
+int FixedTimer::Advance(float frameTime) noexcept {
+  mAccumulator += frameTime;
+  if (mAccumulator > MAX_STEPS * STEP) mAccumulator = MAX_STEPS * STEP;
+
+  int steps = 0;
+  while (mAccumulator >= STEP) {
+    mAccumulator -= STEP;
+    steps++;
+  }
+
+  mAlpha = mAccumulator / STEP;
+  return steps;
+}
+
+float FixedTimer::DeltaTime() noexcept { return STEP; }
+
+float FixedTimer::Alpha() noexcept { return mAlpha; }
+
+void FixedTimer::Reset() noexcept {
+  mAccumulator = 0.0f;
+  mAlpha = 0.0f;
+}
@@ -0,0 +1,120 @@
+/** @file FixedTimer.h
+ *  @brief Header file for the fixed step timer
+ *
+ * This program is responsible for splitting real frame time into simulation
+ * steps of equal length.
+ *
+ *  @author Michael Martinez
+ *  @bug No known bugs.
+ */
+#ifndef _FIXEDTIMER_H
+#define _FIXEDTIMER_H
+
+/**
+ * @brief The FixedTimer class
+ * @author Michael Martinez
+ *
+ * FixedTimer class which is used to run the simulation at a constant 60 steps
+ * per second no matter how fast frames are drawn. Time that has not filled a
+ * step yet is kept for the next frame and used to interpolate rendering.
+ *
+ */
+class FixedTimer {
+ public:
+  /** @brief Step variable
+   *
+   * Length of one simulation step in seconds.
+   *
+   */
+  static constexpr float STEP = 1.0f / 60.0f;
+
+  /** @brief Max steps variable
+   *
+   * Most steps simulated in one frame. Time past this is dropped so a long
+   * frame slows the game down instead of stalling it.
+   *
+   */
+  static const int MAX_STEPS = 5;
+
+ private:
+  /** @brief Static instance variable
+   *
+   * Used within the Instance function to check if required to create a new
+   * fixed timer.
+   *
+   */
+  static FixedTimer* sInstance;
+
+  /** @brief Accumulator variable
+   *
+   * Frame time that has not been simulated yet.
+   *
+   */
+  float mAccumulator;
+
+  /** @brief Alpha variable
+   *
+   * How far rendering is between the last two steps, from 0 to 1.
+   *
+   */
+  float mAlpha;
+
+ public:
+  /** @brief Instance function
+   *
+   * Used to create and return a fixed timer if the static instance is null.
+   *
+   */
+  static FixedTimer* Instance();
+
+  /** @brief Release function
+   *
+   * Frees the static instance.
+   *
+   *  @return void
+   */
+  static void Release() noexcept;
+
+  /** @brief Advance function
+   *
+   * Adds a frame's real time and returns how many steps to simulate for it.
+   *
+   *  @param frameTime
+   *  @return int
+   */
+  int Advance(float frameTime) noexcept;
+
+  /** @brief Delta time function
+   *
+   * Used to return the length of one simulation step.
+   *
+   *  @return float
+   */
+  float DeltaTime() noexcept;
+
+  /** @brief Alpha function
+   *
+   * Used to return how far rendering is between the last two steps.
+   *
+   *  @return float
+   */
+  float Alpha() noexcept;
+
+  /** @brief Reset function
+   *
+   * Drops any time that has not been simulated.
+   *
+   *  @return void
+   */
+  void Reset() noexcept;
+
+ private:
+  /** @brief Constructor
+   *
+   * Creates a timer with no time accumulated.
+   *
+   */
+  FixedTimer() noexcept;
+};
+
+#endif
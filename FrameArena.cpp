@@ -0,0 +1,93 @@
+/** @file FrameArena.cpp
+ *  @brief Source file for the frame arena
+ *
+ * This program is responsible for handing out memory that only has to live
+ * for a frame, without a heap call per allocation.
+ *
+ *  @author Michael Martinez
+ *  @bug No known bugs.
+ */
+#include "FrameArena.h"
+
+#include <algorithm>
+
+FrameArena* FrameArena::sInstance = nullptr;
+
+FrameArena* FrameArena::Instance() {
+  // C26409: Fixing warning to replace 'new' requires editing included
+  // framework library 'QuickSDL"
+  if (sInstance == nullptr) sInstance = new FrameArena();
+
+  return sInstance;
+}
+
+void FrameArena::Release() noexcept {
+  delete sInstance;
+  sInstance = nullptr;
+}
+
+// C26455: Fixing the warning 'noexcept' solution is to not include 'noexcept'
+// in the first place.
+//(https://docs.microsoft.com/en-us/cpp/code-quality/c26447?view=msvc-170)
+FrameArena::FrameArena() {
+  // C26409: Blocks are raw bytes handed out in pieces
+  mBlocks.push_back(new char[BLOCK_SIZE]);
+  mSizes.push_back(BLOCK_SIZE);
+  mBlock = 0;
+  mUsed = 0;
+
+  mAllocated = 0;
+  mHeapCalls = 0;
+  mLastAllocated = 0;
+  mLastHeapCalls = 0;
+}
+
+// C26432: deleting all would cause compiling error
+FrameArena::~FrameArena() {
+  for (char* block : mBlocks) delete[] block;
+  mBlocks.clear();
+}
+
+void* FrameArena::Allocate(std::size_t size, std::size_t alignment) {
+  mAllocated += size;
+
+  while (true) {
+    // Blocks start aligned for any type, so only the offset is rounded up
+    const std::size_t start = (mUsed + alignment - 1) & ~(alignment - 1);
+    if (start + size <= mSizes[mBlock]) {
+      mUsed = start + size;
+      return mBlocks[mBlock] + start;
+    }
+
+    mBlock++;
+    mUsed = 0;
+
+    if (mBlock == static_cast<int>(mBlocks.size())) {
+      const std::size_t blockSize =
+          std::max(size, static_cast<std::size_t>(BLOCK_SIZE));
+      mBlocks.push_back(new char[blockSize]);
+      mSizes.push_back(blockSize);
+      mHeapCalls++;
+    }
+  }
+}
+
+void FrameArena::Reset() noexcept {
+  mLastAllocated = mAllocated;
+  mLastHeapCalls = mHeapCalls;
+  mAllocated = 0;
+  mHeapCalls = 0;
+  mBlock = 0;
+  mUsed = 0;
+}
+
+std::size_t FrameArena::Allocated() noexcept { return mLastAllocated; }
+
+int FrameArena::HeapCalls() noexcept { return mLastHeapCalls; }
+
+std::size_t FrameArena::Capacity() noexcept {
+  std::size_t capacity = 0;
+  for (const std::size_t size : mSizes) capacity += size;
+
+  return capacity;
+}
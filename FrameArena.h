@@ -0,0 +1,249 @@
+/** @file FrameArena.h
+ *  @brief Header file for the frame arena
+ *
+ * This program is responsible for handing out memory that only has to live
+ * for a frame, without a heap call per allocation.
+ *
+ *  @author Michael Martinez
+ *  @bug No known bugs.
+ */
+#ifndef _FRAMEARENA_H
+#define _FRAMEARENA_H
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief The FrameArena class
+ * @author Michael Martinez
+ *
+ * FrameArena class which is used to bump allocate short lived data from
+ * blocks that are kept between frames. 'Reset' at the end of a frame empties
+ * it, so nothing allocated during a frame may be kept past it. Blocks are
+ * only added when a frame needs more room than any frame before it, so once
+ * the arena has grown a frame makes no heap calls at all. Only the thread
+ * that simulates may use it.
+ *
+ */
+class FrameArena {
+ public:
+  /** @brief Block size variable
+   *
+   * Size in bytes of each block, larger only for bigger allocations.
+   *
+   */
+  static const int BLOCK_SIZE = 64 * 1024;
+
+ private:
+  /** @brief Static instance variable
+   *
+   * Used within the Instance function to check if required to create a new
+   * frame arena.
+   *
+   */
+  static FrameArena* sInstance;
+
+  /** @brief Blocks variable
+   *
+   * Every block held and the size in bytes of each.
+   *
+   */
+  std::vector<char*> mBlocks;
+  std::vector<std::size_t> mSizes;
+
+  /** @brief Block variable
+   *
+   * Index of the block being filled.
+   *
+   */
+  int mBlock;
+
+  /** @brief Used variable
+   *
+   * Bytes used in the block being filled.
+   *
+   */
+  std::size_t mUsed;
+
+  /** @brief Allocated variable
+   *
+   * Bytes handed out this frame.
+   *
+   */
+  std::size_t mAllocated;
+
+  /** @brief Heap calls variable
+   *
+   * Number of blocks allocated from the heap this frame.
+   *
+   */
+  int mHeapCalls;
+
+  /** @brief Last frame variables
+   *
+   * Bytes handed out and blocks allocated during the last finished frame.
+   *
+   */
+  std::size_t mLastAllocated;
+  int mLastHeapCalls;
+
+ public:
+  /** @brief Instance function
+   *
+   * Used to create and return a frame arena if the static instance is null.
+   *
+   */
+  static FrameArena* Instance();
+
+  /** @brief Release function
+   *
+   * Frees the static instance.
+   *
+   *  @return void
+   */
+  static void Release() noexcept;
+
+  /** @brief Allocate function
+   *
+   * Used to return memory valid until the end of the frame. Never returns
+   * null.
+   *
+   *  @param size, alignment
+   *  @return void*
+   */
+  void* Allocate(std::size_t size,
+                 std::size_t alignment = alignof(std::max_align_t));
+
+  /** @brief Reset function
+   *
+   * Ends the frame. Memory handed out during it is reused from here on.
+   *
+   *  @return void
+   */
+  void Reset() noexcept;
+
+  /** @brief Allocated function
+   *
+   * Used to return the bytes handed out during the last finished frame.
+   *
+   *  @return std::size_t
+   */
+  std::size_t Allocated() noexcept;
+
+  /** @brief Heap calls function
+   *
+   * Used to return the number of heap calls made during the last finished
+   * frame.
+   *
+   *  @return int
+   */
+  int HeapCalls() noexcept;
+
+  /** @brief Capacity function
+   *
+   * Used to return the bytes held in blocks.
+   *
+   *  @return std::size_t
+   */
+  std::size_t Capacity() noexcept;
+
+ private:
+  /** @brief Constructor
+   *
+   * Creates the arena with one block.
+   *
+   */
+  FrameArena();
+
+  /** @brief Deconstructor
+   *
+   * Freeing all entities.
+   *
+   */
+  ~FrameArena();
+};
+
+/**
+ * @brief The ArenaAllocator class
+ * @author Michael Martinez
+ *
+ * ArenaAllocator class which is used to put standard containers in the frame
+ * arena. Freeing does nothing, the memory goes back when the arena resets,
+ * so a container using it must not outlive the frame.
+ *
+ */
+template <class T>
+class ArenaAllocator {
+ public:
+  /** @brief Value type
+   *
+   * Type of the elements allocated.
+   *
+   */
+  using value_type = T;
+
+  /** @brief Arena variable
+   *
+   * Arena the memory comes from.
+   *
+   */
+  FrameArena* mArena;
+
+  /** @brief Constructor
+   *
+   * Allocates from the frame arena.
+   *
+   */
+  ArenaAllocator() : mArena(FrameArena::Instance()) {}
+
+  /** @brief Copy constructor
+   *
+   * Allocates from the same arena as an allocator of another type.
+   *
+   *  @param other
+   */
+  template <class U>
+  ArenaAllocator(const ArenaAllocator<U>& other) noexcept
+      : mArena(other.mArena) {}
+
+  /** @brief Allocate function
+   *
+   * Used to return room for 'count' elements.
+   *
+   *  @param count
+   *  @return T*
+   */
+  T* allocate(std::size_t count) {
+    return static_cast<T*>(mArena->Allocate(count * sizeof(T), alignof(T)));
+  }
+
+  /** @brief Deallocate function
+   *
+   * Does nothing, the arena takes the memory back when it resets.
+   *
+   *  @param pointer, count
+   *  @return void
+   */
+  void deallocate(T*, std::size_t) noexcept {}
+};
+
+template <class T, class U>
+bool operator==(const ArenaAllocator<T>& a,
+                const ArenaAllocator<U>& b) noexcept {
+  return a.mArena == b.mArena;
+}
+
+template <class T, class U>
+bool operator!=(const ArenaAllocator<T>& a,
+                const ArenaAllocator<U>& b) noexcept {
+  return a.mArena != b.mArena;
+}
+
+/** @brief Frame vector type
+ *
+ * Vector whose elements live in the frame arena.
+ *
+ */
+template <class T>
+using FrameVector = std::vector<T, ArenaAllocator<T>>;
+
+#endif
@@ -0,0 +1,130 @@
+/** @file InputLatch.cpp
+ *  @brief Source file for latched keyboard input
+ *
+ * This program is responsible for collecting the keys pressed each frame, so
+ * the simulation can read them on any thread, and for measuring how long a
+ * press waits before a simulation step sees it.
+ *
+ *  @author Michael Martinez
+ *  @bug No known bugs.
+ */
+#include "InputLatch.h"
+
+#include <algorithm>
+#include <vector>
+
+InputLatch* InputLatch::sInstance = nullptr;
+
+InputLatch* InputLatch::Instance() {
+  // C26409: Fixing warning to replace 'new' requires editing included
+  // framework library 'QuickSDL"
+  if (sInstance == nullptr) sInstance = new InputLatch();
+
+  return sInstance;
+}
+
+void InputLatch::Release() noexcept {
+  delete sInstance;
+  sInstance = nullptr;
+}
+
+// C26455: Fixing the warning 'noexcept' solution is to not include 'noexcept'
+// in the first place.
+//(https://docs.microsoft.com/en-us/cpp/code-quality/c26447?view=msvc-170)
+InputLatch::InputLatch() {
+  mInput = InputManager::Instance();
+  mQueue = new InputQueue();
+  mWatch = nullptr;
+
+  for (int i = 0; i < SDL_NUM_SCANCODES; i++) mPressed[i] = false;
+  ResetLatency();
+}
+
+// C26432: deleting all would cause compiling error
+InputLatch::~InputLatch() {
+  Watching(false);
+
+  mInput = nullptr;
+
+  delete mQueue;
+  mQueue = nullptr;
+}
+
+void InputLatch::Latch() {
+  if (mWatch != nullptr) {
+    // Keep the time of the first press of a key that is still waiting
+    InputQueue::Event event;
+    while (mQueue->Pop(event)) {
+      if (mPressed[event.scancode]) continue;
+
+      mPressed[event.scancode] = true;
+      mPressTime[event.scancode] = event.time;
+    }
+    return;
+  }
+
+  const InputQueue::Clock::time_point now = InputQueue::Clock::now();
+  for (int i = 0; i < SDL_NUM_SCANCODES; i++) {
+    if (mPressed[i] || !mInput->KeyPressed(static_cast<SDL_Scancode>(i)))
+      continue;
+
+    mPressed[i] = true;
+    mPressTime[i] = now;
+  }
+}
+
+void InputLatch::Clear() noexcept {
+  const InputQueue::Clock::time_point now = InputQueue::Clock::now();
+
+  for (int i = 0; i < SDL_NUM_SCANCODES; i++) {
+    if (!mPressed[i]) continue;
+
+    mLatencies[mLatencyCount % LATENCY_SAMPLES] =
+        std::chrono::duration<float, std::milli>(now - mPressTime[i]).count();
+    mLatencyCount++;
+    mPressed[i] = false;
+  }
+}
+
+bool InputLatch::KeyPressed(SDL_Scancode scancode) noexcept {
+  return mPressed[scancode];
+}
+
+InputQueue::Clock::time_point InputLatch::PressTime(
+    SDL_Scancode scancode) noexcept {
+  return mPressTime[scancode];
+}
+
+void InputLatch::Watching(bool watching) {
+  if (watching == (mWatch != nullptr)) return;
+
+  // C26409: Fixing warning to replace 'new' requires editing included
+  // framework library 'QuickSDL"
+  if (watching) {
+    mWatch = new InputWatch(mQueue);
+  } else {
+    delete mWatch;
+    mWatch = nullptr;
+
+    // Presses still queued were never latched
+    InputQueue::Event event;
+    while (mQueue->Pop(event)) continue;
+  }
+}
+
+bool InputLatch::Watching() noexcept { return mWatch != nullptr; }
+
+float InputLatch::Latency(float percentile) {
+  const int count =
+      (mLatencyCount < LATENCY_SAMPLES) ? mLatencyCount : LATENCY_SAMPLES;
+  if (count == 0) return 0.0f;
+
+  std::vector<float> sorted(mLatencies, mLatencies + count);
+  const int index =
+      std::min(count - 1, static_cast<int>(count * percentile / 100.0f));
+  std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+
+  return sorted[index];
+}
+
+void InputLatch::ResetLatency() noexcept { mLatencyCount = 0; }
@@ -0,0 +1,201 @@
+/** @file InputLatch.h
+ *  @brief Header file for latched keyboard input
+ *
+ * This program is responsible for collecting the keys pressed each frame, so
+ * the simulation can read them on any thread, and for measuring how long a
+ * press waits before a simulation step sees it.
+ *
+ *  @author Michael Martinez
+ *  @bug No known bugs.
+ */
+#ifndef _INPUTLATCH_H
+#define _INPUTLATCH_H
+#include "InputManager.h"
+#include "InputWatch.h"
+
+using namespace QuickSDL;
+
+/**
+ * @brief The InputLatch class
+ * @author Michael Martinez
+ *
+ * InputLatch class which is used to hold key presses until a simulation step
+ * reads them. The main thread latches presses once per frame, either from the
+ * input manager or from the input watch's queue, and the simulation only
+ * reads the latched copy, so a press made during a frame with no simulation
+ * step is kept for the next one.
+ *
+ */
+class InputLatch {
+ private:
+  /** @brief Static instance variable
+   *
+   * Used within the Instance function to check if required to create a new
+   * input latch.
+   *
+   */
+  static InputLatch* sInstance;
+
+  /** @brief Input variable
+   *
+   * Used to handle keyboard inputs.
+   *
+   */
+  InputManager* mInput;
+
+  /** @brief Pressed keys variable
+   *
+   * One entry per scancode, set when the key went down since the last clear.
+   *
+   */
+  bool mPressed[SDL_NUM_SCANCODES];
+
+  /** @brief Press time variable
+   *
+   * One entry per scancode, the time a latched press was seen, or stamped by
+   * SDL when it comes from the watch.
+   *
+   */
+  InputQueue::Clock::time_point mPressTime[SDL_NUM_SCANCODES];
+
+  /** @brief Queue variable
+   *
+   * Presses pushed by the input watch, drained by 'Latch'.
+   *
+   */
+  InputQueue* mQueue;
+
+  /** @brief Input watch variable
+   *
+   * Queues SDL's key down events as they arrive. Null when presses are
+   * polled from the input manager instead.
+   *
+   */
+  InputWatch* mWatch;
+
+  /** @brief Latency samples variable
+   *
+   * Number of press latencies kept for percentiles.
+   *
+   */
+  static const int LATENCY_SAMPLES = 4096;
+
+  /** @brief Latencies variable
+   *
+   * Milliseconds from a press being seen to a step reading it. The newest
+   * samples overwrite the oldest.
+   *
+   */
+  float mLatencies[LATENCY_SAMPLES];
+
+  /** @brief Latency count variable
+   *
+   * Number of latencies recorded since the last reset.
+   *
+   */
+  int mLatencyCount;
+
+ public:
+  /** @brief Instance function
+   *
+   * Used to create and return an input latch if the static instance is null.
+   *
+   */
+  static InputLatch* Instance();
+
+  /** @brief Release function
+   *
+   * Frees the static instance.
+   *
+   *  @return void
+   */
+  static void Release() noexcept;
+
+  /** @brief Latch function
+   *
+   * Adds the key presses seen since the last latch. Only called from the main
+   * thread, right before the steps that read them.
+   *
+   *  @return void
+   */
+  void Latch();
+
+  /** @brief Clear function
+   *
+   * Forgets every latched press once a simulation step has read them and
+   * records how long each one waited.
+   *
+   *  @return void
+   */
+  void Clear() noexcept;
+
+  /** @brief Key pressed function
+   *
+   * Used to return true if the key went down since the last clear.
+   *
+   *  @param scancode
+   *  @return bool
+   */
+  bool KeyPressed(SDL_Scancode scancode) noexcept;
+
+  /** @brief Press time function
+   *
+   * Used to return the time a key that is pressed went down.
+   *
+   *  @param scancode
+   *  @return InputQueue::Clock::time_point
+   */
+  InputQueue::Clock::time_point PressTime(SDL_Scancode scancode) noexcept;
+
+  /** @brief Watching function
+   *
+   * Starts or stops taking presses from SDL's key down events.
+   *
+   *  @param watching
+   *  @return void
+   */
+  void Watching(bool watching);
+
+  /** @brief Watching function
+   *
+   * Used to return true while presses come from SDL's key down events.
+   *
+   *  @return bool
+   */
+  bool Watching() noexcept;
+
+  /** @brief Latency function
+   *
+   * Used to return a percentile of the recorded press latencies, such as 50 or
+   * 99, in milliseconds.
+   *
+   *  @param percentile
+   *  @return float
+   */
+  float Latency(float percentile);
+
+  /** @brief Reset latency function
+   *
+   * Throws away every recorded latency.
+   *
+   *  @return void
+   */
+  void ResetLatency() noexcept;
+
+ private:
+  /** @brief Constructor
+   *
+   * Creates a latch with no keys pressed.
+   *
+   */
+  InputLatch();
+
+  /** @brief Deconstructor
+   *
+   * Freeing all entities.
+   *
+   */
+  ~InputLatch();
+};
+
+#endif
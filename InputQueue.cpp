@@ -0,0 +1,33 @@
+/** @file InputQueue.cpp
+ *  @brief Source file for the input event queue
+ *
+ * This program is responsible for passing timestamped key presses from the
+ * input watch to the simulation without locks.
+ *
+ *  @author Michael Martinez
+ *  @bug No known bugs.
+ */
+#include "InputQueue.h"
+
+InputQueue::InputQueue() noexcept {
+  mHead = 0;
+  mTail = 0;
+}
+
+bool InputQueue::Push(const Event& event) noexcept {
+  const unsigned int tail = mTail.load(std::memory_order_relaxed);
+  if (tail - mHead.load(std::memory_order_acquire) == CAPACITY) return false;
+
+  mEvents[tail & (CAPACITY - 1)] = event;
+  mTail.store(tail + 1, std::memory_order_release);
+  return true;
+}
+
+bool InputQueue::Pop(Event& event) noexcept {
+  const unsigned int head = mHead.load(std::memory_order_relaxed);
+  if (head == mTail.load(std::memory_order_acquire)) return false;
+
+  event = mEvents[head & (CAPACITY - 1)];
+  mHead.store(head + 1, std::memory_order_release);
+  return true;
+}
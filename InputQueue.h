@@ -0,0 +1,104 @@
+/** @file InputQueue.h
+ *  @brief Header file for the input event queue
+ *
+ * This program is responsible for passing timestamped key presses from the
+ * input watch to the simulation without locks.
+ *
+ *  @author Michael Martinez
+ *  @bug No known bugs.
+ */
+#ifndef _INPUTQUEUE_H
+#define _INPUTQUEUE_H
+#include <atomic>
+#include <chrono>
+
+#include "InputManager.h"
+
+using namespace QuickSDL;
+
+/**
+ * @brief The InputQueue class
+ * @author Michael Martinez
+ *
+ * InputQueue class which is used as a fixed size ring buffer with exactly one
+ * producer and one consumer. Each side only writes its own index, so pushing
+ * and popping never wait.
+ *
+ */
+class InputQueue {
+ public:
+  /** @brief Clock type
+   *
+   * Clock every input event is stamped with.
+   *
+   */
+  typedef std::chrono::steady_clock Clock;
+
+  /** @brief Event struct
+   *
+   * One key press and the time it was seen.
+   *
+   */
+  struct Event {
+    SDL_Scancode scancode;
+    Clock::time_point time;
+  };
+
+  /** @brief Capacity variable
+   *
+   * Number of events the queue holds. A power of two so indices wrap with a
+   * mask.
+   *
+   */
+  static const int CAPACITY = 256;
+
+ private:
+  /** @brief Events variable
+   *
+   * Ring buffer storage.
+   *
+   */
+  Event mEvents[CAPACITY];
+
+  /** @brief Head variable
+   *
+   * Index of the next event to pop. Only written by the consumer.
+   *
+   */
+  std::atomic<unsigned int> mHead;
+
+  /** @brief Tail variable
+   *
+   * Index of the next event to push. Only written by the producer.
+   *
+   */
+  std::atomic<unsigned int> mTail;
+
+ public:
+  /** @brief Constructor
+   *
+   * Creates an empty queue.
+   *
+   */
+  InputQueue() noexcept;
+
+  /** @brief Push function
+   *
+   * Adds an event. Only called from the producer thread.
+   *
+   *  @param event
+   *  @return bool false if the queue is full and the event was dropped
+   */
+  bool Push(const Event& event) noexcept;
+
+  /** @brief Pop function
+   *
+   * Removes the oldest event. Only called from the consumer thread.
+   *
+   *  @param event
+   *  @return bool false if the queue is empty
+   */
+  bool Pop(Event& event) noexcept;
+};
+
+#endif
@@ -0,0 +1,45 @@
+/** @file InputWatch.cpp
+ *  @brief Source file for the input event watch
+ *
+ * This program is responsible for queueing every key press SDL reports with
+ * the time SDL stamped it with.
+ *
+ *  @author Michael Martinez
+ *  @bug No known bugs.
+ */
+#include "InputWatch.h"
+
+// C26455: Fixing the warning 'noexcept' solution is to not include 'noexcept'
+// in the first place.
+//(https://docs.microsoft.com/en-us/cpp/code-quality/c26447?view=msvc-170)
+InputWatch::InputWatch(InputQueue* queue) {
+  mQueue = queue;
+  mDropped = 0;
+
+  SDL_AddEventWatch(Watch, this);
+}
+
+// C26432: deleting all would cause compiling error
+InputWatch::~InputWatch() {
+  SDL_DelEventWatch(Watch, this);
+
+  mQueue = nullptr;
+}
+
+int SDLCALL InputWatch::Watch(void* data, SDL_Event* event) {
+  // Held keys repeat, only the first event is a press
+  if (event->type != SDL_KEYDOWN || event->key.repeat != 0) return 1;
+
+  InputWatch* watch = static_cast<InputWatch*>(data);
+
+  // SDL stamps in milliseconds since it started, so the age carries over
+  const Uint32 age = SDL_GetTicks() - event->key.timestamp;
+  const InputQueue::Event press = {
+      event->key.keysym.scancode,
+      InputQueue::Clock::now() - std::chrono::milliseconds(age)};
+  if (!watch->mQueue->Push(press)) watch->mDropped++;
+
+  return 1;
+}
+
+int InputWatch::Dropped() noexcept { return mDropped; }
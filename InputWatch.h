@@ -0,0 +1,79 @@
+/** @file InputWatch.h
+ *  @brief Header file for the input event watch
+ *
+ * This program is responsible for queueing every key press SDL reports with
+ * the time SDL stamped it with.
+ *
+ *  @author Michael Martinez
+ *  @bug No known bugs.
+ */
+#ifndef _INPUTWATCH_H
+#define _INPUTWATCH_H
+#include <atomic>
+
+#include "InputQueue.h"
+
+/**
+ * @brief The InputWatch class
+ * @author Michael Martinez
+ *
+ * InputWatch class which is used to watch SDL's key down events. SDL calls
+ * the watch on the thread that pumps events as each one arrives, before the
+ * frame reads the keyboard, so no press is missed however short, and each
+ * is stamped with the time SDL saw it rather than the time a frame did.
+ * That thread is the only one pushing to the queue.
+ *
+ */
+class InputWatch {
+ private:
+  /** @brief Queue variable
+   *
+   * Queue every press is pushed to.
+   *
+   */
+  InputQueue* mQueue;
+
+  /** @brief Dropped variable
+   *
+   * Number of presses lost to a full queue.
+   *
+   */
+  std::atomic<int> mDropped;
+
+ public:
+  /** @brief Constructor
+   *
+   * Starts watching SDL's events for presses to push into 'queue'.
+   *
+   *  @param queue
+   */
+  InputWatch(InputQueue* queue);
+
+  /** @brief Deconstructor
+   *
+   * Stops watching SDL's events.
+   *
+   */
+  ~InputWatch();
+
+  /** @brief Watch function
+   *
+   * Pushes a key down event that is not a repeat into the queue of the watch
+   * in 'data', with its SDL timestamp moved onto the queue's clock. Called by
+   * SDL for every event.
+   *
+   *  @param data, event
+   *  @return int
+   */
+  static int SDLCALL Watch(void* data, SDL_Event* event);
+
+  /** @brief Dropped function
+   *
+   * Used to return the number of presses lost to a full queue.
+   *
+   *  @return int
+   */
+  int Dropped() noexcept;
+};
+
+#endif
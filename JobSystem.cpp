@@ -0,0 +1,170 @@
+/** @file JobSystem.cpp
+ *  @brief Source file for the job system
+ *
+ * This program is responsible for running batches of work on every core.
+ * Each thread owns a job queue and idle threads steal from the others.
+ *
+ *  @author Michael Martinez
+ *  @bug No known bugs.
+ */
+#include "JobSystem.h"
+
+#include <chrono>
+
+#include "AllocationAudit.h"
+
+JobSystem* JobSystem::sInstance = nullptr;
+
+// Queue owned by the current thread; threads that are not workers use 0
+thread_local JobSystem* tOwner = nullptr;
+thread_local int tQueue = 0;
+
+JobSystem* JobSystem::Instance() {
+  // C26409: Fixing warning to replace 'new' requires editing included
+  // framework library 'QuickSDL"
+  if (sInstance == nullptr) {
+    const int cores = std::thread::hardware_concurrency();
+    sInstance = new JobSystem(cores > 0 ? cores : 1);
+  }
+
+  return sInstance;
+}
+
+void JobSystem::Release() noexcept {
+  delete sInstance;
+  sInstance = nullptr;
+}
+
+JobSystem::JobSystem(int threads) {
+  mPending = 0;
+  mQuit = false;
+
+  if (threads < 1) threads = 1;
+  for (int i = 0; i < threads; i++) mQueues.push_back(new Queue());
+
+  for (int i = 1; i < threads; i++)
+    mWorkers.emplace_back(&JobSystem::Worker, this, i);
+}
+
+// C26432: deleting all would cause compiling error
+JobSystem::~JobSystem() {
+  {
+    std::lock_guard<std::mutex> lock(mSleepMutex);
+    mQuit = true;
+  }
+  mWake.notify_all();
+
+  for (std::thread& worker : mWorkers) worker.join();
+
+  for (Queue* queue : mQueues) delete queue;
+  mQueues.clear();
+}
+
+int JobSystem::Threads() noexcept { return mQueues.size(); }
+
+int JobSystem::QueueIndex() noexcept { return tOwner == this ? tQueue : 0; }
+
+bool JobSystem::Push(int queue, const Job& job) {
+  Queue& q = *mQueues[queue];
+  {
+    std::lock_guard<std::mutex> lock(q.mutex);
+    if (q.count == QUEUE_CAPACITY) return false;
+
+    q.jobs[(q.head + q.count) % QUEUE_CAPACITY] = job;
+    q.count++;
+  }
+
+  mPending++;
+  mWake.notify_one();
+  return true;
+}
+
+bool JobSystem::Pop(int queue, Job& job) {
+  Queue& q = *mQueues[queue];
+  std::lock_guard<std::mutex> lock(q.mutex);
+  if (q.count == 0) return false;
+
+  q.count--;
+  job = q.jobs[(q.head + q.count) % QUEUE_CAPACITY];
+  mPending--;
+  return true;
+}
+
+bool JobSystem::Steal(int queue, Job& job) {
+  const int queues = mQueues.size();
+
+  for (int i = 1; i < queues; i++) {
+    Queue& q = *mQueues[(queue + i) % queues];
+    std::lock_guard<std::mutex> lock(q.mutex);
+    if (q.count == 0) continue;
+
+    job = q.jobs[q.head];
+    q.head = (q.head + 1) % QUEUE_CAPACITY;
+    q.count--;
+    mPending--;
+    return true;
+  }
+
+  return false;
+}
+
+void JobSystem::Execute(const Job& job) {
+  job.function(job.data, job.begin, job.end);
+  job.counter->fetch_sub(1);
+}
+
+void JobSystem::Worker(int queue) {
+  tOwner = this;
+  tQueue = queue;
+  AllocationAudit::Tag("jobs");
+
+  Job job;
+  while (!mQuit) {
+    if (Pop(queue, job) || Steal(queue, job)) {
+      Execute(job);
+      continue;
+    }
+
+    // Nothing to run, so sleep until a job is pushed
+    std::unique_lock<std::mutex> lock(mSleepMutex);
+    mWake.wait_for(lock, std::chrono::milliseconds(1),
+                   [this] { return mQuit || mPending > 0; });
+  }
+}
+
+void JobSystem::Run(JobFunction function, void* data, int begin, int end,
+                    JobCounter& counter) {
+  const Job job = {function, data, begin, end, &counter};
+  counter++;
+
+  // A full queue runs the job right away instead
+  if (!Push(QueueIndex(), job)) Execute(job);
+}
+
+void JobSystem::ParallelFor(JobFunction function, void* data, int count,
+                            int batch, JobCounter& counter) {
+  if (count <= 0) return;
+
+  if (count <= batch || mQueues.size() == 1) {
+    function(data, 0, count);
+    return;
+  }
+
+  for (int begin = 0; begin < count; begin += batch) {
+    const int end = (begin + batch < count) ? begin + batch : count;
+    Run(function, data, begin, end, counter);
+  }
+}
+
+void JobSystem::Wait(JobCounter& counter) {
+  const int queue = QueueIndex();
+
+  // Help with the work instead of blocking
+  Job job;
+  while (counter > 0) {
+    if (Pop(queue, job) || Steal(queue, job))
+      Execute(job);
+    else
+      std::this_thread::yield();
+  }
+}
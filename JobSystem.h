@@ -0,0 +1,247 @@
+/** @file JobSystem.h
+ *  @brief Header file for the job system
+ *
+ * This program is responsible for running batches of work on every core.
+ * Each thread owns a job queue and idle threads steal from the others.
+ *
+ *  @author Michael Martinez
+ *  @bug No known bugs.
+ */
+#ifndef _JOBSYSTEM_H
+#define _JOBSYSTEM_H
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/** @brief Job function type
+ *
+ * Function run by a job over the range begin to end.
+ *
+ */
+typedef void (*JobFunction)(void* data, int begin, int end);
+
+/** @brief Job counter type
+ *
+ * Number of unfinished jobs a caller is waiting on.
+ *
+ */
+typedef std::atomic<int> JobCounter;
+
+/**
+ * @brief The JobSystem class
+ * @author Michael Martinez
+ *
+ * JobSystem class which is used to spread independent batches of entities
+ * across worker threads.
+ *
+ */
+class JobSystem {
+ private:
+  /** @brief Job struct
+   *
+   * One range of work and the counter to lower once it is done.
+   *
+   */
+  struct Job {
+    JobFunction function;
+    void* data;
+    int begin;
+    int end;
+    JobCounter* counter;
+  };
+
+  /** @brief Queue capacity variable
+   *
+   * Number of jobs one thread's queue holds. Jobs that do not fit run right
+   * away on the calling thread.
+   *
+   */
+  static const int QUEUE_CAPACITY = 1024;
+
+  /** @brief Queue struct
+   *
+   * Fixed ring buffer of jobs. The owner takes from the back, other threads
+   * steal from the front.
+   *
+   */
+  struct Queue {
+    std::mutex mutex;
+    Job jobs[QUEUE_CAPACITY];
+    int head = 0;
+    int count = 0;
+  };
+
+  /** @brief Static instance variable
+   *
+   * Used within the Instance function to check if required to create a new
+   * job system.
+   *
+   */
+  static JobSystem* sInstance;
+
+  /** @brief Queues variable
+   *
+   * One queue per thread. Queue 0 belongs to whichever thread hands out
+   * work, normally the main thread.
+   *
+   */
+  std::vector<Queue*> mQueues;
+
+  /** @brief Workers variable
+   *
+   * Worker threads, which own queues 1 and up.
+   *
+   */
+  std::vector<std::thread> mWorkers;
+
+  /** @brief Pending variable
+   *
+   * Number of jobs sitting in any queue.
+   *
+   */
+  std::atomic<int> mPending;
+
+  /** @brief Quit variable
+   *
+   * Tells the workers to stop.
+   *
+   */
+  std::atomic<bool> mQuit;
+
+  /** @brief Sleep variables
+   *
+   * Used to park workers while there is nothing to run.
+   *
+   */
+  std::mutex mSleepMutex;
+  std::condition_variable mWake;
+
+ private:
+  /** @brief Push function
+   *
+   * Adds a job to a queue.
+   *
+   *  @param queue, job
+   *  @return bool false if the queue is full
+   */
+  bool Push(int queue, const Job& job);
+
+  /** @brief Pop function
+   *
+   * Takes the newest job from a thread's own queue.
+   *
+   *  @param queue, job
+   *  @return bool false if the queue is empty
+   */
+  bool Pop(int queue, Job& job);
+
+  /** @brief Steal function
+   *
+   * Takes the oldest job from any other thread's queue.
+   *
+   *  @param queue, job
+   *  @return bool false if every queue is empty
+   */
+  bool Steal(int queue, Job& job);
+
+  /** @brief Execute function
+   *
+   * Runs a job and lowers its counter.
+   *
+   *  @param job
+   *  @return void
+   */
+  static void Execute(const Job& job);
+
+  /** @brief Worker function
+   *
+   * Main loop of a worker thread.
+   *
+   *  @param queue
+   *  @return void
+   */
+  void Worker(int queue);
+
+  /** @brief Queue index function
+   *
+   * Used to return the queue of the calling thread.
+   *
+   *  @return int
+   */
+  int QueueIndex() noexcept;
+
+ public:
+  /** @brief Instance function
+   *
+   * Used to create and return a job system with one thread per core if the
+   * static instance is null.
+   *
+   */
+  static JobSystem* Instance();
+
+  /** @brief Release function
+   *
+   * Frees the static instance.
+   *
+   *  @return void
+   */
+  static void Release() noexcept;
+
+  /** @brief Constructor
+   *
+   * Starts the worker threads. The calling thread counts as one thread.
+   *
+   *  @param threads
+   */
+  JobSystem(int threads);
+
+  /** @brief Deconstructor
+   *
+   * Stops and joins every worker thread.
+   *
+   */
+  ~JobSystem();
+
+  /** @brief Threads function
+   *
+   * Used to return the number of threads running jobs, including the
+   * calling thread.
+   *
+   *  @return int
+   */
+  int Threads() noexcept;
+
+  /** @brief Run function
+   *
+   * Queues one job and raises its counter.
+   *
+   *  @param function, data, begin, end, counter
+   *  @return void
+   */
+  void Run(JobFunction function, void* data, int begin, int end,
+           JobCounter& counter);
+
+  /** @brief Parallel for function
+   *
+   * Splits the range 0 to count into batches and queues one job per batch.
+   * A range that fits in one batch runs right away on the calling thread.
+   *
+   *  @param function, data, count, batch, counter
+   *  @return void
+   */
+  void ParallelFor(JobFunction function, void* data, int count, int batch,
+                   JobCounter& counter);
+
+  /** @brief Wait function
+   *
+   * Runs queued jobs on the calling thread until a counter reaches zero.
+   *
+   *  @param counter
+   *  @return void
+   */
+  void Wait(JobCounter& counter);
+};
+
+#endif
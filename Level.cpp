@@ -9,23 +9,18 @@
  */
 #include "Level.h"
 
-Level::Level(int stage, PlayBG* playBG, Player* player) {
-  mTimer = Timer::Instance();
+Level::Level(int stage, PlayBG* playBG, Player* player,
+             Particles* particles) {
+  mTimer = FixedTimer::Instance();
   mPlayBG = playBG;
-  mPlayBG->SetLevel(stage);
 
-  mStage = stage;
-  mStageStarted = false;
-
-  mLabelTimer = 0.0f;
+  mScripts = new Scheduler();
 
   mStageLabelOnScreen = 0.0f;
   mStageLabelOffScreen = 1.5f;
 
   // Battle start message entity
-  // C26409: Fixing warning to replace 'new' requires editing included
-  // framework library 'QuickSDL"
-  mReadyLabel = new Texture("battleStart.png");
+  mReadyLabel = ObjectPool<Texture>::Create("battleStart.png");
   mReadyLabel->Parent(this);
   mReadyLabel->Pos(Vector2(Graphics::Instance()->SCREEN_WIDTH * 0.5f,
                            Graphics::Instance()->SCREEN_HEIGHT * 0.3f));
@@ -35,133 +30,287 @@ Level::Level(int stage, PlayBG* playBG, Player* player) {
 
   // Player settings
   mPlayer = player;
-  mPlayerHit = false;
+  mParticles = particles;
   mPlayerRespawnDelay = 3.0f;
-  mPlayerRespawnTimer = 0.0f;
   mPlayerRespawnLabelOnScreen = 2.0f;
 
+  // Virus entities
+  mViruses = new Viruses();
+  mViruses->Parent(this);
+  mVirusHP = 1;
+
+  // Virus attack entities
+  mProjectiles = new Projectiles();
+  mProjectiles->Parent(this);
+  mAttacks = new AttackVM(mProjectiles);
+  CompileAttacks();
+  mPlayerHitRadius = 40.0f;
+
   // Game over entities
-  // C26409: Fixing warning to replace 'new' requires editing included
-  // framework library 'QuickSDL"
-  mGameOverLabel = new Texture("GAME OVER", "BN6FontBold.ttf", 75, {150, 0, 0});
+  mGameOverLabel = ObjectPool<Texture>::Create("GAME OVER", "BN6FontBold.ttf",
+                                               75, SDL_Color{150, 0, 0});
   mGameOverLabel->Parent(this);
   mGameOverLabel->Pos(Vector2(Graphics::Instance()->SCREEN_WIDTH * 0.5f,
                               Graphics::Instance()->SCREEN_HEIGHT * 0.3f));
 
   mGameOver = false;
   mGameOverDelay = 6.0f;
-  mGameOverTimer = 0.0f;
   mGameOverLabelOnScreen = 1.0f;
 
-  // C26812: Changing 'enum' to 'enum class' would cause compilation error,
-  // making all types into undeclared identifiers
-  mCurrentState = running;
+  Reset(stage);
 }
 
 // C26432: deleting all would cause compiling error
 Level::~Level() {
+  // Scripts go first, they may still point at everything below
+  delete mScripts;
+  mScripts = nullptr;
+
   mTimer = nullptr;
   mPlayBG = nullptr;
 
-  delete mReadyLabel;
+  ObjectPool<Texture>::Destroy(mReadyLabel);
   mReadyLabel = nullptr;
 
   mPlayer = nullptr;
+  mParticles = nullptr;
+
+  delete mViruses;
+  mViruses = nullptr;
+
+  delete mAttacks;
+  mAttacks = nullptr;
 
-  delete mGameOverLabel;
+  delete mProjectiles;
+  mProjectiles = nullptr;
+
+  ObjectPool<Texture>::Destroy(mGameOverLabel);
   mGameOverLabel = nullptr;
 }
 
+void* Level::operator new(std::size_t size) {
+  return ObjectPool<Level>::Allocate(size);
+}
+
+void Level::operator delete(void* object) noexcept {
+  ObjectPool<Level>::Free(object);
+}
+
+void Level::Reset(int stage) {
+  // Scripts go first, they may still be running the last stage
+  mScripts->Clear();
+
+  mPlayBG->SetLevel(stage);
+  mStage = stage;
+  mStageStarted = false;
+
+  mReadyLabelVisible = false;
+  mPlayerHit = false;
+  mGameOverLabelVisible = false;
+
+  SpawnViruses();
+  mAttacks->Clear();
+  mProjectiles->Clear();
+
+  // C26812: Changing 'enum' to 'enum class' would cause compilation error,
+  // making all types into undeclared identifiers
+  mCurrentState = running;
+
+  mScripts->Spawn(StartSequence());
+}
+
 void Level::StartStage() noexcept { mStageStarted = true; }
 
-void Level::HandleStartLabels() {
-  mLabelTimer += mTimer->DeltaTime();
-  if (mLabelTimer >= mStageLabelOffScreen) {
-    if (mStage > 1) {
-      StartStage();
-    } else {
-      if (mLabelTimer >= mReadyLabelOffScreen) {
-        StartStage();
-        mPlayer->Active(true);
-        mPlayer->Visible(true);
-      }
+Scheduler::Task Level::StartSequence() {
+  co_await mScripts->Wait(mStageLabelOffScreen - mStageLabelOnScreen);
+
+  // Only the first stage brings the player in
+  if (mStage == 1) {
+    mReadyLabelVisible = true;
+    co_await mScripts->Wait(mReadyLabelOffScreen - mReadyLabelOnScreen);
+    mReadyLabelVisible = false;
+
+    mPlayer->Active(true);
+    mPlayer->Visible(true);
+  }
+
+  StartStage();
+}
+
+void Level::SpawnViruses() {
+  // Stage viruses
+  mViruses->Clear();
+  mViruses->Spawn(0, 1, mVirusHP, Viruses::idle);
+  mViruses->Spawn(1, 0, mVirusHP, Viruses::patrol);
+  mViruses->Spawn(2, 2, mVirusHP + mStage / 3, Viruses::chase);
+}
+
+void Level::CompileAttacks() {
+  // Idle viruses fire one straight shot
+  gsl::at(mAttackScripts, Viruses::idle) = mAttacks->Compile(
+      "set r0 3.14159\n"
+      "set r1 400\n"
+      "fire r0 r1 0\n");
+
+  // Patrolling viruses fire a three way spread
+  gsl::at(mAttackScripts, Viruses::patrol) = mAttacks->Compile(
+      "set r0 2.89\n"
+      "set r1 350\n"
+      "set r2 3\n"
+      "spread:\n"
+      "fire r0 r1 0\n"
+      "addi r0 r0 0.25\n"
+      "decjnz r2 spread\n");
+
+  // Chasing viruses fire a wave, then one homing shot
+  gsl::at(mAttackScripts, Viruses::chase) = mAttacks->Compile(
+      "set r1 300\n"
+      "set r2 5\n"
+      "wave:\n"
+      "sin r4 r3\n"
+      "muli r4 r4 0.3\n"
+      "addi r4 r4 3.14159\n"
+      "fire r4 r1 0\n"
+      "addi r3 r3 1.2\n"
+      "wait 0.15\n"
+      "decjnz r2 wave\n"
+      "aim r0\n"
+      "fire r0 r1 1\n");
+}
+
+void Level::HandleAttacks() {
+  for (int i = 0; i < mViruses->Count(); i++) {
+    if (mViruses->Firing(i)) {
+      mAttacks->Emit(gsl::at(mAttackScripts, mViruses->Behavior(i)),
+                     mViruses->SlotPos(i));
     }
   }
+
+  mAttacks->Target(mPlayer->Pos());
+  mAttacks->Run(mTimer->DeltaTime());
+
+  mProjectiles->Target(mPlayer->Pos());
+  mProjectiles->Update();
 }
 
 void Level::HandleCollisions() {
-  // Player hit
-  if (!mPlayerHit) {
-    if (InputManager::Instance()->KeyPressed(SDL_SCANCODE_X)) {
-      mPlayer->WasHit();
-      mPlayBG->SetLives(mPlayer->Lives());
-
-      mPlayerHit = true;
-      mPlayerRespawnTimer = 0.0f;
-      mPlayer->Active(false);
+  // Bullets hitting viruses, with the effects played once all are resolved
+  FrameVector<Hit> hits;
+  for (int i = 0; i < mPlayer->BulletCount(); i++) {
+    Bullet* bullet = mPlayer->Bullets(i);
+    if (!bullet->Active()) continue;
+
+    const int virus = mViruses->HitTest(bullet->Pos());
+    if (virus >= 0) {
+      Hit hit;
+      hit.pos = bullet->Pos();
+      hit.virusPos = mViruses->SlotPos(virus);
+      hit.deleted = mViruses->Damage(virus, 1);
+      hits.push_back(hit);
+
+      bullet->Reload();
+    }
+  }
+
+  for (const Hit& hit : hits) {
+    mParticles->HitSpark(hit.pos);
+
+    if (hit.deleted) {
+      mParticles->DeletionBurst(hit.virusPos);
+      mPlayer->AddScore(10);
     }
   }
+
+  // Player hit
+  if (!mPlayerHit && mProjectiles->HitTest(mPlayer->Pos(), mPlayerHitRadius))
+    HitPlayer();
 }
 
-void Level::HandlePlayerDeath() {
+void Level::HitPlayer() {
+  mPlayer->WasHit();
+  mPlayBG->SetLives(mPlayer->Lives());
+
+  mPlayerHit = true;
+  mPlayer->Active(false);
+  mScripts->Spawn(HitSequence());
+}
+
+Scheduler::Task Level::HitSequence() {
+  while (mPlayer->IsAnimating()) co_await mScripts->NextStep();
+  mPlayer->Visible(false);
+
   // Player losing lives
-  if (!mPlayer->IsAnimating()) {
-    if (mPlayer->Lives() > 0) {
-      if (mPlayerRespawnTimer == 0.0f) mPlayer->Visible(false);
-
-      mPlayerRespawnTimer += mTimer->DeltaTime();
-      if (mPlayerRespawnTimer >= mPlayerRespawnDelay) {
-        mPlayer->Active(true);
-        mPlayer->Visible(true);
-        mPlayerHit = false;
-      }
-
-    } else {
-      if (mGameOverTimer == 0.0f) mPlayer->Visible(false);
-
-      mGameOverTimer += mTimer->DeltaTime();
-      if (mGameOverTimer >= mGameOverDelay) {
-        mCurrentState = gameover;
-      }
-    }
+  if (mPlayer->Lives() > 0) {
+    co_await mScripts->Wait(mPlayerRespawnLabelOnScreen);
+    mReadyLabelVisible = true;
+    co_await mScripts->Wait(mPlayerRespawnDelay - mPlayerRespawnLabelOnScreen);
+    mReadyLabelVisible = false;
+
+    mPlayer->Active(true);
+    mPlayer->Visible(true);
+    mPlayerHit = false;
+
+  } else {
+    co_await mScripts->Wait(mGameOverLabelOnScreen);
+    mGameOverLabelVisible = true;
+    co_await mScripts->Wait(mGameOverDelay - mGameOverLabelOnScreen);
+
+    mCurrentState = gameover;
   }
 }
 
 Level::LEVEL_STATES Level::State() noexcept { return mCurrentState; }
 
+bool Level::Playing() noexcept {
+  // C26812: Changing 'enum' to 'enum class' would cause compilation
+  // error, making all types into undeclared identifiers
+  return mStageStarted && mCurrentState == running;
+}
+
+void Level::HandleAction(ActionMap::ACTIONS action) {
+  if (!mStageStarted || mPlayerHit) return;
+
+  // C26812: Changing 'enum' to 'enum class' would cause compilation
+  // error, making all types into undeclared identifiers
+  if (action == ActionMap::hit)
+    HitPlayer();
+  else if (action == ActionMap::skip)
+    mCurrentState = finished;
+}
+
+void Level::Hash(StateHash* hash) {
+  hash->Add("level.state", mStage);
+  hash->Add("level.state", static_cast<int>(mCurrentState));
+  hash->Add("level.state", mStageStarted);
+  hash->Add("level.state", mPlayerHit);
+  hash->Add("level.state", mReadyLabelVisible);
+  hash->Add("level.state", mGameOverLabelVisible);
+  mScripts->Hash(hash, "level.scripts");
+  mViruses->Hash(hash);
+  mProjectiles->Hash(hash);
+}
+
 // C26433: Method is not a virtual function to use override.
 void Level::Update() {
-  if (!mStageStarted) {
-    HandleStartLabels();
+  mScripts->Advance(mTimer->DeltaTime());
 
-  } else {
-    HandleCollisions();
+  if (mStageStarted) {
+    mViruses->TargetRow(mViruses->Row(mPlayer->Pos()));
+    mViruses->Update();
+    HandleAttacks();
 
-    if (mPlayerHit) {
-      HandlePlayerDeath();
+    HandleCollisions();
 
-    } else {
-      if (InputManager::Instance()->KeyPressed(SDL_SCANCODE_N)) {
-        mCurrentState = finished;
-      }
-    }
+    if (!mPlayerHit && mViruses->Count() == 0) mCurrentState = finished;
   }
 }
 // C26433: Method is not a virtual function to use override.
 void Level::Render() {
-  if (!mStageStarted) {
-    if (mLabelTimer > mStageLabelOnScreen &&
-        mLabelTimer < mStageLabelOffScreen) {
-    } else if (mLabelTimer > mReadyLabelOnScreen &&
-               mLabelTimer < mReadyLabelOffScreen) {
-      mReadyLabel->Render();
-    }
-  } else {
-    if (mPlayerHit) {
-      if (mPlayerRespawnTimer >= mPlayerRespawnLabelOnScreen)
-        mReadyLabel->Render();
-
-      if (mGameOverTimer >= mGameOverLabelOnScreen) mGameOverLabel->Render();
-    }
+  if (mStageStarted) {
+    mViruses->Render();
+    mProjectiles->Render();
   }
+
+  if (mReadyLabelVisible) RenderList::Draw(mReadyLabel);
+  if (mGameOverLabelVisible) RenderList::Draw(mGameOverLabel);
 }
\ No newline at end of file
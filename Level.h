@@ -9,9 +9,15 @@
  */
 #ifndef _LEVEL_H
 #define _LEVEL_H
-#include "InputManager.h"
+#include "ActionMap.h"
+#include "AttackVM.h"
+#include "FrameArena.h"
 #include "PlayBG.h"
 #include "Player.h"
+#include "Scheduler.h"
+#include "SlabPool.h"
+#include "StateHash.h"
+#include "Viruses.h"
 
 /**
  * @brief The Level class
@@ -30,12 +36,24 @@ class Level : public GameEntity {
   enum LEVEL_STATES { running, finished, gameover };
 
  private:
+  /** @brief Hit struct
+   *
+   * Bullet that hit a virus this step, where it hit and whether the virus
+   * was deleted.
+   *
+   */
+  struct Hit {
+    Vector2 pos;
+    Vector2 virusPos;
+    bool deleted;
+  };
+
   /** @brief Timer variable
    *
    * Used to keep track of time between resets.
    *
    */
-  Timer* mTimer;
+  FixedTimer* mTimer;
 
   /** @brief Playscreen background variable
    *
@@ -46,7 +64,7 @@ class Level : public GameEntity {
 
   /** @brief Stage variable
    *
-   * Used for the 'HandleStartLabels' function.
+   * Used for the 'StartSequence' script.
    *
    */
   int mStage;
@@ -58,12 +76,19 @@ class Level : public GameEntity {
    */
   bool mStageStarted;
 
-  /** @brief Label timer variable
+  /** @brief Scripts variable
    *
-   * Used as a comparison to render the mReadyLabel texture.
+   * Runs the stage start and player hit sequences.
    *
    */
-  float mLabelTimer;
+  Scheduler* mScripts;
+
+  /** @brief Ready label visible variable
+   *
+   * Set by the scripts while the ready label is on screen.
+   *
+   */
+  bool mReadyLabelVisible;
 
   /** @brief Label on screen variable
    *
@@ -102,6 +127,55 @@ class Level : public GameEntity {
 
   Player* mPlayer;
 
+  /** @brief Particles variable
+   *
+   * Used for sparks when bullets hit viruses.
+   *
+   */
+  Particles* mParticles;
+
+  /** @brief Viruses variable
+   *
+   * Every virus the player has to delete to clear the stage.
+   *
+   */
+  Viruses* mViruses;
+
+  /** @brief Projectiles variable
+   *
+   * Every projectile fired by viruses.
+   *
+   */
+  Projectiles* mProjectiles;
+
+  /** @brief Attacks variable
+   *
+   * Runs the attack pattern of every virus that fired.
+   *
+   */
+  AttackVM* mAttacks;
+
+  /** @brief Attack scripts variable
+   *
+   * Compiled attack pattern for each virus behavior.
+   *
+   */
+  int mAttackScripts[Viruses::TOTAL_BEHAVIORS];
+
+  /** @brief Player hit radius variable
+   *
+   * Distance from the player a projectile has to reach to hit.
+   *
+   */
+  float mPlayerHitRadius;
+
+  /** @brief Virus HP variable
+   *
+   * HP each virus spawns with.
+   *
+   */
+  int mVirusHP;
+
   /** @brief Player hit variable
    *
    * Checks whether player is hit or not.
@@ -116,13 +190,6 @@ class Level : public GameEntity {
    */
   float mPlayerRespawnDelay;
 
-  /** @brief Respawn timer variable
-   *
-   * Timer for respawn delay
-   *
-   */
-  float mPlayerRespawnTimer;
-
   /** @brief respawn label on screen
    *
    * Used to render ready label.
@@ -151,12 +218,12 @@ class Level : public GameEntity {
    */
   float mGameOverDelay;
 
-  /** @brief Game over timer variable
+  /** @brief Game over label visible variable
    *
-   * Timer used to count to game over delay.
+   * Set by the hit sequence once the game over label is on screen.
    *
    */
-  float mGameOverTimer;
+  bool mGameOverLabelVisible;
 
   /** @brief Game over label screen variable
    *
@@ -180,30 +247,64 @@ class Level : public GameEntity {
    *  @return void
    */
   void StartStage() noexcept;
-  /** @brief Handle start label function
+  /** @brief Start sequence script
+   *
+   * Shows the start labels, then starts the stage. The first stage also
+   * brings the player in.
    *
-   * Used to handle start label for level.
+   *  @return Scheduler::Task
+   */
+  Scheduler::Task StartSequence();
+
+  /** @brief Spawn viruses function
+   *
+   * Spawns the viruses for the current stage.
+   *
+   *  @return void
+   */
+  void SpawnViruses();
+
+  /** @brief Compile attacks function
+   *
+   * Compiles the attack pattern of every virus behavior.
+   *
+   *  @return void
+   */
+  void CompileAttacks();
+
+  /** @brief Handle attacks function
+   *
+   * Starts the attack pattern of every virus that fired and moves every
+   * projectile.
    *
    *  @return void
    */
-  void HandleStartLabels();
+  void HandleAttacks();
 
   /** @brief Handle collision function
    *
-   * Used to handle player damage, as well handle keyboard input to die
-   * manually.
+   * Used to handle player damage and bullets hitting viruses.
    *
    *  @return void
    */
   void HandleCollisions();
 
-  /** @brief Handle player death function
+  /** @brief Hit player function
    *
-   * Used to handle player lives as well as handling game over.
+   * Takes a life from the player and starts the hit sequence.
    *
    *  @return void
    */
-  void HandlePlayerDeath();
+  void HitPlayer();
+
+  /** @brief Hit sequence script
+   *
+   * Waits out the death animation, then respawns the player or ends the game
+   * once they run out of lives.
+   *
+   *  @return Scheduler::Task
+   */
+  Scheduler::Task HitSequence();
 
  public:
   /** @brief Constructor
@@ -211,10 +312,10 @@ class Level : public GameEntity {
    * Creates textures, handles all timers and delays, and sets the current state
    * of the stage to running.
    *
-   *  @param stage, playBG, player
+   *  @param stage, playBG, player, particles
    */
   // LO1b
-  Level(int stage, PlayBG* playBG, Player* player);
+  Level(int stage, PlayBG* playBG, Player* player, Particles* particles);
 
   /** @brief Deconstructor
    *
@@ -223,6 +324,34 @@ class Level : public GameEntity {
    */
   virtual ~Level();
 
+  /** @brief New operator
+   *
+   * Takes the level's memory from its slab pool.
+   *
+   *  @param size
+   *  @return void*
+   */
+  static void* operator new(std::size_t size);
+
+  /** @brief Delete operator
+   *
+   * Gives the level's memory back to its slab pool.
+   *
+   *  @param object
+   *  @return void
+   */
+  static void operator delete(void* object) noexcept;
+
+  /** @brief Reset function
+   *
+   * Starts 'stage' over in place. Textures, buffers and compiled attacks are
+   * kept, only the state the constructor sets is put back.
+   *
+   *  @param stage
+   *  @return void
+   */
+  void Reset(int stage);
+
   /** @brief State function
    *
    * Used to return current state.
@@ -230,6 +359,34 @@ class Level : public GameEntity {
    */
   LEVEL_STATES State() noexcept;
 
+  /** @brief Playing function
+   *
+   * Used to return true while the stage is being fought, after its start
+   * sequence and before it is finished or lost.
+   *
+   *  @return bool
+   */
+  bool Playing() noexcept;
+
+  /** @brief Handle action function
+   *
+   * Used to die manually or skip the stage while the stage is running and
+   * the player is alive.
+   *
+   *  @param action
+   *  @return void
+   */
+  void HandleAction(ActionMap::ACTIONS action);
+
+  /** @brief Hash function
+   *
+   * Adds stage, state, scripts, viruses and projectiles to the state hash.
+   *
+   *  @param hash
+   *  @return void
+   */
+  void Hash(StateHash* hash);
+
   /** @brief Update
    *
    * Updates player damage, stage labels, and updates currentstate to finish
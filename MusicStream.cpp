@@ -0,0 +1,276 @@
+/** @file MusicStream.cpp
+ *  @brief Source file for streamed music
+ *
+ * This program is responsible for playing music straight from its file,
+ * decoding a little at a time instead of holding the whole track in memory.
+ *
+ *  @author Michael Martinez
+ *  @bug Only plays 16 bit PCM WAV files, other music goes to the audio
+ *  manager.
+ */
+#include "MusicStream.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+// Reads a little endian number of 'bytes' bytes
+bool ReadNumber(std::FILE* file, int bytes, unsigned int& value) {
+  unsigned char data[4] = {0, 0, 0, 0};
+  if (std::fread(data, 1, bytes, file) != static_cast<std::size_t>(bytes))
+    return false;
+
+  value = data[0] | data[1] << 8 | data[2] << 16 |
+          static_cast<unsigned int>(data[3]) << 24;
+  return true;
+}
+
+bool ReadTag(std::FILE* file, char* tag) {
+  return std::fread(tag, 1, 4, file) == 4;
+}
+
+}  // namespace
+
+// C26455: Fixing the warning 'noexcept' solution is to not include 'noexcept'
+// in the first place.
+//(https://docs.microsoft.com/en-us/cpp/code-quality/c26447?view=msvc-170)
+MusicStream::MusicStream() {
+  mFile = nullptr;
+  mDataStart = 0;
+  mDataBytes = 0;
+  mDataLeft = 0;
+  mSourceRate = 0;
+  mSourceChannels = 0;
+  mRate = 0;
+  mChannels = 0;
+  mLoops = 0;
+  mChunkFrames = 0;
+  mChunkPos = 0;
+  mStep = 1.0;
+  mPosition = 0.0;
+  mReadAll = true;
+  mHead = 0;
+  mTail = 0;
+  mEnded = true;
+  mPaused = false;
+  mFirstSample = -1.0f;
+  mUnderruns = 0;
+  mDecodedBytes = 0;
+}
+
+// C26432: deleting all would cause compiling error
+MusicStream::~MusicStream() { Close(); }
+
+bool MusicStream::Open(const char* path, int loops, int rate, int channels) {
+  Close();
+  if (rate <= 0 || channels < 1 || channels > MAX_CHANNELS) return false;
+
+  mOpened = Clock::now();
+  mFirstSample = -1.0f;
+  mFile = std::fopen(path, "rb");
+  if (mFile == nullptr) return false;
+
+  char tag[4];
+  unsigned int size = 0;
+  unsigned int format = 0;
+  unsigned int sourceChannels = 0;
+  unsigned int sourceRate = 0;
+  unsigned int bits = 0;
+  bool valid = ReadTag(mFile, tag) && std::memcmp(tag, "RIFF", 4) == 0 &&
+               ReadNumber(mFile, 4, size) && ReadTag(mFile, tag) &&
+               std::memcmp(tag, "WAVE", 4) == 0;
+
+  // Chunks up to the samples, skipping any that are not the format
+  while (valid && ReadTag(mFile, tag) && ReadNumber(mFile, 4, size)) {
+    if (std::memcmp(tag, "data", 4) == 0) {
+      mDataStart = std::ftell(mFile);
+      mDataBytes = size;
+      break;
+    }
+
+    const long start = std::ftell(mFile);
+    if (std::memcmp(tag, "fmt ", 4) == 0) {
+      unsigned int unused = 0;
+      valid = ReadNumber(mFile, 2, format) &&
+              ReadNumber(mFile, 2, sourceChannels) &&
+              ReadNumber(mFile, 4, sourceRate) &&
+              ReadNumber(mFile, 4, unused) && ReadNumber(mFile, 2, unused) &&
+              ReadNumber(mFile, 2, bits);
+    }
+
+    // Chunks are padded to an even size
+    valid = valid &&
+            std::fseek(mFile, start + size + (size & 1), SEEK_SET) == 0;
+  }
+
+  const unsigned int frameBytes = 2 * sourceChannels;
+  if (!valid || mDataBytes == 0 || format != 1 || bits != 16 ||
+      sourceChannels < 1 || sourceChannels > MAX_CHANNELS || sourceRate == 0 ||
+      mDataBytes < frameBytes) {
+    Close();
+    return false;
+  }
+
+  mSourceRate = sourceRate;
+  mSourceChannels = sourceChannels;
+  mRate = rate;
+  mChannels = channels;
+  mLoops = loops;
+  mDataBytes -= mDataBytes % frameBytes;
+  mDataLeft = mDataBytes;
+  mStep = static_cast<double>(mSourceRate) / mRate;
+
+  const long long frames = mDataBytes / frameBytes;
+  mDecodedBytes = frames * mRate / mSourceRate * 2 * mChannels;
+
+  // The first frame is read now so output starts exactly on it
+  mReadAll = !NextFrame(mCurrent);
+  mEnded = mReadAll;
+  mPosition = 1.0;
+  return !mEnded;
+}
+
+void MusicStream::Close() noexcept {
+  if (mFile != nullptr) std::fclose(mFile);
+  mFile = nullptr;
+
+  mDataBytes = 0;
+  mDataLeft = 0;
+  mChunkFrames = 0;
+  mChunkPos = 0;
+  mHead = 0;
+  mTail = 0;
+  mEnded = true;
+  mPaused = false;
+}
+
+void MusicStream::Decode() noexcept {
+  if (mFile == nullptr || mEnded) return;
+
+  const unsigned int tail = mTail.load(std::memory_order_acquire);
+  unsigned int head = mHead.load(std::memory_order_relaxed);
+
+  while (head - tail < RING_FRAMES) {
+    // Steps past as many source frames as the output frame moved on, the
+    // last frame standing in for the one after it
+    while (mPosition >= 1.0 && !mEnded) {
+      mEnded = mReadAll;
+      std::copy(mCurrent, mCurrent + MAX_CHANNELS, mPrevious);
+      mReadAll = !NextFrame(mCurrent);
+      mPosition -= 1.0;
+    }
+    if (mEnded) break;
+
+    Sint16* frame = mRing + (head & (RING_FRAMES - 1)) * mChannels;
+    for (int i = 0; i < mChannels; i++) {
+      frame[i] = static_cast<Sint16>(
+          mPrevious[i] + (mCurrent[i] - mPrevious[i]) * mPosition);
+    }
+
+    mPosition += mStep;
+    head++;
+  }
+
+  mHead.store(head, std::memory_order_release);
+}
+
+bool MusicStream::Finished() noexcept {
+  return mEnded && mHead.load(std::memory_order_acquire) ==
+                       mTail.load(std::memory_order_acquire);
+}
+
+void MusicStream::Pause(bool paused) noexcept { mPaused = paused; }
+
+void MusicStream::Mix(Uint8* stream, int len) noexcept {
+  Sint16* out = reinterpret_cast<Sint16*>(stream);
+  const int frames = len / (2 * mChannels);
+  int copied = 0;
+
+  if (!mPaused) {
+    const unsigned int head = mHead.load(std::memory_order_acquire);
+    const unsigned int tail = mTail.load(std::memory_order_relaxed);
+    copied = std::min<unsigned int>(frames, head - tail);
+
+    // Copied in two parts when the frames wrap around the ring
+    const int start = tail & (RING_FRAMES - 1);
+    const int first = std::min(copied, RING_FRAMES - start);
+    std::memcpy(out, mRing + start * mChannels, first * mChannels * 2);
+    std::memcpy(out + first * mChannels, mRing,
+                (copied - first) * mChannels * 2);
+    mTail.store(tail + copied, std::memory_order_release);
+
+    if (copied > 0 && mFirstSample < 0.0f) {
+      const std::chrono::duration<float, std::milli> elapsed =
+          Clock::now() - mOpened;
+      mFirstSample = elapsed.count();
+    }
+    if (copied < frames && !mEnded) mUnderruns++;
+  }
+
+  std::memset(out + copied * mChannels, 0, (frames - copied) * mChannels * 2);
+}
+
+void MusicStream::Callback(void* data, Uint8* stream, int len) {
+  static_cast<MusicStream*>(data)->Mix(stream, len);
+}
+
+int MusicStream::Buffered() noexcept {
+  return mHead.load(std::memory_order_acquire) -
+         mTail.load(std::memory_order_acquire);
+}
+
+std::size_t MusicStream::ResidentBytes() noexcept {
+  return sizeof(mRing) + sizeof(mChunk);
+}
+
+long long MusicStream::DecodedBytes() noexcept { return mDecodedBytes; }
+
+float MusicStream::FirstSample() noexcept { return mFirstSample; }
+
+int MusicStream::Underruns() noexcept { return mUnderruns; }
+
+bool MusicStream::NextFrame(int* frame) noexcept {
+  if (mChunkPos == mChunkFrames && !ReadChunk()) return false;
+
+  const Sint16* sample = mChunk + mChunkPos * mSourceChannels;
+  const int left = sample[0];
+  const int right = mSourceChannels > 1 ? sample[1] : sample[0];
+  mChunkPos++;
+
+  if (mChannels == 1) {
+    frame[0] = (left + right) / 2;
+  } else {
+    frame[0] = left;
+    frame[1] = right;
+  }
+  return true;
+}
+
+bool MusicStream::ReadChunk() noexcept {
+  // Looping here keeps the last frame of a pass next to the first of the next
+  if (mDataLeft == 0) {
+    if (mLoops == 0) return false;
+    if (mLoops > 0) mLoops--;
+
+    std::fseek(mFile, mDataStart, SEEK_SET);
+    mDataLeft = mDataBytes;
+  }
+
+  // Samples are little endian in the file, the same as every platform built
+  const unsigned int frameBytes = 2 * mSourceChannels;
+  const std::size_t frames =
+      std::min<unsigned int>(CHUNK_FRAMES, mDataLeft / frameBytes);
+  mChunkFrames = std::fread(mChunk, frameBytes, frames, mFile);
+  mChunkPos = 0;
+
+  // A file cut short ends the music rather than looping on nothing
+  if (mChunkFrames == 0) {
+    mLoops = 0;
+    mDataLeft = 0;
+    return false;
+  }
+
+  mDataLeft -= mChunkFrames * frameBytes;
+  return true;
+}
@@ -0,0 +1,325 @@
+/** @file MusicStream.h
+ *  @brief Header file for streamed music
+ *
+ * This program is responsible for playing music straight from its file,
+ * decoding a little at a time instead of holding the whole track in memory.
+ *
+ *  @author Michael Martinez
+ *  @bug Only plays 16 bit PCM WAV files, other music goes to the audio
+ *  manager.
+ */
+#ifndef _MUSICSTREAM_H
+#define _MUSICSTREAM_H
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+
+#include "SDL.h"
+
+/**
+ * @brief The MusicStream class
+ * @author Michael Martinez
+ *
+ * MusicStream class which is used to feed the mixer's music hook from a ring
+ * buffer. 'Decode' reads the file in chunks, converts them to the mixer's
+ * rate and channels and fills the ring, and is called by one thread only.
+ * The mixer empties the ring from its own thread through 'Callback'. Loops
+ * seek back to the start of the samples while decoding, so the end of one
+ * pass runs straight into the next with no gap. The ring holds a few
+ * hundred milliseconds, so decoding has to keep up at least that often.
+ *
+ */
+class MusicStream {
+ public:
+  /** @brief Ring frames variable
+   *
+   * Number of sample frames the ring holds, a power of two.
+   *
+   */
+  static const int RING_FRAMES = 16384;
+
+  /** @brief Chunk frames variable
+   *
+   * Number of sample frames read from the file at a time.
+   *
+   */
+  static const int CHUNK_FRAMES = 1024;
+
+  /** @brief Max channels variable
+   *
+   * Most channels a file or the mixer may have.
+   *
+   */
+  static const int MAX_CHANNELS = 2;
+
+  /** @brief Clock type
+   *
+   * Clock the time to the first sample is measured with.
+   *
+   */
+  typedef std::chrono::steady_clock Clock;
+
+ private:
+  /** @brief File variable
+   *
+   * File being streamed, or null when nothing is open.
+   *
+   */
+  std::FILE* mFile;
+
+  /** @brief Data variables
+   *
+   * Where the samples start in the file, their size in bytes and the bytes
+   * left to read in the current pass.
+   *
+   */
+  long mDataStart;
+  unsigned int mDataBytes;
+  unsigned int mDataLeft;
+
+  /** @brief Source variables
+   *
+   * Sample rate and channels of the file.
+   *
+   */
+  int mSourceRate;
+  int mSourceChannels;
+
+  /** @brief Output variables
+   *
+   * Sample rate and channels of the mixer.
+   *
+   */
+  int mRate;
+  int mChannels;
+
+  /** @brief Loops variable
+   *
+   * Passes left after the current one, -1 for forever.
+   *
+   */
+  int mLoops;
+
+  /** @brief Chunk variables
+   *
+   * Samples last read from the file, how many frames that was and the next
+   * frame to use.
+   *
+   */
+  Sint16 mChunk[CHUNK_FRAMES * MAX_CHANNELS];
+  int mChunkFrames;
+  int mChunkPos;
+
+  /** @brief Resampling variables
+   *
+   * Source frames per output frame, how far the next output frame is past
+   * 'mPrevious' and the two source frames it falls between, already in the
+   * mixer's channels.
+   *
+   */
+  double mStep;
+  double mPosition;
+  int mPrevious[MAX_CHANNELS];
+  int mCurrent[MAX_CHANNELS];
+
+  /** @brief Read all variable
+   *
+   * Set once the last frame of the last pass is read from the file.
+   *
+   */
+  bool mReadAll;
+
+  /** @brief Ring variable
+   *
+   * Decoded frames waiting for the mixer.
+   *
+   */
+  Sint16 mRing[RING_FRAMES * MAX_CHANNELS];
+
+  /** @brief Ring position variables
+   *
+   * Frames written by the decoder and frames read by the mixer, both only
+   * ever growing.
+   *
+   */
+  std::atomic<unsigned int> mHead;
+  std::atomic<unsigned int> mTail;
+
+  /** @brief Ended variable
+   *
+   * Set once the last pass has been decoded.
+   *
+   */
+  std::atomic<bool> mEnded;
+
+  /** @brief Paused variable
+   *
+   * True while the mixer plays silence instead of the ring.
+   *
+   */
+  std::atomic<bool> mPaused;
+
+  /** @brief Opened variable
+   *
+   * When the current file was opened.
+   *
+   */
+  Clock::time_point mOpened;
+
+  /** @brief Statistics variables
+   *
+   * Milliseconds from opening to the first sample reaching the mixer, or a
+   * negative number before it did, times the mixer found the ring empty and
+   * the bytes the whole track would take decoded.
+   *
+   */
+  std::atomic<float> mFirstSample;
+  std::atomic<int> mUnderruns;
+  std::atomic<long long> mDecodedBytes;
+
+ public:
+  /** @brief Constructor
+   *
+   * Creates a stream with nothing open.
+   *
+   */
+  MusicStream();
+
+  /** @brief Deconstructor
+   *
+   * Closes the file.
+   *
+   */
+  ~MusicStream();
+
+  /** @brief Open function
+   *
+   * Opens a WAV file to play 'loops' more times after the first, -1 for
+   * forever, at the mixer's 'rate' and 'channels'. Must not be called while
+   * the mixer is reading the ring.
+   *
+   *  @param path, loops, rate, channels
+   *  @return bool false if the file is missing or not 16 bit PCM
+   */
+  bool Open(const char* path, int loops, int rate, int channels);
+
+  /** @brief Close function
+   *
+   * Closes the file and empties the ring. Must not be called while the mixer
+   * is reading the ring.
+   *
+   *  @return void
+   */
+  void Close() noexcept;
+
+  /** @brief Decode function
+   *
+   * Fills the ring as far as it goes.
+   *
+   *  @return void
+   */
+  void Decode() noexcept;
+
+  /** @brief Finished function
+   *
+   * Used to return true once the last pass was decoded and played.
+   *
+   *  @return bool
+   */
+  bool Finished() noexcept;
+
+  /** @brief Pause function
+   *
+   * Sets whether the mixer plays silence in place of the music.
+   *
+   *  @param paused
+   *  @return void
+   */
+  void Pause(bool paused) noexcept;
+
+  /** @brief Mix function
+   *
+   * Fills the mixer's buffer of 'len' bytes from the ring, with silence for
+   * anything the ring is missing.
+   *
+   *  @param stream, len
+   *  @return void
+   */
+  void Mix(Uint8* stream, int len) noexcept;
+
+  /** @brief Callback function
+   *
+   * Music hook given to the mixer, with the stream as 'data'.
+   *
+   *  @param data, stream, len
+   *  @return void
+   */
+  static void Callback(void* data, Uint8* stream, int len);
+
+  /** @brief Buffered function
+   *
+   * Used to return the number of frames waiting in the ring.
+   *
+   *  @return int
+   */
+  int Buffered() noexcept;
+
+  /** @brief Resident bytes function
+   *
+   * Used to return the bytes of audio the stream holds, the same for any
+   * track.
+   *
+   *  @return std::size_t
+   */
+  static std::size_t ResidentBytes() noexcept;
+
+  /** @brief Decoded bytes function
+   *
+   * Used to return the bytes the open track would take fully decoded at the
+   * mixer's rate and channels.
+   *
+   *  @return long long
+   */
+  long long DecodedBytes() noexcept;
+
+  /** @brief First sample function
+   *
+   * Used to return the milliseconds from opening to the first sample
+   * reaching the mixer, or a negative number if none has yet.
+   *
+   *  @return float
+   */
+  float FirstSample() noexcept;
+
+  /** @brief Underruns function
+   *
+   * Used to return the times the mixer found the ring empty while music
+   * was still playing.
+   *
+   *  @return int
+   */
+  int Underruns() noexcept;
+
+ private:
+  /** @brief Next frame function
+   *
+   * Reads the next source frame in the mixer's channels, reading a chunk or
+   * looping back when needed.
+   *
+   *  @param frame
+   *  @return bool false once the last pass is read
+   */
+  bool NextFrame(int* frame) noexcept;
+
+  /** @brief Read chunk function
+   *
+   * Reads the next chunk of the file, seeking back to the start of the
+   * samples if the pass ended and loops are left.
+   *
+   *  @return bool false once the last pass is read
+   */
+  bool ReadChunk() noexcept;
+};
+
+#endif
@@ -0,0 +1,177 @@
+/** @file Particles.cpp
+ *  @brief Source file for particle effects
+ *
+ * This program is responsible for hit sparks, deletion bursts and muzzle
+ * flashes. Particles live in preallocated structure of arrays storage and are
+ * integrated four at a time with SIMD.
+ *
+ *  @author Michael Martinez
+ *  @bug No known bugs.
+ */
+#include "Particles.h"
+
+#include <cmath>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__SSE2__)
+#include <xmmintrin.h>
+#define PARTICLES_SSE
+#endif
+
+// C26455: Fixing the warning 'noexcept' solution is to not include 'noexcept'
+// in the first place.
+//(https://docs.microsoft.com/en-us/cpp/code-quality/c26447?view=msvc-170)
+Particles::Particles(int capacity, JobSystem* jobs) {
+  mTimer = FixedTimer::Instance();
+  mJobs = (jobs != nullptr) ? jobs : JobSystem::Instance();
+  mDeltaTime = 0.0f;
+
+  // Particle entity
+  mTexture = ObjectPool<Texture>::Create("particle.png");
+  mTexture->Parent(this);
+  mAlphaTexture = AssetManager::Instance()->GetTexture("particle.png");
+  SDL_SetTextureBlendMode(mAlphaTexture, SDL_BLENDMODE_BLEND);
+
+  mGravity = 600.0f;
+
+  // Rounded up so the SIMD loop never reads past the end
+  mCapacity = (capacity + 3) / 4 * 4;
+  mCount = 0;
+  mSeed = 2463534242u;
+
+  // Particle slots are only allocated here, never while playing
+  mX.resize(mCapacity);
+  mY.resize(mCapacity);
+  mVelX.resize(mCapacity);
+  mVelY.resize(mCapacity);
+  mAlpha.resize(mCapacity);
+  mFade.resize(mCapacity);
+}
+
+// C26432: deleting all would cause compiling error
+Particles::~Particles() {
+  mTimer = nullptr;
+  mJobs = nullptr;
+  mAlphaTexture = nullptr;
+
+  ObjectPool<Texture>::Destroy(mTexture);
+  mTexture = nullptr;
+}
+
+float Particles::Random(float min, float max) noexcept {
+  mSeed ^= mSeed << 13;
+  mSeed ^= mSeed >> 17;
+  mSeed ^= mSeed << 5;
+
+  return min + (max - min) * (mSeed & 0xFFFF) / 65535.0f;
+}
+
+void Particles::Burst(Vector2 pos, int count, float angle, float spread,
+                      float minSpeed, float maxSpeed, float fade) noexcept {
+  for (int i = 0; i < count && mCount < mCapacity; i++) {
+    const int slot = mCount++;
+    const float direction = angle + Random(-spread, spread);
+    const float speed = Random(minSpeed, maxSpeed);
+
+    mX[slot] = pos.x;
+    mY[slot] = pos.y;
+    mVelX[slot] = std::cos(direction) * speed;
+    mVelY[slot] = std::sin(direction) * speed;
+    mAlpha[slot] = 1.0f;
+    mFade[slot] = fade * Random(0.8f, 1.2f);
+  }
+}
+
+void Particles::HitSpark(Vector2 pos) noexcept {
+  Burst(pos, 20, 0.0f, 3.14159f, 100.0f, 300.0f, 3.0f);
+}
+
+void Particles::DeletionBurst(Vector2 pos) noexcept {
+  Burst(pos, 60, 0.0f, 3.14159f, 50.0f, 500.0f, 1.5f);
+}
+
+void Particles::MuzzleFlash(Vector2 pos) noexcept {
+  Burst(pos, 12, 0.0f, 0.4f, 200.0f, 400.0f, 4.0f);
+}
+
+void Particles::Clear() noexcept { mCount = 0; }
+
+int Particles::Count() noexcept { return mCount; }
+
+void Particles::Integrate(void* data, int begin, int end) {
+  Particles* particles = static_cast<Particles*>(data);
+  const float deltaTime = particles->mDeltaTime;
+  const float gravity = particles->mGravity * deltaTime;
+
+  float* x = particles->mX.data();
+  float* y = particles->mY.data();
+  float* velX = particles->mVelX.data();
+  float* velY = particles->mVelY.data();
+  float* alpha = particles->mAlpha.data();
+  const float* fade = particles->mFade.data();
+
+#ifdef PARTICLES_SSE
+  // Four particles per step
+  const __m128 dt4 = _mm_set1_ps(deltaTime);
+  const __m128 gravity4 = _mm_set1_ps(gravity);
+
+  for (int i = begin; i < end; i += 4) {
+    const __m128 vx = _mm_loadu_ps(velX + i);
+    const __m128 vy = _mm_add_ps(_mm_loadu_ps(velY + i), gravity4);
+
+    _mm_storeu_ps(x + i, _mm_add_ps(_mm_loadu_ps(x + i), _mm_mul_ps(vx, dt4)));
+    _mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(vy, dt4)));
+    _mm_storeu_ps(velY + i, vy);
+    _mm_storeu_ps(alpha + i,
+                  _mm_sub_ps(_mm_loadu_ps(alpha + i),
+                             _mm_mul_ps(_mm_loadu_ps(fade + i), dt4)));
+  }
+#else
+  for (int i = begin; i < end; i++) {
+    velY[i] += gravity;
+    x[i] += velX[i] * deltaTime;
+    y[i] += velY[i] * deltaTime;
+    alpha[i] -= fade[i] * deltaTime;
+  }
+#endif
+}
+
+void Particles::Simulate(float deltaTime) noexcept {
+  const int padded = (mCount + 3) / 4 * 4;
+
+  // Batches never share a particle, so they can run on any core
+  mDeltaTime = deltaTime;
+  JobCounter counter(0);
+  mJobs->ParallelFor(Integrate, this, padded, BATCH_SIZE, counter);
+  mJobs->Wait(counter);
+
+  // Remove faded particles by moving the last live one into their slot
+  int i = 0;
+  while (i < mCount) {
+    if (mAlpha[i] > 0.0f) {
+      i++;
+      continue;
+    }
+
+    const int last = --mCount;
+    mX[i] = mX[last];
+    mY[i] = mY[last];
+    mVelX[i] = mVelX[last];
+    mVelY[i] = mVelY[last];
+    mAlpha[i] = mAlpha[last];
+    mFade[i] = mFade[last];
+  }
+}
+
+// C26433: Method is not a virtual function to use override.
+void Particles::Update() { Simulate(mTimer->DeltaTime()); }
+
+// C26433: Method is not a virtual function to use override.
+void Particles::Render() {
+  // Drawn back along their paths by the time not yet simulated
+  const float lag = (1.0f - mTimer->Alpha()) * mTimer->DeltaTime();
+
+  for (int i = 0; i < mCount; i++) {
+    mTexture->Pos(Vector2(mX[i] - mVelX[i] * lag, mY[i] - mVelY[i] * lag));
+    RenderList::Draw(mTexture, static_cast<Uint8>(mAlpha[i] * 255.0f));
+  }
+}
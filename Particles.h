@@ -0,0 +1,241 @@
+/** @file Particles.h
+ *  @brief Header file for particle effects
+ *
+ * This program is responsible for hit sparks, deletion bursts and muzzle
+ * flashes. Particles live in preallocated structure of arrays storage and are
+ * integrated four at a time with SIMD.
+ *
+ *  @author Michael Martinez
+ *  @bug No known bugs.
+ */
+#ifndef _PARTICLES_H
+#define _PARTICLES_H
+#include <vector>
+
+#include "FixedTimer.h"
+#include "JobSystem.h"
+#include "RenderList.h"
+#include "SlabPool.h"
+#include "Texture.h"
+
+using namespace QuickSDL;
+
+/**
+ * @brief The Particles class
+ * @author Michael Martinez
+ *
+ * Particles class inheriting from GameEntity which is used to emit, integrate
+ * and render a pool of fading particles.
+ *
+ */
+class Particles : public GameEntity {
+ public:
+  /** @brief Default capacity variable
+   *
+   * Number of particle slots for a normal stage.
+   *
+   */
+  static const int DEFAULT_CAPACITY = 4096;
+
+ private:
+  /** @brief Timer variable
+   *
+   * Used to keep track of time between resets.
+   *
+   */
+  FixedTimer* mTimer;
+
+  /** @brief Jobs variable
+   *
+   * Used to integrate batches of particles on every core.
+   *
+   */
+  JobSystem* mJobs;
+
+  /** @brief Batch size variable
+   *
+   * Number of particles in one job. Kept a multiple of four for the SIMD
+   * loop.
+   *
+   */
+  static const int BATCH_SIZE = 8192;
+
+  /** @brief Delta time variable
+   *
+   * Delta time of the frame being simulated, read by every job.
+   *
+   */
+  float mDeltaTime;
+
+  /** @brief Particle texture
+   *
+   * Shared texture moved to every particle before rendering.
+   *
+   */
+  Texture* mTexture;
+
+  /** @brief Particle SDL texture
+   *
+   * The SDL texture behind 'mTexture', blended so particles can fade out.
+   *
+   */
+  SDL_Texture* mAlphaTexture;
+
+  /** @brief Gravity variable
+   *
+   * Downward pull on every particle.
+   *
+   */
+  float mGravity;
+
+  /** @brief Capacity variable
+   *
+   * Number of preallocated particle slots, rounded up to a multiple of four.
+   *
+   */
+  int mCapacity;
+
+  /** @brief Count variable
+   *
+   * Number of live particles. Live particles fill slots 0 to mCount - 1.
+   *
+   */
+  int mCount;
+
+  /** @brief Random seed variable
+   *
+   * State of the xorshift generator used to scatter particles.
+   *
+   */
+  unsigned int mSeed;
+
+  /** @brief Packed particle state
+   *
+   * One array per field, indexed by slot. 'mFade' is the alpha lost per
+   * second.
+   *
+   */
+  std::vector<float> mX;
+  std::vector<float> mY;
+  std::vector<float> mVelX;
+  std::vector<float> mVelY;
+  std::vector<float> mAlpha;
+  std::vector<float> mFade;
+
+ private:
+  /** @brief Random function
+   *
+   * Used to return a random number between min and max.
+   *
+   *  @param min, max
+   *  @return float
+   */
+  float Random(float min, float max) noexcept;
+
+  /** @brief Integrate job
+   *
+   * Integrates the particles from begin to end. Both are multiples of four.
+   *
+   *  @param data, begin, end
+   *  @return void
+   */
+  static void Integrate(void* data, int begin, int end);
+
+  /** @brief Burst function
+   *
+   * Emits particles from a point in a cone.
+   *
+   *  @param pos, count, angle, spread, minSpeed, maxSpeed, fade
+   *  @return void
+   */
+  void Burst(Vector2 pos, int count, float angle, float spread,
+             float minSpeed, float maxSpeed, float fade) noexcept;
+
+ public:
+  /** @brief Constructor
+   *
+   * Creates the particle texture and preallocates every slot. Without a job
+   * system the shared instance is used.
+   *
+   *  @param capacity, jobs
+   */
+  Particles(int capacity = DEFAULT_CAPACITY, JobSystem* jobs = nullptr);
+
+  /** @brief Deconstructor
+   *
+   * Freeing all entities
+   *
+   */
+  virtual ~Particles();
+
+  /** @brief Hit spark function
+   *
+   * Emits a small burst where something was hit.
+   *
+   *  @param pos
+   *  @return void
+   */
+  void HitSpark(Vector2 pos) noexcept;
+
+  /** @brief Deletion burst function
+   *
+   * Emits a large slow burst where something was deleted.
+   *
+   *  @param pos
+   *  @return void
+   */
+  void DeletionBurst(Vector2 pos) noexcept;
+
+  /** @brief Muzzle flash function
+   *
+   * Emits a short forward flash where a bullet was fired.
+   *
+   *  @param pos
+   *  @return void
+   */
+  void MuzzleFlash(Vector2 pos) noexcept;
+
+  /** @brief Clear function
+   *
+   * Frees every slot.
+   *
+   *  @return void
+   */
+  void Clear() noexcept;
+
+  /** @brief Count function
+   *
+   * Used to return the number of live particles.
+   *
+   *  @return int
+   */
+  int Count() noexcept;
+
+  /** @brief Simulate function
+   *
+   * Integrates position, velocity and alpha of every live particle and
+   * removes the ones that faded out.
+   *
+   *  @param deltaTime
+   *  @return void
+   */
+  void Simulate(float deltaTime) noexcept;
+
+  /** @brief Update function
+   *
+   * Simulates every particle with the frame's delta time.
+   *
+   *  @return void
+   */
+  void Update();
+
+  /** @brief Render function
+   *
+   * Renders all particles between the last two simulation steps.
+   *
+   *  @return void
+   */
+  void Render();
+};
+
+#endif
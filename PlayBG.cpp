@@ -10,24 +10,36 @@
 
 #include "PlayBG.h"
 
+namespace {
+
+// Flag sprites by kind, largest stage value first
+const char* const FLAG_FILES[] = {"3.png", "2.png", "1.png"};
+const int FLAG_VALUES[] = {3, 2, 1};
+const float FLAG_WIDTH = 72.0f;
+
+}  // namespace
+
 // C26455: Fixing the warning 'noexcept' solution is to not include 'noexcept'
 // in the first place.
 //(https://docs.microsoft.com/en-us/cpp/code-quality/c26447?view=msvc-170)
 PlayBG::PlayBG() {
-  mTimer = Timer::Instance();
-  mAudio = AudioManager::Instance();
+  mTimer = FixedTimer::Instance();
+  mAudio = AudioThread::Instance();
+  mFlagSFX = mAudio->LoadSFX("StageSE.wav", 1, 1, 1);
+  mAnimations = Animations::Instance();
 
   // Background stage entities
-  // C26409: Fixing warning to replace 'new' requires editing included framework
-  // library 'QuickSDL"
-  mBackground = new Texture("bgAnimated.png");
-  mAnimatedBackground = new AnimatedTexture(
-      "bgAnimated.png", 0, 0, 960, 640, 10, 1.25f, AnimatedTexture::vertical);
-
-  mStage = new Texture("Stage.png");
+  mBackground = ObjectPool<Texture>::Create("bgAnimated.png");
+  mAnimatedBackground =
+      ObjectPool<Texture>::Create("bgAnimated.png", 0, 0, 960, 640);
+  mBackgroundClip = mAnimations->Add(mAnimatedBackground, 10, 1.25f,
+                                     AnimatedTexture::vertical);
+  mAnimations->Pause(mBackgroundClip, true);
+
+  mStage = ObjectPool<Texture>::Create("Stage.png");
   mStage->Pos(Vector2(480.0f, 450.0f));
 
-  mStatus = new Texture("Status.png");
+  mStatus = ObjectPool<Texture>::Create("Status.png");
   mStatus->Pos(Vector2(250.0f, 75.0f));
 
   mBackground->Parent(this);
@@ -38,123 +50,150 @@ PlayBG::PlayBG() {
   mAnimatedBackground->Pos(Vector2(Graphics::Instance()->SCREEN_WIDTH * 0.5f,
                                    Graphics::Instance()->SCREEN_HEIGHT * 0.5f));
 
-  mLives = new GameEntity();
+  mLives = ObjectPool<GameEntity>::Create();
   mLives->Parent(this);
   mLives->Pos(Vector2(110.0f, 90.0f));
 
   // Player lives
   for (int i = 0; i < MAX_MM_TEXTURES; i++) {
-    gsl::at(mLivesTextures, i) = new Texture("Life.png");
+    gsl::at(mLivesTextures, i) = ObjectPool<Texture>::Create("Life.png");
     gsl::at(mLivesTextures, i)->Parent(mLives);
     gsl::at(mLivesTextures, i)->Pos(Vector2(130.0f * (i % 3), 70.f * (i / 3)));
   }
 
-  mFlags = new GameEntity();
+  mFlags = ObjectPool<GameEntity>::Create();
   mFlags->Parent(this);
   mFlags->Pos(Vector2(350.0f, 100.0f));
 
-  mFlagTimer = 0.0f;
+  // Stage flags, moved to each slot they are drawn at
+  for (int i = 0; i < FLAG_KINDS; i++) {
+    gsl::at(mFlagSprites, i) =
+        ObjectPool<Texture>::Create(gsl::at(FLAG_FILES, i));
+    gsl::at(mFlagSprites, i)->Parent(mFlags);
+  }
+  mFlagCount = 0;
+
+  mScripts = new Scheduler();
   mFlagInterval = 0.5;
 }
 
 // C26432: deleting all would cause compiling error
 PlayBG::~PlayBG() {
+  delete mScripts;
+  mScripts = nullptr;
+
   mTimer = nullptr;
   mAudio = nullptr;
 
-  delete mBackground;
+  mAnimations->Remove(mBackgroundClip);
+  mAnimations = nullptr;
+
+  ObjectPool<Texture>::Destroy(mBackground);
   mBackground = nullptr;
 
-  delete mAnimatedBackground;
+  ObjectPool<Texture>::Destroy(mAnimatedBackground);
   mAnimatedBackground = nullptr;
 
-  delete mStage;
+  ObjectPool<Texture>::Destroy(mStage);
   mStage = nullptr;
 
-  delete mStatus;
+  ObjectPool<Texture>::Destroy(mStatus);
   mStatus = nullptr;
 
-  delete mLives;
+  ObjectPool<GameEntity>::Destroy(mLives);
   mLives = nullptr;
 
   for (int i = 0; i < MAX_MM_TEXTURES; i++) {
-    delete gsl::at(mLivesTextures, i);
+    ObjectPool<Texture>::Destroy(gsl::at(mLivesTextures, i));
     gsl::at(mLivesTextures, i) = nullptr;
   }
-  delete mFlags;
-  mFlags = nullptr;
-
-  ClearFlags();
-}
-
-void PlayBG::ClearFlags() noexcept {
-  for (unsigned int i = 0; i < mFlagTextures.size(); i++) {
-    delete gsl::at(mFlagTextures, i);
-    gsl::at(mFlagTextures, i) = nullptr;
+  for (int i = 0; i < FLAG_KINDS; i++) {
+    ObjectPool<Texture>::Destroy(gsl::at(mFlagSprites, i));
+    gsl::at(mFlagSprites, i) = nullptr;
   }
 
-  mFlagTextures.clear();
+  ObjectPool<GameEntity>::Destroy(mFlags);
+  mFlags = nullptr;
 }
 
+void PlayBG::ClearFlags() noexcept { mFlagCount = 0; }
+
 void PlayBG::AddNextFlag() {
   // Stage level flags
-  if (mRemainingLevels == 3)
-    AddFlag("3.png", 72.0f, 3);
-  else if (mRemainingLevels == 2)
-    AddFlag("2.png", 72.0f, 2);
-  else if (mRemainingLevels == 1)
-    AddFlag("1.png", 72.0f, 2);
+  int kind = 0;
+  while (gsl::at(FLAG_VALUES, kind) > mRemainingLevels) kind++;
+
+  AddFlag(kind);
 }
 
-void PlayBG::AddFlag(std::string filename, float width, int value) {
-  const int index = mFlagTextures.size();
+void PlayBG::AddFlag(int kind) noexcept {
+  // A full strip ends the flag sequence
+  if (mFlagCount == MAX_FLAGS) {
+    mRemainingLevels = 0;
+    return;
+  }
 
-  if (index > 0) mFlagXOffset += width * 0.5f;
+  if (mFlagCount > 0) mFlagXOffset += FLAG_WIDTH * 0.5f;
 
   // Location of stage flag
-  mRemainingLevels -= value;
-  mFlagTextures.push_back(new Texture(filename));
-  gsl::at(mFlagTextures, index)->Parent(mFlags);
-  gsl::at(mFlagTextures, index)->Pos(VEC2_RIGHT * mFlagXOffset);
-  mFlagXOffset += width * 0.5f;
+  mRemainingLevels -= gsl::at(FLAG_VALUES, kind);
+  gsl::at(mFlagSlots, mFlagCount) = {kind, mFlagXOffset};
+  mFlagCount++;
+  mFlagXOffset += FLAG_WIDTH * 0.5f;
 
-  mAudio->PlaySFX("StageSE.wav");
+  mAudio->PlaySFX(mFlagSFX);
 }
 void PlayBG::SetLives(int lives) noexcept { mTotalLives = lives; }
 
-void PlayBG::SetLevel(int level) noexcept {
+void PlayBG::SetLevel(int level) {
   ClearFlags();
 
   mRemainingLevels = level;
   mFlagXOffset = 0.0f;
+
+  // The background only animates during a level
+  mAnimations->Pause(mBackgroundClip, level == 0);
+
+  mScripts->Clear();
+  if (mRemainingLevels > 0) mScripts->Spawn(FlagSequence());
+}
+
+Scheduler::Task PlayBG::FlagSequence() {
+  while (mRemainingLevels > 0) {
+    co_await mScripts->Wait(mFlagInterval);
+    AddNextFlag();
+  }
+}
+
+void PlayBG::Hash(StateHash* hash) {
+  hash->Add("playbg.counters", mTotalLives);
+  hash->Add("playbg.counters", mRemainingLevels);
+  hash->Add("playbg.counters", mFlagCount);
+  hash->Add("playbg.counters", mFlagXOffset);
+  mScripts->Hash(hash, "playbg.scripts");
 }
 
 // C26433: Method is not a virtual function to use override.
 void PlayBG::Update() {
-  mAnimatedBackground->Update();
-
-  if (mRemainingLevels > 0) {
-    mFlagTimer += mTimer->DeltaTime();
-    if (mFlagTimer >= mFlagInterval) {
-      AddNextFlag();
-      mFlagTimer = 0.0f;
-    }
-  }
+  mScripts->Advance(mTimer->DeltaTime());
 }
 
 // C26433: Method is not a virtual function to use override.
 void PlayBG::Render() {
-  mBackground->Render();
-  mAnimatedBackground->Render();
+  RenderList::Draw(mBackground);
+  RenderList::Draw(mAnimatedBackground);
 
-  mStage->Render();
-  mStatus->Render();
+  RenderList::Draw(mStage);
+  RenderList::Draw(mStatus);
 
   for (int i = 0; i < MAX_MM_TEXTURES && i < mTotalLives; i++) {
-    gsl::at(mLivesTextures, i)->Render();
+    RenderList::Draw(gsl::at(mLivesTextures, i));
   }
 
-  for (unsigned int i = 0; i < mFlagTextures.size(); i++) {
-    gsl::at(mFlagTextures, i)->Render();
+  for (int i = 0; i < mFlagCount; i++) {
+    const FlagSlot& slot = gsl::at(mFlagSlots, i);
+    Texture* sprite = gsl::at(mFlagSprites, slot.kind);
+    sprite->Pos(VEC2_RIGHT * slot.offset);
+    RenderList::Draw(sprite);
   }
 }
\ No newline at end of file
@@ -11,12 +11,14 @@
 #ifndef _PLAYHEALTH_H
 #define _PLAYHEALTH_H
 #include <gsl/util>
-#include <vector>
 
-#include "AnimatedTexture.h"
-#include "AudioManager.h"
+#include "Animations.h"
+#include "AudioThread.h"
+#include "FixedTimer.h"
+#include "Scheduler.h"
+#include "SlabPool.h"
 #include "StartScreen.h"
-#include "Timer.h"
+#include "StateHash.h"
 
 /**
  * @brief The PlayBG class
@@ -33,14 +35,28 @@ class PlayBG : public GameEntity {
    * Used to keep track of time between resets.
    *
    */
-  Timer* mTimer;
+  FixedTimer* mTimer;
 
   /** @brief Audio variable
    *
    * Used to add audio for the game.
    *
    */
-  AudioManager* mAudio;
+  AudioThread* mAudio;
+
+  /** @brief Flag sound effect variable
+   *
+   * Handle of the sound played when a flag is set.
+   *
+   */
+  int mFlagSFX;
+
+  /** @brief Animations variable
+   *
+   * Used to play the background animation.
+   *
+   */
+  Animations* mAnimations;
 
   /** @brief Background texture
    *
@@ -51,10 +67,17 @@ class PlayBG : public GameEntity {
 
   /** @brief Animated background texture
    *
-   * Creating an animated background texture.
+   * Creating a sprite sheet background texture.
    *
    */
-  AnimatedTexture* mAnimatedBackground;
+  Texture* mAnimatedBackground;
+
+  /** @brief Background clip variable
+   *
+   * Handle of the background animation in the animation registry.
+   *
+   */
+  int mBackgroundClip;
 
   /** @brief Stage texture
    *
@@ -106,14 +129,50 @@ class PlayBG : public GameEntity {
    */
   GameEntity* mFlags;
 
-  // LO7 An iterator is an object that points to some element in a range of
-  // elements using specific operators, such as the dereference operator.
-  /** @brief Flag texture
+  /** @brief Flag kinds variable
+   *
+   * Number of flag sprites, one per stage value.
+   *
+   */
+  static const int FLAG_KINDS = 3;
+
+  /** @brief Max flags variable
    *
-   * Creating textures for stage flags.
+   * Number of flag slots on the status HUD.
    *
    */
-  std::vector<Texture*> mFlagTextures;
+  static const int MAX_FLAGS = 8;
+
+  /** @brief Flag slot struct
+   *
+   * Kind of flag a slot shows and where it sits on the flag strip.
+   *
+   */
+  struct FlagSlot {
+    int kind;
+    float offset;
+  };
+
+  /** @brief Flag sprites variable
+   *
+   * One texture per flag kind, drawn at every slot that shows that kind.
+   *
+   */
+  Texture* mFlagSprites[FLAG_KINDS];
+
+  /** @brief Flag slots variable
+   *
+   * Flags shown on the status HUD, in the order they were added.
+   *
+   */
+  FlagSlot mFlagSlots[MAX_FLAGS];
+
+  /** @brief Flag count variable
+   *
+   * Number of flag slots in use.
+   *
+   */
+  int mFlagCount;
 
   /** @brief Remaining levels variable
    *
@@ -130,16 +189,16 @@ class PlayBG : public GameEntity {
    */
   float mFlagXOffset = 0.0;
 
-  /** @brief Flag timer variable
+  /** @brief Scripts variable
    *
-   * Used to update flag using 'AddNextFlag' function.
+   * Runs the flag sequence.
    *
    */
-  float mFlagTimer;
+  Scheduler* mScripts;
 
   /** @brief Flag interval variable
    *
-   * Compares with flagtimer to decide to update flag.
+   * Time between two flags being added.
    *
    */
   float mFlagInterval;
@@ -147,7 +206,7 @@ class PlayBG : public GameEntity {
  private:
   /** @brief Clearing flags function
    *
-   * Deletes flag textures.
+   * Empties every flag slot.
    *
    *  @return void
    */
@@ -155,7 +214,7 @@ class PlayBG : public GameEntity {
 
   /** @brief Adding flag function
    *
-   * Used to add stage flag textures.
+   * Used to add the largest stage flag that fits the remaining levels.
    *
    *  @return void
    */
@@ -163,12 +222,21 @@ class PlayBG : public GameEntity {
 
   /** @brief Adding flag function
    *
-   * Sets position for setting flag and plays a SFX when flag is set.
+   * Puts a flag of 'kind' in the next slot and plays a SFX when flag is set.
+   * Once every slot is in use no more flags are added.
    *
-   *  @param filename, width, value
+   *  @param kind
    *  @return void
    */
-  void AddFlag(std::string filename, float width, int value);
+  void AddFlag(int kind) noexcept;
+
+  /** @brief Flag sequence script
+   *
+   * Adds the next flag every flag interval until every level has one.
+   *
+   *  @return Scheduler::Task
+   */
+  Scheduler::Task FlagSequence();
 
  public:
   /** @brief Constructor
@@ -197,12 +265,22 @@ class PlayBG : public GameEntity {
 
   /** @brief Setting level function
    *
-   * Sets the level by clearing all flags.
+   * Sets the level by clearing all flags, then adds a flag per level one at a
+   * time.
    *
    *  @param level
    *  @return void
    */
-  void SetLevel(int level) noexcept;
+  void SetLevel(int level);
+
+  /** @brief Hash function
+   *
+   * Adds lives, remaining flags and the flag script to the state hash.
+   *
+   *  @param hash
+   *  @return void
+   */
+  void Hash(StateHash* hash);
 
   /** @brief Update function
    *
@@ -8,40 +8,51 @@
  */
 #include "PlayScreen.h"
 
+#include "ScreenManager.h"
+
 // C26455: Fixing the warning 'noexcept' solution is to not include 'noexcept'
 // in the first place.
 //(https://docs.microsoft.com/en-us/cpp/code-quality/c26447?view=msvc-170)
 PlayScreen::PlayScreen() {
-  mTimer = Timer::Instance();
+  mTimer = FixedTimer::Instance();
   mInput = InputManager::Instance();
-  mAudio = AudioManager::Instance();
+  mAudio = AudioThread::Instance();
 
   // C26409: Fixing warning to replace 'new' requires editing included
   // framework library 'QuickSDL"
   mPlayBG = new PlayBG();
+  mParticles = new Particles();
 
   // Ready player texture
-  mStartLabel = new Texture("ARE YOU READY?", "BN6FontBold.ttf", 60, {0, 0, 0});
+  mStartLabel = ObjectPool<Texture>::Create("ARE YOU READY?", "BN6FontBold.ttf",
+                                            60, SDL_Color{0, 0, 0});
   mStartLabel->Parent(this);
   mStartLabel->Pos(Vector2(Graphics::Instance()->SCREEN_WIDTH * 0.5f,
                            Graphics::Instance()->SCREEN_HEIGHT * 0.3f));
 
+  mScripts = new Scheduler();
+
   mLevel = nullptr;
   mLevelStartDelay = 1.0f;
   mLevelStarted = false;
 
-  mPlayer = nullptr;
+  // Built once, every new game resets it in place
+  mPlayer = new Player(mParticles);
+  mPlayer->Parent(this);
 }
 
 // C26432: deleting all would cause compiling error
 PlayScreen::~PlayScreen() {
+  delete mScripts;
+  mScripts = nullptr;
+
   mTimer = nullptr;
   mInput = nullptr;
 
   delete mPlayBG;
   mPlayBG = nullptr;
 
-  delete mStartLabel;
+  ObjectPool<Texture>::Destroy(mStartLabel);
   mStartLabel = nullptr;
 
   delete mLevel;
@@ -49,31 +60,47 @@ PlayScreen::~PlayScreen() {
 
   delete mPlayer;
   mPlayer = nullptr;
+
+  delete mParticles;
+  mParticles = nullptr;
 }
 
 void PlayScreen::StartNextLevel() {
   mCurrentStage++;
-  mLevelStartTimer = 0.0f;
   mLevelStarted = true;
 
-  delete mLevel;
-  mLevel = new Level(mCurrentStage, mPlayBG, mPlayer);
+  // Built for the first stage, every later stage resets it in place
+  if (mLevel == nullptr)
+    ScreenManager::RunOnMainThread(BuildLevel, this);
+  else
+    mLevel->Reset(mCurrentStage);
+}
+
+void PlayScreen::BuildLevel(void* data) {
+  PlayScreen* screen = static_cast<PlayScreen*>(data);
+  screen->mLevel = new Level(screen->mCurrentStage, screen->mPlayBG,
+                             screen->mPlayer, screen->mParticles);
+}
+
+Scheduler::Task PlayScreen::NextLevelSequence() {
+  co_await mScripts->Wait(mLevelStartDelay);
+  StartNextLevel();
 }
 
 void PlayScreen::StartNewGame() {
-  delete mPlayer;
-  mPlayer = new Player();
-  mPlayer->Parent(this);
+  mScripts->Clear();
+
+  mPlayer->Reset();
   mPlayer->Pos(Vector2(Graphics::Instance()->SCREEN_WIDTH * 0.267f,
                        Graphics::Instance()->SCREEN_HEIGHT * 0.58f));
   mPlayer->Active(false);
 
   mPlayBG->SetLives(mPlayer->Lives());
   mPlayBG->SetLevel(0);
+  mParticles->Clear();
 
   mGameStarted = false;
   mLevelStarted = false;
-  mLevelStartTimer = 0.0f;
 
   mCurrentStage = 0;
 
@@ -89,32 +116,61 @@ bool PlayScreen::GameOver() noexcept {
   return (mLevel->State() == Level::gameover);
 }
 
+bool PlayScreen::Playing() noexcept {
+  return mGameStarted && mLevelStarted && mLevel->Playing();
+}
+
+void PlayScreen::OnAction(void* data, ActionMap::ACTIONS action) {
+  PlayScreen* screen = static_cast<PlayScreen*>(data);
+  if (!screen->mGameStarted) return;
+
+  if (screen->mLevelStarted) screen->mLevel->HandleAction(action);
+  screen->mPlayer->HandleAction(action);
+}
+
+void PlayScreen::MusicFinished() {
+  // The game starts once the intro music ends
+  if (mGameStarted) return;
+
+  mGameStarted = true;
+  mScripts->Spawn(NextLevelSequence());
+}
+
+void PlayScreen::Hash(StateHash* hash) {
+  hash->Add("playscreen.state", mCurrentStage);
+  hash->Add("playscreen.state", mGameStarted);
+  hash->Add("playscreen.state", mLevelStarted);
+  mScripts->Hash(hash, "playscreen.scripts");
+
+  mPlayer->Hash(hash);
+  if (mLevel != nullptr) mLevel->Hash(hash);
+  mPlayBG->Hash(hash);
+}
+
 // C26433: Method is not a virtual function to use override.
 void PlayScreen::Update() {
   if (mGameStarted) {
-    if (!mLevelStarted) {
-      mLevelStartTimer += mTimer->DeltaTime();
-      if (mLevelStartTimer >= mLevelStartDelay) StartNextLevel();
-    }
+    AllocationAudit::Tag("playscreen");
+    mScripts->Advance(mTimer->DeltaTime());
 
-  } else {
-    if (!Mix_PlayingMusic()) {
-      mGameStarted = true;
-    }
-  }
-
-  if (mGameStarted) {
+    AllocationAudit::Tag("playbg");
     if (mCurrentStage > 0) mPlayBG->Update();
 
     if (mLevelStarted) {
+      AllocationAudit::Tag("level");
       mLevel->Update();
 
       if (mLevel->State() == Level::finished) {
         mLevelStarted = false;
+        mScripts->Spawn(NextLevelSequence());
       }
     }
 
+    AllocationAudit::Tag("player");
     mPlayer->Update();
+
+    AllocationAudit::Tag("particles");
+    mParticles->Update();
   }
 }
 
@@ -122,11 +178,12 @@ void PlayScreen::Update() {
 void PlayScreen::Render() {
   mPlayBG->Render();
 
-  if (!mGameStarted) mStartLabel->Render();
+  if (!mGameStarted) RenderList::Draw(mStartLabel);
 
   if (mGameStarted) {
     if (mLevelStarted) mLevel->Render();
 
     mPlayer->Render();
+    mParticles->Render();
   }
 }
\ No newline at end of file
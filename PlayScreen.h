@@ -8,11 +8,15 @@
  */
 #ifndef _PLAYSCREEN_H
 #define _PLAYSCREEN_H
+#include "AllocationAudit.h"
 #include "InputManager.h"
 #include "Level.h"
 #include "PlayBG.h"
 #include "Player.h"
+#include "Scheduler.h"
+#include "SlabPool.h"
 #include "StartScreen.h"
+#include "StateHash.h"
 
 /**
  * @brief The PlayScreen class
@@ -29,7 +33,7 @@ class PlayScreen : public GameEntity {
    * Used to keep track of time between resets.
    *
    */
-  Timer* mTimer;
+  FixedTimer* mTimer;
 
   /** @brief Input variable
    *
@@ -43,7 +47,7 @@ class PlayScreen : public GameEntity {
    * Used to add audio for the game.
    *
    */
-  AudioManager* mAudio;
+  AudioThread* mAudio;
 
   /** @brief Playscreen background variable
    *
@@ -59,12 +63,12 @@ class PlayScreen : public GameEntity {
    */
   Texture* mStartLabel;
 
-  /** @brief Start level timer variable
+  /** @brief Scripts variable
    *
-   * Used to assist with delaying starting the level.
+   * Runs the sequence that starts the next level.
    *
    */
-  float mLevelStartTimer = 0.0;
+  Scheduler* mScripts;
 
   /** @brief Start delay variable
    *
@@ -108,6 +112,13 @@ class PlayScreen : public GameEntity {
    */
   Player* mPlayer;
 
+  /** @brief Particles variable
+   *
+   * Used for every particle effect in the level.
+   *
+   */
+  Particles* mParticles;
+
  private:
   /** @brief Starting next level function
    *
@@ -117,6 +128,24 @@ class PlayScreen : public GameEntity {
    */
   void StartNextLevel();
 
+  /** @brief Build level job
+   *
+   * Creates the level of the first stage, run on the main thread since it
+   * creates textures.
+   *
+   *  @param data
+   *  @return void
+   */
+  static void BuildLevel(void* data);
+
+  /** @brief Next level sequence script
+   *
+   * Starts the next level after the level start delay.
+   *
+   *  @return Scheduler::Task
+   */
+  Scheduler::Task NextLevelSequence();
+
  public:
   /** @brief Constructor
    *
@@ -148,6 +177,42 @@ class PlayScreen : public GameEntity {
    */
   bool GameOver() noexcept;
 
+  /** @brief Playing function
+   *
+   * Used to return true while a stage is being fought.
+   *
+   *  @return bool
+   */
+  bool Playing() noexcept;
+
+  /** @brief Action handler function
+   *
+   * Subscribed to the action map for the play screen. Passes actions to the
+   * level and the player once the game has started.
+   *
+   *  @param data, action
+   *  @return void
+   */
+  static void OnAction(void* data, ActionMap::ACTIONS action);
+
+  /** @brief Music finished function
+   *
+   * Called when the audio thread reports the music ended. Starts the game
+   * after the intro music.
+   *
+   *  @return void
+   */
+  void MusicFinished();
+
+  /** @brief Hash function
+   *
+   * Adds the screen state, player, level and background to the state hash.
+   *
+   *  @param hash
+   *  @return void
+   */
+  void Hash(StateHash* hash);
+
   /** @brief Update function
    *
    * Used to update the screen into the playscreen after selecting new game.
@@ -11,21 +11,18 @@
 // C26455: Fixing the warning 'noexcept' solution is to not include 'noexcept'
 // in the first place.
 //(https://docs.microsoft.com/en-us/cpp/code-quality/c26447?view=msvc-170)
-Player::Player() {
-  mTimer = Timer::Instance();
-  mInput = InputManager::Instance();
-  mAudio = AudioManager::Instance();
-
-  mVisible = false;
-  mAnimating = false;
-
-  mScore = 0;
-  mLives = 2;
+Player::Player(Particles* particles) {
+  mTimer = FixedTimer::Instance();
+  mAudio = AudioThread::Instance();
+  mFireSFX = mAudio->LoadSFX("fire.wav", 0, 2, 1);
+  mDeathSFX = mAudio->LoadSFX("death.wav", 2, 1, 1);
+  mAnimations = Animations::Instance();
+  mParticles = particles;
 
   // Player entity
   // C26409: Fixing warning to replace 'new' requires editing included
   // framework library 'QuickSDL"
-  mMan = new Texture("megaman.png");
+  mMan = ObjectPool<Texture>::Create("megaman.png");
   mMan->Parent(this);
   mMan->Pos(VEC2_ZERO);
 
@@ -35,37 +32,45 @@ Player::Player() {
   mMoveBounds2 = Vector2(277.0f, 471.0f);
 
   // Movement transition entity
-  mMoveLeave = new AnimatedTexture("transition.png", 0, 0, 175, 262, 4, 0.2f,
-                                   AnimatedTexture::horizontal);
+  mMoveLeave = ObjectPool<Texture>::Create("transition.png", 0, 0, 175, 262);
   mMoveLeave->Parent(this);
   mMoveLeave->Pos(VEC2_ZERO);
-  mMoveLeave->WrapMode(AnimatedTexture::once);
+  mMoveLeaveClip = mAnimations->Add(mMoveLeave, 4, 0.2f,
+                                    AnimatedTexture::horizontal,
+                                    AnimatedTexture::once);
 
   // Player death entity
-  mDeathAnimation = new AnimatedTexture("mmDeath.png", 0, 0, 237, 217, 1, 2.0f,
-                                        AnimatedTexture::horizontal);
+  mDeathAnimation = ObjectPool<Texture>::Create("mmDeath.png", 0, 0, 237, 217);
   mDeathAnimation->Parent(this);
   mDeathAnimation->Pos(VEC2_ZERO);
-  mDeathAnimation->WrapMode(AnimatedTexture::once);
+  mDeathClip = mAnimations->Add(mDeathAnimation, 1, 2.0f,
+                                AnimatedTexture::horizontal,
+                                AnimatedTexture::once);
 
   for (int i = 0; i < MAX_BULLETS; i++) {
     gsl::at(mBullets, i) = new Bullet();
   }
+
+  Reset();
 }
 
 // C26432: deleting all would cause compiling error
 Player::~Player() {
   mTimer = nullptr;
-  mInput = nullptr;
   mAudio = nullptr;
+  mParticles = nullptr;
+
+  mAnimations->Remove(mMoveLeaveClip);
+  mAnimations->Remove(mDeathClip);
+  mAnimations = nullptr;
 
-  delete mMan;
+  ObjectPool<Texture>::Destroy(mMan);
   mMan = nullptr;
 
-  delete mMoveLeave;
+  ObjectPool<Texture>::Destroy(mMoveLeave);
   mMoveLeave = nullptr;
 
-  delete mDeathAnimation;
+  ObjectPool<Texture>::Destroy(mDeathAnimation);
   mDeathAnimation = nullptr;
 
   for (int i = 0; i < MAX_BULLETS; i++) {
@@ -74,30 +79,35 @@ Player::~Player() {
   }
 }
 
-void Player::HandleMovement() {
-  // Player Movement
-  if (mInput->KeyPressed(SDL_SCANCODE_RIGHT)) {
-    mMoveLeave->ResetAnimation();
-    mLeaveMoving = true;
+void* Player::operator new(std::size_t size) {
+  return ObjectPool<Player>::Allocate(size);
+}
 
-    Translate(VEC2_RIGHT * 157, world);
+void Player::operator delete(void* object) noexcept {
+  ObjectPool<Player>::Free(object);
+}
 
-  } else if (mInput->KeyPressed(SDL_SCANCODE_LEFT)) {
-    mMoveLeave->ResetAnimation();
-    mLeaveMoving = true;
-    Translate(-VEC2_RIGHT * 157, world);
-  }
+void Player::Reset() {
+  mVisible = false;
+  mAnimating = false;
+  mLeaveMoving = true;
+
+  mScore = 0;
+  mLives = 2;
 
-  if (mInput->KeyPressed(SDL_SCANCODE_UP)) {
-    mMoveLeave->ResetAnimation();
-    mLeaveMoving = true;
-    Translate(-VEC2_UP * 100, world);
+  // Clips start over the way they were added
+  mAnimations->Reset(mMoveLeaveClip);
+  mAnimations->Reset(mDeathClip);
+  mAnimations->Pause(mDeathClip, true);
 
-  } else if (mInput->KeyPressed(SDL_SCANCODE_DOWN)) {
-    mMoveLeave->ResetAnimation();
-    mLeaveMoving = true;
-    Translate(VEC2_UP * 100, world);
-  }
+  for (int i = 0; i < MAX_BULLETS; i++) gsl::at(mBullets, i)->Reload();
+}
+
+void Player::HandleMovement(Vector2 move) {
+  // Player Movement
+  mAnimations->Reset(mMoveLeaveClip);
+  mLeaveMoving = true;
+  Translate(move, world);
 
   // Player movement bound area
   Vector2 pos = Pos(local);
@@ -116,17 +126,47 @@ void Player::HandleMovement() {
 
 void Player::HandleFiring() {
   // Player firing
-  if (mInput->KeyPressed(SDL_SCANCODE_SPACE)) {
-    for (int i = 0; i < MAX_BULLETS; i++) {
-      if (!gsl::at(mBullets, i)->Active()) {
-        gsl::at(mBullets, i)->Fire(Pos());
-        mAudio->PlaySFX("fire.wav");
-        break;
-      }
+  for (int i = 0; i < MAX_BULLETS; i++) {
+    if (!gsl::at(mBullets, i)->Active()) {
+      gsl::at(mBullets, i)->Fire(Pos());
+      mParticles->MuzzleFlash(Pos());
+      mAudio->PlaySFX(mFireSFX);
+      break;
     }
   }
 }
 
+void Player::HandleAction(ActionMap::ACTIONS action) {
+  if (mAnimating || !Active()) return;
+
+  // C26812: Changing 'enum' to 'enum class' would cause compilation
+  // error, making all types into undeclared identifiers
+  switch (action) {
+    case ActionMap::right:
+      HandleMovement(VEC2_RIGHT * 157);
+      break;
+
+    case ActionMap::left:
+      HandleMovement(-VEC2_RIGHT * 157);
+      break;
+
+    case ActionMap::up:
+      HandleMovement(-VEC2_UP * 100);
+      break;
+
+    case ActionMap::down:
+      HandleMovement(VEC2_UP * 100);
+      break;
+
+    case ActionMap::fire:
+      HandleFiring();
+      break;
+
+    default:
+      break;
+  }
+}
+
 void Player::Visible(bool visible) noexcept { mVisible = visible; }
 
 bool Player::IsAnimating() noexcept { return mAnimating; }
@@ -137,31 +177,37 @@ int Player::Lives() noexcept { return mLives; }
 
 void Player::AddScore(int change) noexcept { mScore += change; }
 
+int Player::BulletCount() noexcept { return MAX_BULLETS; }
+
+Bullet* Player::Bullets(int index) { return gsl::at(mBullets, index); }
+
 void Player::WasHit() {
   // Player hit
   mLives--;
-  mDeathAnimation->ResetAnimation();
+  mAnimations->Reset(mDeathClip);
   mAnimating = true;
-  mAudio->PlaySFX("death.wav");
+  mParticles->HitSpark(Pos());
+  if (mLives <= 0) mParticles->DeletionBurst(Pos());
+  mAudio->PlaySFX(mDeathSFX);
+}
+
+void Player::Hash(StateHash* hash) {
+  hash->Add("player.pos", Pos(local));
+  hash->Add("player.lives", mLives);
+  hash->Add("player.score", mScore);
+  hash->Add("player.state", Active());
+  hash->Add("player.state", mVisible);
+  hash->Add("player.state", mAnimating);
+  hash->Add("player.state", mLeaveMoving);
+
+  for (int i = 0; i < MAX_BULLETS; i++) gsl::at(mBullets, i)->Hash(hash);
 }
 
 // C26433: Method is not a virtual function to use override.
 void Player::Update() {
-  if (mLeaveMoving) {
-    mMoveLeave->Update();
-    mLeaveMoving = mMoveLeave->IsAnimating();
-  }
-
-  if (mAnimating) {
-    mDeathAnimation->Update();
-    mAnimating = mDeathAnimation->IsAnimating();
+  if (mLeaveMoving) mLeaveMoving = mAnimations->Animating(mMoveLeaveClip);
 
-  } else {
-    if (Active()) {
-      HandleMovement();
-      HandleFiring();
-    }
-  }
+  if (mAnimating) mAnimating = mAnimations->Animating(mDeathClip);
 
   for (int i = 0; i < MAX_BULLETS; i++) gsl::at(mBullets, i)->Update();
 }
@@ -170,11 +216,11 @@ void Player::Update() {
 void Player::Render() {
   if (mVisible) {
     if (mAnimating) {
-      mDeathAnimation->Render();
+      RenderList::Draw(mDeathAnimation);
     } else if (mLeaveMoving) {
-      mMoveLeave->Render();
+      RenderList::Draw(mMoveLeave);
     } else {
-      mMan->Render();
+      RenderList::Draw(mMan);
     }
   }
   for (int i = 0; i < MAX_BULLETS; i++) gsl::at(mBullets, i)->Render();
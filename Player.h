@@ -10,10 +10,13 @@
 #define _PLAYER_H
 #include <gsl/util>
 
-#include "AnimatedTexture.h"
-#include "AudioManager.h"
+#include "ActionMap.h"
+#include "Animations.h"
+#include "AudioThread.h"
 #include "Bullet.h"
-#include "InputManager.h"
+#include "Particles.h"
+#include "SlabPool.h"
+#include "StateHash.h"
 
 using namespace QuickSDL;
 
@@ -32,21 +35,36 @@ class Player : public GameEntity {
    * Used to keep track of time between resets.
    *
    */
-  Timer* mTimer;
+  FixedTimer* mTimer;
 
-  /** @brief Input variable
+  /** @brief Audio variable
    *
-   * Used to handle keyboard inputs.
+   * Used to add audio for the game.
    *
    */
-  InputManager* mInput;
+  AudioThread* mAudio;
 
-  /** @brief Audio variable
+  /** @brief Sound effect variables
    *
-   * Used to add audio for the game.
+   * Handles of the firing and death sounds.
+   *
+   */
+  int mFireSFX;
+  int mDeathSFX;
+
+  /** @brief Animations variable
+   *
+   * Used to play the leaving and death animations.
    *
    */
-  AudioManager* mAudio;
+  Animations* mAnimations;
+
+  /** @brief Particles variable
+   *
+   * Used for muzzle flashes and hit sparks.
+   *
+   */
+  Particles* mParticles;
 
   /** @brief Visible variable
    *
@@ -85,10 +103,17 @@ class Player : public GameEntity {
 
   /** @brief Movement leaving animation texture
    *
-   * An animated texture used for whenever megaman leaves a tile.
+   * A sprite sheet texture used for whenever megaman leaves a tile.
    *
    */
-  AnimatedTexture* mMoveLeave;
+  Texture* mMoveLeave;
+
+  /** @brief Movement leaving clip variable
+   *
+   * Handle of the leaving animation in the animation registry.
+   *
+   */
+  int mMoveLeaveClip;
 
   /** @brief Leave movement variable
    *
@@ -102,7 +127,14 @@ class Player : public GameEntity {
    * Animates player dying animation when damaged.
    *
    */
-  AnimatedTexture* mDeathAnimation;
+  Texture* mDeathAnimation;
+
+  /** @brief Death clip variable
+   *
+   * Handle of the death animation in the animation registry.
+   *
+   */
+  int mDeathClip;
 
   /** @brief Movement speed variable
    *
@@ -142,15 +174,16 @@ class Player : public GameEntity {
  private:
   /** @brief Movement function
    *
-   * Handles players input for movement.
+   * Moves the player one panel and keeps them inside their area.
    *
+   *  @param move
    *  @return void
    */
-  void HandleMovement();
+  void HandleMovement(Vector2 move);
 
   /** @brief Handle firing function
    *
-   * Handles players input for firing bullets.
+   * Fires the first bullet that is not already on screen.
    *
    *  @return void
    */
@@ -162,8 +195,9 @@ class Player : public GameEntity {
    * Creating textures for the player as well as handling lives and player
    * bullets.
    *
+   *  @param particles
    */
-  Player();
+  Player(Particles* particles);
 
   /** @brief Deconstructor
    *
@@ -172,6 +206,42 @@ class Player : public GameEntity {
    */
   virtual ~Player();
 
+  /** @brief New operator
+   *
+   * Takes the player's memory from its slab pool.
+   *
+   *  @param size
+   *  @return void*
+   */
+  static void* operator new(std::size_t size);
+
+  /** @brief Delete operator
+   *
+   * Gives the player's memory back to its slab pool.
+   *
+   *  @param object
+   *  @return void
+   */
+  static void operator delete(void* object) noexcept;
+
+  /** @brief Reset function
+   *
+   * Puts lives, score, bullets and animations back to the start of a game.
+   * Textures and animation clips are kept.
+   *
+   *  @return void
+   */
+  void Reset();
+
+  /** @brief Handle action function
+   *
+   * Moves or fires for an action while the player is alive and active.
+   *
+   *  @param action
+   *  @return void
+   */
+  void HandleAction(ActionMap::ACTIONS action);
+
   /** @brief Visible function
    *
    * Used to check if visible for rendering textures.
@@ -214,6 +284,23 @@ class Player : public GameEntity {
    */
   void AddScore(int change) noexcept;
 
+  /** @brief Bullet count function
+   *
+   * Used to return the number of player bullets.
+   *
+   *  @return int
+   */
+  int BulletCount() noexcept;
+
+  /** @brief Bullets function
+   *
+   * Used to return a player bullet for collision checks.
+   *
+   *  @param index
+   *  @return Bullet*
+   */
+  Bullet* Bullets(int index);
+
   /** @brief Hit function
    *
    * Plays the hit animation for when the player gets damaged.
@@ -222,6 +309,16 @@ class Player : public GameEntity {
    */
   void WasHit();
 
+  /** @brief Hash function
+   *
+   * Adds position, lives, score, animation state and bullets to the state
+   * hash.
+   *
+   *  @param hash
+   *  @return void
+   */
+  void Hash(StateHash* hash);
+
   /** @brief Update function
    *
    * Updates player firing and movement textures.
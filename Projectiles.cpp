@@ -0,0 +1,163 @@
+/** @file Projectiles.cpp
+ *  @brief Source file for virus projectiles
+ *
+ * This program is responsible for handling every projectile fired by viruses.
+ * Projectiles live in preallocated packed arrays and are moved in one pass per
+ * frame.
+ *
+ *  @author Michael Martinez
+ *  @bug No known bugs.
+ */
+#include "Projectiles.h"
+
+#include <cmath>
+
+// C26455: Fixing the warning 'noexcept' solution is to not include 'noexcept'
+// in the first place.
+//(https://docs.microsoft.com/en-us/cpp/code-quality/c26447?view=msvc-170)
+Projectiles::Projectiles(int capacity) {
+  mTimer = FixedTimer::Instance();
+
+  // Projectile entity
+  mTexture = ObjectPool<Texture>::Create("bullet.png");
+  mTexture->Parent(this);
+
+  mTurnRate = 4.0f;
+  mTarget = VEC2_ZERO;
+
+  mCapacity = capacity;
+  mCount = 0;
+
+  // Projectile slots are only allocated here, never while playing
+  mX.resize(mCapacity);
+  mY.resize(mCapacity);
+  mVelX.resize(mCapacity);
+  mVelY.resize(mCapacity);
+  mSpeed.resize(mCapacity);
+  mFlags.resize(mCapacity);
+}
+
+// C26432: deleting all would cause compiling error
+Projectiles::~Projectiles() {
+  mTimer = nullptr;
+
+  ObjectPool<Texture>::Destroy(mTexture);
+  mTexture = nullptr;
+}
+
+int Projectiles::Spawn(float x, float y, float angle, float speed,
+                       int flags) noexcept {
+  if (mCount >= mCapacity) return -1;
+
+  const int slot = mCount++;
+  mX[slot] = x;
+  mY[slot] = y;
+  mVelX[slot] = std::cos(angle) * speed;
+  mVelY[slot] = std::sin(angle) * speed;
+  mSpeed[slot] = speed;
+  mFlags[slot] = flags;
+
+  return slot;
+}
+
+void Projectiles::Kill(int slot) noexcept {
+  if (slot < 0 || slot >= mCount) return;
+
+  // Keep live projectiles packed by moving the last one into the freed slot
+  const int last = --mCount;
+  mX[slot] = mX[last];
+  mY[slot] = mY[last];
+  mVelX[slot] = mVelX[last];
+  mVelY[slot] = mVelY[last];
+  mSpeed[slot] = mSpeed[last];
+  mFlags[slot] = mFlags[last];
+}
+
+void Projectiles::Clear() noexcept { mCount = 0; }
+
+int Projectiles::Count() noexcept { return mCount; }
+
+void Projectiles::Target(Vector2 target) noexcept { mTarget = target; }
+
+bool Projectiles::HitTest(Vector2 pos, float radius) noexcept {
+  const float radiusSqr = radius * radius;
+
+  for (int i = 0; i < mCount; i++) {
+    const float dx = mX[i] - pos.x;
+    const float dy = mY[i] - pos.y;
+    if (dx * dx + dy * dy <= radiusSqr) {
+      Kill(i);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void Projectiles::Simulate(float deltaTime) noexcept {
+  const float minX = static_cast<float>(-OFFSCREEN_BUFFER);
+  const float minY = static_cast<float>(-OFFSCREEN_BUFFER);
+  const float maxX =
+      static_cast<float>(Graphics::Instance()->SCREEN_WIDTH + OFFSCREEN_BUFFER);
+  const float maxY = static_cast<float>(Graphics::Instance()->SCREEN_HEIGHT +
+                                        OFFSCREEN_BUFFER);
+
+  int i = 0;
+  while (i < mCount) {
+    // Homing projectiles turn towards the target at a fixed speed
+    if (mFlags[i] & homing) {
+      const float dx = mTarget.x - mX[i];
+      const float dy = mTarget.y - mY[i];
+      const float distance = std::sqrt(dx * dx + dy * dy);
+      if (distance > 0.0f) {
+        const float steer = mSpeed[i] * mTurnRate * deltaTime / distance;
+        mVelX[i] += dx * steer;
+        mVelY[i] += dy * steer;
+
+        // A shot with no velocity left heads straight for the target
+        const float speed =
+            std::sqrt(mVelX[i] * mVelX[i] + mVelY[i] * mVelY[i]);
+        if (speed > 0.0f) {
+          mVelX[i] *= mSpeed[i] / speed;
+          mVelY[i] *= mSpeed[i] / speed;
+        } else {
+          mVelX[i] = dx * mSpeed[i] / distance;
+          mVelY[i] = dy * mSpeed[i] / distance;
+        }
+      }
+    }
+
+    mX[i] += mVelX[i] * deltaTime;
+    mY[i] += mVelY[i] * deltaTime;
+
+    // A removed slot is refilled by the last projectile, so check it again
+    if (mX[i] < minX || mX[i] > maxX || mY[i] < minY || mY[i] > maxY)
+      Kill(i);
+    else
+      i++;
+  }
+}
+
+void Projectiles::Hash(StateHash* hash) {
+  hash->Add("projectiles", mCount);
+  hash->Add("projectiles", mX.data(), mCount * sizeof(float));
+  hash->Add("projectiles", mY.data(), mCount * sizeof(float));
+  hash->Add("projectiles", mVelX.data(), mCount * sizeof(float));
+  hash->Add("projectiles", mVelY.data(), mCount * sizeof(float));
+  hash->Add("projectiles", mSpeed.data(), mCount * sizeof(float));
+  hash->Add("projectiles", mFlags.data(), mCount * sizeof(int));
+}
+
+// C26433: Method is not a virtual function to use override.
+void Projectiles::Update() { Simulate(mTimer->DeltaTime()); }
+
+// C26433: Method is not a virtual function to use override.
+void Projectiles::Render() {
+  // Drawn back along their paths by the time not yet simulated
+  const float lag = (1.0f - mTimer->Alpha()) * mTimer->DeltaTime();
+
+  for (int i = 0; i < mCount; i++) {
+    mTexture->Pos(Vector2(mX[i] - mVelX[i] * lag, mY[i] - mVelY[i] * lag));
+    RenderList::Draw(mTexture);
+  }
+}
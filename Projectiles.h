@@ -0,0 +1,212 @@
+/** @file Projectiles.h
+ *  @brief Header file for virus projectiles
+ *
+ * This program is responsible for handling every projectile fired by viruses.
+ * Projectiles live in preallocated packed arrays and are moved in one pass per
+ * frame.
+ *
+ *  @author Michael Martinez
+ *  @bug No known bugs.
+ */
+#ifndef _PROJECTILES_H
+#define _PROJECTILES_H
+#include <vector>
+
+#include "FixedTimer.h"
+#include "RenderList.h"
+#include "SlabPool.h"
+#include "StateHash.h"
+#include "Texture.h"
+
+using namespace QuickSDL;
+
+/**
+ * @brief The Projectiles class
+ * @author Michael Martinez
+ *
+ * Projectiles class inheriting from GameEntity which is used to move, cull and
+ * render a pool of projectiles.
+ *
+ */
+class Projectiles : public GameEntity {
+ public:
+  /** @brief enum for projectile flags
+   *
+   * Bits describing how a projectile moves.
+   *
+   */
+  enum PROJECTILE_FLAGS { homing = 1 };
+
+  /** @brief Default capacity variable
+   *
+   * Number of projectile slots for a normal stage.
+   *
+   */
+  static const int DEFAULT_CAPACITY = 128;
+
+ private:
+  /** @brief Timer variable
+   *
+   * Used to keep track of time between resets.
+   *
+   */
+  FixedTimer* mTimer;
+
+  /** @brief Offscreen buffer variable
+   *
+   * Distance outside the screen before a projectile is removed.
+   *
+   */
+  const int OFFSCREEN_BUFFER = 10;
+
+  /** @brief Projectile texture
+   *
+   * Shared texture moved to every projectile before rendering.
+   *
+   */
+  Texture* mTexture;
+
+  /** @brief Homing turn rate variable
+   *
+   * How quickly homing projectiles steer towards the target.
+   *
+   */
+  float mTurnRate;
+
+  /** @brief Target variable
+   *
+   * Position homing projectiles steer towards.
+   *
+   */
+  Vector2 mTarget;
+
+  /** @brief Capacity variable
+   *
+   * Number of preallocated projectile slots.
+   *
+   */
+  int mCapacity;
+
+  /** @brief Count variable
+   *
+   * Number of live projectiles. Live projectiles fill slots 0 to mCount - 1.
+   *
+   */
+  int mCount;
+
+  /** @brief Packed projectile state
+   *
+   * One array per field, indexed by slot.
+   *
+   */
+  std::vector<float> mX;
+  std::vector<float> mY;
+  std::vector<float> mVelX;
+  std::vector<float> mVelY;
+  std::vector<float> mSpeed;
+  std::vector<int> mFlags;
+
+ public:
+  /** @brief Constructor
+   *
+   * Creates the projectile texture and preallocates every slot.
+   *
+   *  @param capacity
+   */
+  Projectiles(int capacity = DEFAULT_CAPACITY);
+
+  /** @brief Deconstructor
+   *
+   * Freeing all entities
+   *
+   */
+  virtual ~Projectiles();
+
+  /** @brief Spawn function
+   *
+   * Takes the next free slot for a new projectile.
+   *
+   *  @param x, y, angle, speed, flags
+   *  @return int slot, or -1 if every slot is taken
+   */
+  int Spawn(float x, float y, float angle, float speed, int flags) noexcept;
+
+  /** @brief Kill function
+   *
+   * Frees a slot by moving the last live projectile into it.
+   *
+   *  @param slot
+   *  @return void
+   */
+  void Kill(int slot) noexcept;
+
+  /** @brief Clear function
+   *
+   * Frees every slot.
+   *
+   *  @return void
+   */
+  void Clear() noexcept;
+
+  /** @brief Count function
+   *
+   * Used to return the number of live projectiles.
+   *
+   *  @return int
+   */
+  int Count() noexcept;
+
+  /** @brief Target function
+   *
+   * Sets the position homing projectiles steer towards.
+   *
+   *  @param target
+   *  @return void
+   */
+  void Target(Vector2 target) noexcept;
+
+  /** @brief Hit test function
+   *
+   * Removes the first projectile within a radius of a position.
+   *
+   *  @param pos, radius
+   *  @return bool true if a projectile was removed
+   */
+  bool HitTest(Vector2 pos, float radius) noexcept;
+
+  /** @brief Simulate function
+   *
+   * Moves every live projectile and removes the ones that left the screen.
+   *
+   *  @param deltaTime
+   *  @return void
+   */
+  void Simulate(float deltaTime) noexcept;
+
+  /** @brief Hash function
+   *
+   * Adds every live projectile to the state hash.
+   *
+   *  @param hash
+   *  @return void
+   */
+  void Hash(StateHash* hash);
+
+  /** @brief Update function
+   *
+   * Simulates every projectile with the frame's delta time.
+   *
+   *  @return void
+   */
+  void Update();
+
+  /** @brief Render function
+   *
+   * Renders all projectiles between the last two simulation steps.
+   *
+   *  @return void
+   */
+  void Render();
+};
+
+#endif
@@ -0,0 +1,31 @@
+/** @file RenderBuffers.cpp
+ *  @brief Source file for render list buffering
+ *
+ * This program is responsible for handing finished render lists from the
+ * simulation thread to the render thread without locks.
+ *
+ *  @author Michael Martinez
+ *  @bug No known bugs.
+ */
+#include "RenderBuffers.h"
+
+// C26455: Fixing the warning 'noexcept' solution is to not include 'noexcept'
+// in the first place.
+//(https://docs.microsoft.com/en-us/cpp/code-quality/c26447?view=msvc-170)
+RenderBuffers::RenderBuffers() {
+  mBack = 0;
+  mReady = 1;
+  mFront = 2;
+}
+
+RenderList& RenderBuffers::Back() noexcept { return mLists[mBack]; }
+
+void RenderBuffers::Publish() noexcept {
+  mBack = mReady.exchange(mBack | FRESH) & ~FRESH;
+}
+
+RenderList& RenderBuffers::Front() noexcept {
+  if (mReady.load() & FRESH) mFront = mReady.exchange(mFront) & ~FRESH;
+
+  return mLists[mFront];
+}
@@ -0,0 +1,104 @@
+/** @file RenderBuffers.h
+ *  @brief Header file for render list buffering
+ *
+ * This program is responsible for handing finished render lists from the
+ * simulation thread to the render thread without locks.
+ *
+ *  @author Michael Martinez
+ *  @bug No known bugs.
+ */
+#ifndef _RENDERBUFFERS_H
+#define _RENDERBUFFERS_H
+#include <atomic>
+
+#include "RenderList.h"
+
+/**
+ * @brief The RenderBuffers class
+ * @author Michael Martinez
+ *
+ * RenderBuffers class which is used to swap render lists between one writer
+ * and one reader. The writer records into the back list, the reader draws the
+ * front list and the third list holds the newest finished frame, so neither
+ * side ever waits on the other.
+ *
+ */
+class RenderBuffers {
+ private:
+  /** @brief Buffers variable
+   *
+   * Number of render lists being swapped.
+   *
+   */
+  static const int BUFFERS = 3;
+
+  /** @brief Fresh flag variable
+   *
+   * Set in 'mReady' while the ready list has not been drawn yet.
+   *
+   */
+  static const int FRESH = 4;
+
+  /** @brief Lists variable
+   *
+   * Storage for every render list.
+   *
+   */
+  RenderList mLists[BUFFERS];
+
+  /** @brief Back index variable
+   *
+   * List being recorded. Only touched by the writer.
+   *
+   */
+  int mBack;
+
+  /** @brief Front index variable
+   *
+   * List being drawn. Only touched by the reader.
+   *
+   */
+  int mFront;
+
+  /** @brief Ready variable
+   *
+   * Index of the newest finished list, plus 'FRESH' until it is taken.
+   *
+   */
+  std::atomic<int> mReady;
+
+ public:
+  /** @brief Constructor
+   *
+   * Creates three empty render lists.
+   *
+   */
+  RenderBuffers();
+
+  /** @brief Back function
+   *
+   * Used to return the list the writer records into.
+   *
+   *  @return RenderList&
+   */
+  RenderList& Back() noexcept;
+
+  /** @brief Publish function
+   *
+   * Swaps the finished back list with the ready list.
+   *
+   *  @return void
+   */
+  void Publish() noexcept;
+
+  /** @brief Front function
+   *
+   * Swaps in the newest finished list if there is one and returns it. The
+   * same list is returned again until a newer one is published.
+   *
+   *  @return RenderList&
+   */
+  RenderList& Front() noexcept;
+};
+
+#endif
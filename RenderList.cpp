@@ -0,0 +1,99 @@
+/** @file RenderList.cpp
+ *  @brief Source file for render lists
+ *
+ * This program is responsible for recording the draws of one frame into a
+ * flat list and replaying them later, possibly on another thread.
+ *
+ *  @author Michael Martinez
+ *  @bug No known bugs.
+ */
+#include "RenderList.h"
+
+#include "TextureState.h"
+
+// List the current thread records into; draws render right away without one
+thread_local RenderList* tRecording = nullptr;
+
+RenderList::RenderList(int capacity) { mCommands.reserve(capacity); }
+
+void RenderList::Draw(Texture* texture, Uint8 alpha) {
+  if (tRecording != nullptr) {
+    tRecording->Add(texture, VEC2_ZERO, alpha);
+    return;
+  }
+
+  SDL_Texture* handle = texture->*TextureState::Handle();
+  if (alpha != 255) SDL_SetTextureAlphaMod(handle, alpha);
+  texture->Render();
+  if (alpha != 255) SDL_SetTextureAlphaMod(handle, 255);
+}
+
+void RenderList::Draw(Texture* texture, Vector2 offset, Uint8 alpha) {
+  if (tRecording != nullptr) {
+    tRecording->Add(texture, offset, alpha);
+    return;
+  }
+
+  // Walked in full, the cache only starts a frame when a list begins
+  const Transforms::World world = {texture->Pos(), texture->Scale(),
+                                   texture->Rotation()};
+  Command command = Capture(texture, world, offset, alpha);
+  Submit(command);
+}
+
+void RenderList::Begin() {
+  mCommands.clear();
+  tRecording = this;
+
+  // Parents may have moved since the last recording
+  Transforms::Instance()->NextFrame();
+}
+
+void RenderList::End() noexcept {
+  if (tRecording == this) tRecording = nullptr;
+}
+
+void RenderList::Add(Texture* texture, Vector2 offset, Uint8 alpha) {
+  // Taken now instead of at draw time
+  mCommands.push_back(
+      Capture(texture, Transforms::Instance()->Get(texture), offset, alpha));
+}
+
+int RenderList::Count() noexcept { return mCommands.size(); }
+
+void RenderList::Execute() {
+  for (Command& command : mCommands) Submit(command);
+}
+
+RenderList::Command RenderList::Capture(Texture* texture,
+                                        const Transforms::World& world,
+                                        Vector2 offset, Uint8 alpha) {
+  const Vector2 pos = world.pos + offset;
+  const Vector2 scale = world.scale;
+  const int width = texture->*TextureState::Width();
+  const int height = texture->*TextureState::Height();
+
+  Command command;
+  command.texture = texture->*TextureState::Handle();
+  command.clip = texture->*TextureState::Clip();
+  command.dest.x = static_cast<int>(pos.x - width * scale.x * 0.5f);
+  command.dest.y = static_cast<int>(pos.y - height * scale.y * 0.5f);
+  command.dest.w = static_cast<int>(width * scale.x);
+  command.dest.h = static_cast<int>(height * scale.y);
+  command.angle = world.rotation;
+  command.alpha = alpha;
+  command.clipped = texture->*TextureState::Clipped();
+
+  return command;
+}
+
+void RenderList::Submit(Command& command) {
+  if (command.alpha != 255)
+    SDL_SetTextureAlphaMod(command.texture, command.alpha);
+
+  Graphics::Instance()->DrawTexture(command.texture,
+                                    command.clipped ? &command.clip : nullptr,
+                                    &command.dest, command.angle);
+
+  if (command.alpha != 255) SDL_SetTextureAlphaMod(command.texture, 255);
+}
@@ -0,0 +1,155 @@
+/** @file RenderList.h
+ *  @brief Header file for render lists
+ *
+ * This program is responsible for recording the draws of one frame into a
+ * flat list and replaying them later, possibly on another thread.
+ *
+ *  @author Michael Martinez
+ *  @bug No known bugs.
+ */
+#ifndef _RENDERLIST_H
+#define _RENDERLIST_H
+#include <vector>
+
+#include "Texture.h"
+#include "Transforms.h"
+
+using namespace QuickSDL;
+
+/**
+ * @brief The RenderList class
+ * @author Michael Martinez
+ *
+ * RenderList class which is used to hold an immutable snapshot of a frame.
+ * Every command keeps the SDL texture, rectangles and angle a texture had when
+ * it was recorded, so the game may keep changing while the list is drawn.
+ *
+ */
+class RenderList {
+ public:
+  /** @brief Command struct
+   *
+   * One recorded texture draw. 'alpha' below 255 fades the draw.
+   *
+   */
+  struct Command {
+    SDL_Texture* texture;
+    SDL_Rect clip;
+    SDL_Rect dest;
+    float angle;
+    Uint8 alpha;
+    bool clipped;
+  };
+
+  /** @brief Default capacity variable
+   *
+   * Number of commands reserved up front, enough for a full particle pool.
+   *
+   */
+  static const int DEFAULT_CAPACITY = 8192;
+
+ private:
+  /** @brief Commands variable
+   *
+   * Draws in the order they were recorded.
+   *
+   */
+  std::vector<Command> mCommands;
+
+ public:
+  /** @brief Constructor
+   *
+   * Creates an empty list with room for 'capacity' commands.
+   *
+   *  @param capacity
+   */
+  RenderList(int capacity = DEFAULT_CAPACITY);
+
+  /** @brief Draw function
+   *
+   * Records a texture into the list the current thread is recording, or
+   * renders it right away if there is none.
+   *
+   *  @param texture, alpha
+   *  @return void
+   */
+  static void Draw(Texture* texture, Uint8 alpha = 255);
+
+  /** @brief Offset draw function
+   *
+   * Same as the other 'Draw', with the texture moved by 'offset' in world
+   * space for this draw only. Used to place a texture between two simulation
+   * steps without moving it.
+   *
+   *  @param texture, offset, alpha
+   *  @return void
+   */
+  static void Draw(Texture* texture, Vector2 offset, Uint8 alpha = 255);
+
+  /** @brief Begin function
+   *
+   * Clears the list and makes it the target of 'Draw' on this thread. Starts
+   * a new frame of cached world transforms.
+   *
+   *  @return void
+   */
+  void Begin();
+
+  /** @brief End function
+   *
+   * Stops recording on this thread.
+   *
+   *  @return void
+   */
+  void End() noexcept;
+
+  /** @brief Add function
+   *
+   * Records the current state of a texture, moved by 'offset' in world
+   * space, at the end of the list.
+   *
+   *  @param texture, offset, alpha
+   *  @return void
+   */
+  void Add(Texture* texture, Vector2 offset, Uint8 alpha);
+
+  /** @brief Count function
+   *
+   * Used to return the number of recorded commands.
+   *
+   *  @return int
+   */
+  int Count() noexcept;
+
+  /** @brief Execute function
+   *
+   * Draws every command in order. Only called from the thread that owns the
+   * renderer.
+   *
+   *  @return void
+   */
+  void Execute();
+
+ private:
+  /** @brief Capture function
+   *
+   * Used to return the command drawing a texture with the given world
+   * transform, the same rectangle 'Texture::Render' builds.
+   *
+   *  @param texture, world, offset, alpha
+   *  @return Command
+   */
+  static Command Capture(Texture* texture, const Transforms::World& world,
+                         Vector2 offset, Uint8 alpha);
+
+  /** @brief Submit function
+   *
+   * Draws one command.
+   *
+   *  @param command
+   *  @return void
+   */
+  static void Submit(Command& command);
+};
+
+#endif
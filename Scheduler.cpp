@@ -0,0 +1,195 @@
+/** @file Scheduler.cpp
+ *  @brief Source file for the script scheduler
+ *
+ * This program is responsible for running scripted sequences written as
+ * coroutines. A sequence that waits sleeps in a timer queue and costs nothing
+ * until it is due.
+ *
+ *  @author Michael Martinez
+ *  @bug No known bugs.
+ */
+#include "Scheduler.h"
+
+#include <algorithm>
+#include <memory>
+#include <new>
+
+#include "SlabPool.h"
+
+namespace {
+
+// Frames are pooled in steps of 'FRAME_STEP' bytes, bigger ones use new
+const std::size_t FRAME_STEP = 64;
+const std::size_t FRAME_CLASSES = 16;
+
+SlabPool* FramePool(std::size_t size) {
+  const std::size_t index = (size - 1) / FRAME_STEP;
+  if (index >= FRAME_CLASSES) return nullptr;
+
+  static std::unique_ptr<SlabPool> pools[FRAME_CLASSES];
+  if (pools[index] == nullptr) {
+    pools[index] = std::make_unique<SlabPool>("Scheduler::Task frame",
+                                              (index + 1) * FRAME_STEP);
+  }
+  return pools[index].get();
+}
+
+}  // namespace
+
+void* Scheduler::Task::promise_type::operator new(std::size_t size) {
+  SlabPool* pool = FramePool(size);
+  if (pool == nullptr) return ::operator new(size);
+  return pool->Allocate();
+}
+
+void Scheduler::Task::promise_type::operator delete(void* frame,
+                                                    std::size_t size) noexcept {
+  SlabPool* pool = FramePool(size);
+  if (pool == nullptr)
+    ::operator delete(frame);
+  else
+    pool->Free(frame);
+}
+
+Scheduler::Task::Task(std::coroutine_handle<promise_type> handle) noexcept {
+  mHandle = handle;
+}
+
+Scheduler::Task::Task(Task&& other) noexcept {
+  mHandle = other.mHandle;
+  other.mHandle = nullptr;
+}
+
+// C26432: deleting all would cause compiling error
+Scheduler::Task::~Task() {
+  if (mHandle) mHandle.destroy();
+}
+
+std::coroutine_handle<> Scheduler::Task::Release() noexcept {
+  std::coroutine_handle<> handle = mHandle;
+  mHandle = nullptr;
+  return handle;
+}
+
+Scheduler::Scheduler() noexcept {
+  mTime = 0.0;
+  mOrder = 0;
+  mResuming = 0;
+  mClears = 0;
+}
+
+// C26432: deleting all would cause compiling error
+Scheduler::~Scheduler() { Clear(); }
+
+bool Scheduler::Later(const Entry& a, const Entry& b) noexcept {
+  if (a.time != b.time) return a.time > b.time;
+  return a.order > b.order;
+}
+
+void Scheduler::Schedule(std::coroutine_handle<> handle, float delay) {
+  const Entry entry = {mTime + delay, mOrder++, handle};
+  mQueue.push_back(entry);
+  std::push_heap(mQueue.begin(), mQueue.end(), Later);
+}
+
+void Scheduler::Resume(std::coroutine_handle<> handle) {
+  handle.resume();
+  if (!handle.done()) return;
+
+  handle.destroy();
+
+  // A script that cleared the scheduler finishes among the cleared ones
+  std::vector<std::coroutine_handle<>>& tasks =
+      std::find(mTasks.begin(), mTasks.end(), handle) != mTasks.end()
+          ? mTasks
+          : mCleared;
+  std::vector<std::coroutine_handle<>>::iterator task =
+      std::find(tasks.begin(), tasks.end(), handle);
+  *task = tasks.back();
+  tasks.pop_back();
+}
+
+void Scheduler::DestroyCleared() noexcept {
+  if (mCleared.empty()) return;
+
+  for (std::coroutine_handle<> handle : mCleared) handle.destroy();
+
+  // The script that cleared may have gone back to sleep after
+  mQueue.erase(std::remove_if(mQueue.begin(), mQueue.end(),
+                              [this](const Entry& entry) {
+                                return std::find(mCleared.begin(),
+                                                 mCleared.end(), entry.handle) !=
+                                       mCleared.end();
+                              }),
+               mQueue.end());
+  std::make_heap(mQueue.begin(), mQueue.end(), Later);
+
+  mCleared.clear();
+}
+
+void Scheduler::Spawn(Task task) {
+  std::coroutine_handle<> handle = task.Release();
+  mTasks.push_back(handle);
+
+  mResuming++;
+  Resume(handle);
+  mResuming--;
+  if (mResuming == 0) DestroyCleared();
+}
+
+Scheduler::Sleep Scheduler::Wait(float seconds) noexcept {
+  return Sleep{this, seconds};
+}
+
+Scheduler::Sleep Scheduler::NextStep() noexcept { return Wait(0.0f); }
+
+void Scheduler::Advance(float deltaTime) {
+  mTime += deltaTime;
+
+  // Scripts put back to sleep while resuming wait for the next advance
+  std::vector<std::coroutine_handle<>> due;
+  due.swap(mDue);
+  due.clear();
+  while (!mQueue.empty() && mQueue.front().time <= mTime) {
+    std::pop_heap(mQueue.begin(), mQueue.end(), Later);
+    due.push_back(mQueue.back().handle);
+    mQueue.pop_back();
+  }
+
+  // A script clearing the scheduler cannot destroy its own frame while it runs
+  const unsigned int clears = mClears;
+  mResuming++;
+  for (std::coroutine_handle<> handle : due) {
+    if (mClears != clears) break;
+    Resume(handle);
+  }
+  mResuming--;
+
+  due.swap(mDue);
+  if (mResuming == 0) DestroyCleared();
+}
+
+void Scheduler::Clear() {
+  // Destroyed later while scripts run, so nothing spawned after is lost
+  if (mResuming > 0) {
+    mCleared.insert(mCleared.end(), mTasks.begin(), mTasks.end());
+  } else {
+    for (std::coroutine_handle<> handle : mTasks) handle.destroy();
+  }
+
+  mTasks.clear();
+  mQueue.clear();
+  mDue.clear();
+
+  mTime = 0.0;
+  mOrder = 0;
+  mClears++;
+}
+
+int Scheduler::Count() noexcept { return mTasks.size(); }
+
+void Scheduler::Hash(StateHash* hash, const char* field) {
+  hash->Add(field, mTime);
+  hash->Add(field, Count());
+  for (const Entry& entry : mQueue) hash->Add(field, entry.time);
+}
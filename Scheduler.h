@@ -0,0 +1,308 @@
+/** @file Scheduler.h
+ *  @brief Header file for the script scheduler
+ *
+ * This program is responsible for running scripted sequences written as
+ * coroutines. A sequence that waits sleeps in a timer queue and costs nothing
+ * until it is due.
+ *
+ *  @author Michael Martinez
+ *  @bug No known bugs.
+ */
+#ifndef _SCHEDULER_H
+#define _SCHEDULER_H
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <vector>
+
+#include "StateHash.h"
+
+/**
+ * @brief The Scheduler class
+ * @author Michael Martinez
+ *
+ * Scheduler class which is used to own and resume script coroutines. Scripts
+ * are member functions returning 'Scheduler::Task' that 'co_await' the
+ * scheduler's 'Wait' between steps. Deleting the scheduler destroys every
+ * script that has not finished.
+ *
+ */
+class Scheduler {
+ public:
+  /**
+   * @brief The Task class
+   * @author Michael Martinez
+   *
+   * Task class which is used as the return type of a script coroutine. The
+   * script does not start until it is given to 'Spawn'.
+   *
+   */
+  class Task {
+   public:
+    /** @brief Promise type
+     *
+     * Coroutine promise. Scripts start suspended and stay suspended at the end
+     * so the scheduler can destroy them. Frames come from slab pools by size,
+     * so spawning a script stops touching the global allocator once the pools
+     * have grown.
+     *
+     */
+    struct promise_type {
+      Task get_return_object() noexcept {
+        return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+      }
+      std::suspend_always initial_suspend() noexcept { return {}; }
+      std::suspend_always final_suspend() noexcept { return {}; }
+      void return_void() noexcept {}
+      void unhandled_exception() noexcept { std::terminate(); }
+      static void* operator new(std::size_t size);
+      static void operator delete(void* frame, std::size_t size) noexcept;
+    };
+
+   private:
+    /** @brief Handle variable
+     *
+     * Coroutine frame, or null once handed to a scheduler.
+     *
+     */
+    std::coroutine_handle<promise_type> mHandle;
+
+   public:
+    /** @brief Constructor
+     *
+     * Takes ownership of a coroutine frame.
+     *
+     *  @param handle
+     */
+    explicit Task(std::coroutine_handle<promise_type> handle) noexcept;
+
+    /** @brief Move constructor
+     *
+     * Takes the coroutine frame from another task.
+     *
+     *  @param other
+     */
+    Task(Task&& other) noexcept;
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    /** @brief Deconstructor
+     *
+     * Destroys the coroutine frame if it was never spawned.
+     *
+     */
+    ~Task();
+
+    /** @brief Release function
+     *
+     * Gives up ownership of the coroutine frame.
+     *
+     *  @return std::coroutine_handle<>
+     */
+    std::coroutine_handle<> Release() noexcept;
+  };
+
+  /** @brief Sleep struct
+   *
+   * Awaitable returned by 'Wait'. Suspends the script and queues it to resume
+   * once 'delay' seconds have been advanced.
+   *
+   */
+  struct Sleep {
+    Scheduler* scheduler;
+    float delay;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle) {
+      scheduler->Schedule(handle, delay);
+    }
+    void await_resume() const noexcept {}
+  };
+
+ private:
+  /** @brief Entry struct
+   *
+   * One sleeping script. 'order' keeps scripts due at the same time in the
+   * order they went to sleep.
+   *
+   */
+  struct Entry {
+    double time;
+    long long order;
+    std::coroutine_handle<> handle;
+  };
+
+  /** @brief Time variable
+   *
+   * Seconds advanced since the scheduler was created or cleared.
+   *
+   */
+  double mTime;
+
+  /** @brief Order variable
+   *
+   * Number of scripts put to sleep so far.
+   *
+   */
+  long long mOrder;
+
+  /** @brief Queue variable
+   *
+   * Sleeping scripts as a binary heap with the next one due on top.
+   *
+   */
+  std::vector<Entry> mQueue;
+
+  /** @brief Due variable
+   *
+   * Buffer for the scripts resumed by 'Advance', kept between calls so it
+   * does not allocate.
+   *
+   */
+  std::vector<std::coroutine_handle<>> mDue;
+
+  /** @brief Resuming variables
+   *
+   * Number of 'Advance' and 'Spawn' calls running scripts, and of clears so
+   * far to tell when one happened while they ran.
+   *
+   */
+  int mResuming;
+  unsigned int mClears;
+
+  /** @brief Cleared variable
+   *
+   * Scripts a 'Clear' took away while scripts were running, destroyed once
+   * they return since one of them may be the script that cleared.
+   *
+   */
+  std::vector<std::coroutine_handle<>> mCleared;
+
+  /** @brief Tasks variable
+   *
+   * Every script that has started and not finished.
+   *
+   */
+  std::vector<std::coroutine_handle<>> mTasks;
+
+ private:
+  /** @brief Later function
+   *
+   * Heap order, true if 'a' is due after 'b'.
+   *
+   *  @param a, b
+   *  @return bool
+   */
+  static bool Later(const Entry& a, const Entry& b) noexcept;
+
+  /** @brief Schedule function
+   *
+   * Queues a suspended script to resume after 'delay' seconds.
+   *
+   *  @param handle, delay
+   *  @return void
+   */
+  void Schedule(std::coroutine_handle<> handle, float delay);
+
+  /** @brief Resume function
+   *
+   * Runs a script until it waits again, destroying it if it finished.
+   *
+   *  @param handle
+   *  @return void
+   */
+  void Resume(std::coroutine_handle<> handle);
+
+  /** @brief Destroy cleared function
+   *
+   * Destroys the scripts a 'Clear' took away while scripts were running,
+   * with any wait they went back to.
+   *
+   *  @return void
+   */
+  void DestroyCleared() noexcept;
+
+ public:
+  /** @brief Constructor
+   *
+   * Creates a scheduler with no scripts.
+   *
+   */
+  Scheduler() noexcept;
+
+  /** @brief Deconstructor
+   *
+   * Destroys every script that has not finished.
+   *
+   */
+  ~Scheduler();
+
+  /** @brief Spawn function
+   *
+   * Starts a script right away. It runs until its first wait.
+   *
+   *  @param task
+   *  @return void
+   */
+  void Spawn(Task task);
+
+  /** @brief Wait function
+   *
+   * Used to return an awaitable that sleeps for 'seconds'.
+   *
+   *  @param seconds
+   *  @return Sleep
+   */
+  Sleep Wait(float seconds) noexcept;
+
+  /** @brief Next step function
+   *
+   * Used to return an awaitable that sleeps until the next 'Advance'.
+   *
+   *  @return Sleep
+   */
+  Sleep NextStep() noexcept;
+
+  /** @brief Advance function
+   *
+   * Moves time forward and resumes every script that is due, in the order
+   * they are due.
+   *
+   *  @param deltaTime
+   *  @return void
+   */
+  void Advance(float deltaTime);
+
+  /** @brief Clear function
+   *
+   * Destroys every script and starts time over, so a cleared scheduler runs
+   * scripts just like a new one. Called from one of the scheduler's own
+   * scripts, no other cleared script is resumed and the cleared ones are
+   * destroyed once that script waits or finishes. Scripts spawned after the
+   * clear keep running.
+   *
+   *  @return void
+   */
+  void Clear();
+
+  /** @brief Hash function
+   *
+   * Adds the scheduler's time and every sleeping script's wake up time to a
+   * field of the state hash.
+   *
+   *  @param hash, field
+   *  @return void
+   */
+  void Hash(StateHash* hash, const char* field);
+
+  /** @brief Count function
+   *
+   * Used to return the number of scripts that have not finished.
+   *
+   *  @return int
+   */
+  int Count() noexcept;
+};
+
+#endif
@@ -4,16 +4,22 @@
  * This program is responsible handling all screen types for the game.
  *
  *  @author Michael Martinez
- *  @bug Title selection screen movement is being triggered throughout all the
- * screen types when it should only be affected within the start screen. This
- * causes the menu selection to be incorrect sometimes.
+ *  @bug No known bugs.
  */
 #include "ScreenManager.h"
 
+#include <chrono>
+#include <cstdio>
+
+#include "Benchmark.h"
+
 // Responsible for handling all screens for game (Title screen, Control Screen,
 // Play Screen)
 ScreenManager* ScreenManager::sInstance = nullptr;
 
+// Set on the simulation thread, whose jobs are run by the main thread
+thread_local bool tSimulating = false;
+
 ScreenManager* ScreenManager::Instance() {
   // C26409: Fixing warning to replace 'new' requires editing included
   // framework library 'QuickSDL"
@@ -31,45 +37,336 @@ void ScreenManager::Release() noexcept {
 // in the first place.
 //(https://docs.microsoft.com/en-us/cpp/code-quality/c26447?view=msvc-170)
 ScreenManager::ScreenManager() {
-  mInput = InputManager::Instance();
+  // Created first so every thread started below is audited
+  mAudit = AllocationAudit::Instance();
+  AllocationAudit::Tag("startup");
 
-  mStartScreen = new StartScreen();
-  mPlayScreen = new PlayScreen();
-  mControls = new Controls();
+  mInput = InputLatch::Instance();
+  mInput->Watching(true);
+  mTimer = Timer::Instance();
+  mClock = FixedTimer::Instance();
+  mSteps = 0;
+  mAnimations = Animations::Instance();
+  mHash = StateHash::Instance();
+  mAudio = AudioThread::Instance();
+  mArena = FrameArena::Instance();
+
+  // Other screens are made when they are first needed
+  mStartScreen = nullptr;
+  mPlayScreen = nullptr;
+  mControls = nullptr;
+  mChanging = start;
+  mUnloadDelay = UNLOAD_DELAY;
+  mCursorMode = 0;
+  mCursorTime = 0.0f;
+  mLoads = 0;
+  mPreloads = 0;
+  mUnloads = 0;
+  mPeakResident = 0;
 
   // C26812: Changing 'enum' to 'enum class' would cause compilation
   // error, making all types into undeclared identifiers
   mCurrentScreen = start;
+  Load(start);
+
+  // Each screen only hears actions while it is the current screen
+  mActions = ActionMap::Instance();
+  mActions->Subscribe(start, StartScreen::OnAction, mStartScreen);
+  mActions->Subscribe(start, StartAction, this);
+  mActions->Subscribe(play, PlayAction, this);
+  mActions->Subscribe(controls, ControlsAction, this);
+
+  mEnterScreen = -1;
+  for (int i = 0; i < TOTAL_SCREENS; i++) {
+    mIdle[i] = 0.0f;
+    mEnterTime[i] = 0.0;
+    mEnterWorst[i] = 0.0f;
+    mEnters[i] = 0;
+    mColdEnters[i] = 0;
+  }
+
+  mBuffers = new RenderBuffers();
+  mPipelined = false;
+  mStep = waiting;
+  mJob = nullptr;
+  mJobData = nullptr;
+
+#ifdef BENCHMARK
+  Benchmark::RunAll();
+#endif
+
+#ifdef PIPELINED
+  Pipelined(true);
+#endif
+
+#ifdef ALLOCATION_AUDIT_STRICT
+  mAudit->Strict(true);
+#endif
+
+#ifdef STATE_HASH
+  // A reference log is optional, without one steps are only logged
+  mHash->Log("statehash.log");
+  mHash->Reference("statehash_reference.log");
+#endif
 }
 
 // C26432: deleting all would cause compiling error
 ScreenManager::~ScreenManager() {
+  Pipelined(false);
+
+#ifdef BENCHMARK
+  std::printf("Input latency: p50 %.2f ms, p99 %.2f ms\n",
+              mInput->Latency(50.0f), mInput->Latency(99.0f));
+  std::printf("Action dispatch: %.2f us per step\n",
+              mActions->AverageDispatchTime());
+  const char* const names[] = {"Start screen", "New game", "Controls"};
+  for (int i = 0; i < TOTAL_SCREENS; i++) {
+    if (mEnters[i] == 0) continue;
+    std::printf("%s: %.2f ms average, %.2f ms worst from Enter to the first "
+                "frame, %d of %d loaded on Enter\n",
+                names[i], mEnterTime[i] / mEnters[i], mEnterWorst[i],
+                mColdEnters[i], mEnters[i]);
+  }
+  std::printf("Screens: %d loaded, %d of them preloaded, %d unloaded, %zu KB "
+              "resident, %zu KB at most after a load\n",
+              mLoads, mPreloads, mUnloads, Benchmark::ResidentMemory() / 1024,
+              mPeakResident / 1024);
+  std::printf("Sound effects: %lld played, %lld stolen, %lld skipped, %d "
+              "limited, %d of %d voices at peak, %.0f%% mixer load\n",
+              mAudio->Played(), mAudio->Stolen(), mAudio->Skipped(),
+              mAudio->Limited(), mAudio->PeakVoices(), mAudio->TotalVoices(),
+              mAudio->MixerLoad() * 100.0f);
+  if (mAudio->Mixer()->VoicesPerMs() > 0.0f) {
+    std::printf("Software mixer: %.0f voices mixed per ms of callback time\n",
+                mAudio->Mixer()->VoicesPerMs());
+  }
+
+  MusicStream* music = mAudio->Music();
+  if (music->FirstSample() >= 0.0f) {
+    std::printf("Music: %zu KB streamed in place of %lld KB decoded, first "
+                "sample after %.2f ms, %d underruns\n",
+                MusicStream::ResidentBytes() / 1024,
+                music->DecodedBytes() / 1024, music->FirstSample(),
+                music->Underruns());
+  }
+  std::printf("Frame arena: %zu KB held\n", mArena->Capacity() / 1024);
+  SlabPool::Report();
+#endif
+
+#ifdef ALLOCATION_AUDIT
+  mAudit->Summary();
+#endif
+
+#ifdef STATE_HASH
+  if (mHash->Divergence() < 0)
+    std::printf("State hash: %d steps, no divergence\n", mHash->Steps());
+#endif
+
   mInput = nullptr;
+  mActions = nullptr;
+  mAnimations = nullptr;
+  mHash = nullptr;
+  mAudio = nullptr;
+  mArena = nullptr;
+  mAudit = nullptr;
+  mTimer = nullptr;
+  mClock = nullptr;
 
   delete mStartScreen;
   mStartScreen = nullptr;
 
   delete mPlayScreen;
   mPlayScreen = nullptr;
+
+  delete mControls;
+  mControls = nullptr;
+
+  delete mBuffers;
+  mBuffers = nullptr;
+
+  AudioThread::Release();
+  FrameArena::Release();
+  StateHash::Release();
+  Transforms::Release();
+  Animations::Release();
+  ActionMap::Release();
+  InputLatch::Release();
+  FixedTimer::Release();
+  JobSystem::Release();
+  AllocationAudit::Release();
 }
 
 void ScreenManager::Update() {
-  if (mInput->KeyPressed(SDL_SCANCODE_DOWN) ||
-      mInput->KeyPressed(SDL_SCANCODE_UP))
-    mode *= -1;
+  AllocationAudit::Tag("screens");
+  AllocationAudit::Phase(AllocationAudit::update);
+
+  if (mPipelined) {
+    // The simulation thread is done reading input once its frame finishes
+    WaitForStep();
+    mSteps = mClock->Advance(mTimer->DeltaTime());
+    mInput->Latch();
+    mStep = stepping;
+    mStep.notify_all();
+    return;
+  }
+
+  mSteps = mClock->Advance(mTimer->DeltaTime());
+  mInput->Latch();
+  Step();
+}
+
+void ScreenManager::Render() {
+  if (mPipelined) {
+    AllocationAudit::Tag("render");
+    AllocationAudit::Phase(AllocationAudit::render);
+    mBuffers->Front().Execute();
+    return;
+  }
+
+  RenderList& list = mBuffers->Back();
+  Record(list);
+
+  AllocationAudit::Tag("render");
+  AllocationAudit::Phase(AllocationAudit::render);
+  list.Execute();
+
+  mAudio->NextFrame();
+  mArena->Reset();
+  mAudit->EndFrame();
+}
+
+void ScreenManager::Pipelined(bool pipelined) {
+  if (pipelined == mPipelined) return;
+
+  if (pipelined) {
+    // Publish the current frame so the first pipelined render has one
+    Record(mBuffers->Back());
+    mBuffers->Publish();
+
+    mStep = waiting;
+    mSimulation = std::thread(&ScreenManager::SimulationLoop, this);
+  } else {
+    WaitForStep();
+    mStep = stopping;
+    mStep.notify_all();
+    mSimulation.join();
+    mStep = waiting;
+  }
 
+  mPipelined = pipelined;
+}
+
+bool ScreenManager::Pipelined() noexcept { return mPipelined; }
+
+void ScreenManager::UnloadDelay(float seconds) noexcept {
+  mUnloadDelay = seconds;
+}
+
+void ScreenManager::RunOnMainThread(void (*job)(void*), void* data) {
+  if (!tSimulating) {
+    job(data);
+    return;
+  }
+
+  // The main thread picks the job up once it waits for this frame
+  sInstance->mJob = job;
+  sInstance->mJobData = data;
+  sInstance->mStep = loading;
+  sInstance->mStep.notify_all();
+  sInstance->mStep.wait(loading);
+}
+
+void ScreenManager::SimulationLoop() {
+  tSimulating = true;
+
+  while (true) {
+    mStep.wait(waiting);
+    if (mStep == stopping) break;
+
+    Step();
+    Record(mBuffers->Back());
+    mBuffers->Publish();
+
+    mAudio->NextFrame();
+
+    // The frame arena belongs to whichever thread simulates
+    mArena->Reset();
+    mAudit->EndFrame();
+    mStep = waiting;
+    mStep.notify_all();
+  }
+}
+
+void ScreenManager::Step() {
+  for (int i = 0; i < mSteps; i++) {
+    Simulate();
+    mInput->Clear();
+  }
+}
+
+void ScreenManager::WaitForStep() noexcept {
+  while (true) {
+    const int step = mStep;
+    if (step == loading) {
+      mJob(mJobData);
+      mStep = stepping;
+      mStep.notify_all();
+    } else if (step == stepping) {
+      mStep.wait(stepping);
+    } else {
+      return;
+    }
+  }
+}
+
+void ScreenManager::StartAction(void* data, ActionMap::ACTIONS action) {
+  ScreenManager* manager = static_cast<ScreenManager*>(data);
+  if (action != ActionMap::confirm) return;
+
+  // Switch screens by hitting enter
+  const SCREENS screen =
+      manager->mStartScreen->SelectedMode() == 0 ? play : controls;
+  if (manager->Load(screen)) manager->mColdEnters[screen]++;
+  manager->mCurrentScreen = screen;
+  if (screen == play) manager->mPlayScreen->StartNewGame();
+
+  manager->mEnterPress = manager->mActions->PressTime(action);
+  manager->mEnterScreen = screen;
+}
+
+void ScreenManager::PlayAction(void* data, ActionMap::ACTIONS action) {
+  ScreenManager* manager = static_cast<ScreenManager*>(data);
+  PlayScreen::OnAction(manager->mPlayScreen, action);
+}
+
+void ScreenManager::ControlsAction(void* data, ActionMap::ACTIONS action) {
+  ScreenManager* manager = static_cast<ScreenManager*>(data);
+  if (action == ActionMap::confirm) manager->mCurrentScreen = start;
+}
+
+void ScreenManager::Simulate() {
+  // Steps that start and end in the middle of a stage must not allocate
+  const bool steady = mCurrentScreen == play && mPlayScreen->Playing();
+  AllocationAudit::Phase(AllocationAudit::simulate);
+
+  AllocationAudit::Tag("actions");
+  mActions->Context(mCurrentScreen);
+  mActions->Dispatch();
+
+  AllocationAudit::Tag("audio");
+  AudioQueue::Message event;
+  while (mAudio->PollEvent(event)) {
+    // C26812: Changing 'enum' to 'enum class' would cause compilation
+    // error, making all types into undeclared identifiers
+    if (event.type == AudioQueue::musicFinished && mPlayScreen != nullptr)
+      mPlayScreen->MusicFinished();
+  }
+
+  AllocationAudit::Tag("screens");
   switch (mCurrentScreen) {
     case start:
 
       mStartScreen->Update();
-
-      // Switch screens by hitting enter
-      if (mInput->KeyPressed(SDL_SCANCODE_RETURN) && mode == -1) {
-        mCurrentScreen = controls;
-      } else if (mInput->KeyPressed(SDL_SCANCODE_RETURN) && mode == 1) {
-        mCurrentScreen = play;
-        mPlayScreen->StartNewGame();
-      }
       break;
 
     case play:
@@ -83,12 +380,34 @@ void ScreenManager::Update() {
     case controls:
 
       mControls->Update();
-      if (mInput->KeyPressed(SDL_SCANCODE_RETURN)) mCurrentScreen = start;
+      break;
+
+    default:
+
       break;
   }
+
+  ManageScreens(mClock->DeltaTime());
+
+  AllocationAudit::Tag("animations");
+  mAnimations->Update();
+
+  AllocationAudit::Tag("statehash");
+  if (mHash->Enabled()) {
+    mHash->Begin();
+    mHash->Add("screen", static_cast<int>(mCurrentScreen));
+    if (mCurrentScreen == play) mPlayScreen->Hash(mHash);
+    mHash->End();
+  }
+
+  mAudit->EndStep(steady && mCurrentScreen == play && mPlayScreen->Playing());
 }
 
-void ScreenManager::Render() {
+void ScreenManager::Record(RenderList& list) {
+  AllocationAudit::Tag("record");
+  AllocationAudit::Phase(AllocationAudit::record);
+  list.Begin();
+
   switch (mCurrentScreen) {
     case start:
 
@@ -105,5 +424,146 @@ void ScreenManager::Render() {
 
       mControls->Render();
       break;
+
+    default:
+
+      break;
+  }
+
+  list.End();
+
+  if (mEnterScreen >= 0 && mEnterScreen == mCurrentScreen) {
+    const float latency = std::chrono::duration<float, std::milli>(
+                              InputQueue::Clock::now() - mEnterPress)
+                              .count();
+    mEnterTime[mEnterScreen] += latency;
+    if (latency > mEnterWorst[mEnterScreen])
+      mEnterWorst[mEnterScreen] = latency;
+    mEnters[mEnterScreen]++;
+    mEnterScreen = -1;
+  }
+}
+
+bool ScreenManager::Load(SCREENS screen) {
+  if (Loaded(screen)) return false;
+
+  mChanging = screen;
+  RunOnMainThread(CreateScreen, this);
+  if (!Loaded(screen)) return false;
+
+  mIdle[screen] = 0.0f;
+  mLoads++;
+  const std::size_t resident = Benchmark::ResidentMemory();
+  if (resident > mPeakResident) mPeakResident = resident;
+  return true;
+}
+
+void ScreenManager::Unload(SCREENS screen) {
+  // The start screen is never unloaded
+  if (screen == start || !Loaded(screen)) return;
+
+  mChanging = screen;
+  RunOnMainThread(DeleteScreen, this);
+
+  // Slots of the destroyed entities may be reused at the same addresses
+  Transforms::Instance()->Clear();
+  mUnloads++;
+}
+
+bool ScreenManager::Loaded(SCREENS screen) noexcept {
+  switch (screen) {
+    case start:
+
+      return mStartScreen != nullptr;
+
+    case play:
+
+      return mPlayScreen != nullptr;
+
+    case controls:
+
+      return mControls != nullptr;
+
+    default:
+
+      return false;
+  }
+}
+
+void ScreenManager::CreateScreen(void* data) {
+  ScreenManager* manager = static_cast<ScreenManager*>(data);
+
+  // C26409: Fixing warning to replace 'new' requires editing included
+  // framework library 'QuickSDL"
+  switch (manager->mChanging) {
+    case start:
+
+      manager->mStartScreen = new StartScreen();
+      break;
+
+    case play:
+
+      manager->mPlayScreen = new PlayScreen();
+      break;
+
+    case controls:
+
+      manager->mControls = new Controls();
+      break;
+
+    default:
+
+      break;
   }
-}
\ No newline at end of file
+}
+
+void ScreenManager::DeleteScreen(void* data) {
+  ScreenManager* manager = static_cast<ScreenManager*>(data);
+
+  // C26812: Changing 'enum' to 'enum class' would cause compilation
+  // error, making all types into undeclared identifiers
+  switch (manager->mChanging) {
+    case play:
+
+      delete manager->mPlayScreen;
+      manager->mPlayScreen = nullptr;
+      break;
+
+    case controls:
+
+      delete manager->mControls;
+      manager->mControls = nullptr;
+      break;
+
+    default:
+
+      break;
+  }
+}
+
+void ScreenManager::ManageScreens(float deltaTime) {
+  // The screen the cursor leads to loads once the cursor has settled
+  SCREENS next = start;
+  if (mCurrentScreen == start) {
+    const int mode = static_cast<int>(mStartScreen->SelectedMode());
+    mCursorTime = mode == mCursorMode ? mCursorTime + deltaTime : 0.0f;
+    mCursorMode = mode;
+
+    if (mCursorTime >= PRELOAD_DELAY) {
+      next = mode == 0 ? play : controls;
+      if (Load(next)) mPreloads++;
+    }
+  }
+
+  // The start screen is where every other screen returns to, so it stays
+  for (int i = play; i < TOTAL_SCREENS; i++) {
+    const SCREENS screen = static_cast<SCREENS>(i);
+    if (screen == mCurrentScreen || screen == next || !Loaded(screen)) {
+      mIdle[i] = 0.0f;
+      continue;
+    }
+
+    mIdle[i] += deltaTime;
+    if (mIdle[i] >= mUnloadDelay) Unload(screen);
+  }
+}
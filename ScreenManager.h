@@ -4,14 +4,17 @@
  * This program is responsible handling all screen types for the game.
  *
  *  @author Michael Martinez
- *  @bug Title selection screen movement is being triggered throughout all the screen
- * types when it should only be affected within the start screen. This causes the menu selection
- * to be incorrect sometimes.
+ *  @bug No known bugs.
  */
 #ifndef _SCREENMANAGER_H
 #define _SCREENMANAGER_H
+#include <atomic>
+#include <cstddef>
+#include <thread>
+
 #include "Controls.h"
 #include "PlayScreen.h"
+#include "RenderBuffers.h"
 #include "StartScreen.h"
 
 /**
@@ -21,6 +24,11 @@
  * ScreenManager class is used to handle create different screen types for the
  * game.
  *
+ * Only the start screen is made up front. The play and controls screens are
+ * made the first time they are needed, or ahead of time while the start
+ * screen cursor rests on the option leading to them, and deleted once they
+ * have been idle for the unload delay.
+ *
  */
 class ScreenManager {
  private:
@@ -30,7 +38,15 @@ class ScreenManager {
    * Used to create different types of screens for the game.
    *
    */
-  enum SCREENS { start, play, controls };
+  enum SCREENS { start, play, controls, TOTAL_SCREENS };
+
+  /** @brief enum for simulation steps
+   *
+   * Used to tell the simulation thread when to run the next frame, and the
+   * main thread when the simulation thread is waiting on a job.
+   *
+   */
+  enum STEPS { waiting, stepping, loading, stopping };
 
   /** @brief Static instance variable
    *
@@ -44,7 +60,70 @@ class ScreenManager {
    * Used to handle keyboard inputs.
    *
    */
-  InputManager* mInput;
+  InputLatch* mInput;
+
+  /** @brief Actions variable
+   *
+   * Used to send actions to the active screen.
+   *
+   */
+  ActionMap* mActions;
+
+  /** @brief Animations variable
+   *
+   * Used to advance every animation once per simulation step.
+   *
+   */
+  Animations* mAnimations;
+
+  /** @brief State hash variable
+   *
+   * Used to hash the gameplay state after every simulation step.
+   *
+   */
+  StateHash* mHash;
+
+  /** @brief Audio variable
+   *
+   * Used to receive events from the audio thread.
+   *
+   */
+  AudioThread* mAudio;
+
+  /** @brief Frame arena variable
+   *
+   * Used to hold short lived data, emptied every frame.
+   *
+   */
+  FrameArena* mArena;
+
+  /** @brief Allocation audit variable
+   *
+   * Used to report heap allocations frame by frame.
+   *
+   */
+  AllocationAudit* mAudit;
+
+  /** @brief Timer variable
+   *
+   * Used to measure the real time of each frame.
+   *
+   */
+  Timer* mTimer;
+
+  /** @brief Fixed timer variable
+   *
+   * Used to turn real frame time into fixed simulation steps.
+   *
+   */
+  FixedTimer* mClock;
+
+  /** @brief Steps variable
+   *
+   * Number of simulation steps the current frame runs.
+   *
+   */
+  int mSteps;
 
   /** @brief Start screen variable
    *
@@ -55,18 +134,54 @@ class ScreenManager {
 
   /** @brief Play screen variable
    *
-   * Used to create the play screen for the game.
+   * Used to create the play screen for the game, null until it is first
+   * needed and after it is unloaded.
    *
    */
   PlayScreen* mPlayScreen;
 
   /** @brief Controls screen variable
    *
-   * Used to create the controls screen for the game.
+   * Used to create the controls screen for the game, null until it is first
+   * needed and after it is unloaded.
    *
    */
   Controls* mControls;
 
+  /** @brief Idle variable
+   *
+   * Seconds since each screen was last shown or preloaded.
+   *
+   */
+  float mIdle[TOTAL_SCREENS];
+
+  /** @brief Unload delay variable
+   *
+   * Seconds a screen stays loaded while idle.
+   *
+   */
+  float mUnloadDelay;
+
+  /** @brief Cursor variables
+   *
+   * Menu option the start screen cursor was last on and for how many
+   * seconds.
+   *
+   */
+  int mCursorMode;
+  float mCursorTime;
+
+  /** @brief Loading statistics variables
+   *
+   * Screens loaded, how many of those were preloaded and screens unloaded,
+   * then the most memory resident right after a load.
+   *
+   */
+  int mLoads;
+  int mPreloads;
+  int mUnloads;
+  std::size_t mPeakResident;
+
   /** @brief Current screen variable
    *
    * Used as a way to tell the program which screen is the game currently in.
@@ -74,7 +189,81 @@ class ScreenManager {
    */
   SCREENS mCurrentScreen;
 
+  /** @brief Enter variables
+   *
+   * When Enter went down for a screen whose first frame is not recorded yet
+   * and which screen, or -1 for none. Then for each screen, the
+   * milliseconds from Enter to its first frame summed and at worst, the
+   * times it was entered and how many of those had to load it first.
+   *
+   */
+  InputQueue::Clock::time_point mEnterPress;
+  int mEnterScreen;
+  double mEnterTime[TOTAL_SCREENS];
+  float mEnterWorst[TOTAL_SCREENS];
+  int mEnters[TOTAL_SCREENS];
+  int mColdEnters[TOTAL_SCREENS];
+
+  /** @brief Render buffers variable
+   *
+   * Render lists handed from the simulation to the main thread.
+   *
+   */
+  RenderBuffers* mBuffers;
+
+  /** @brief Pipelined variable
+   *
+   * True while frames are simulated on their own thread.
+   *
+   */
+  bool mPipelined;
+
+  /** @brief Step variable
+   *
+   * Current simulation step, shared between both threads.
+   *
+   */
+  std::atomic<int> mStep;
+
+  /** @brief Job variables
+   *
+   * Job the simulation thread handed to the main thread and what it is
+   * called with, only read while 'mStep' is 'loading'.
+   *
+   */
+  void (*mJob)(void*);
+  void* mJobData;
+
+  /** @brief Changing variable
+   *
+   * Screen being created or deleted by the main thread.
+   *
+   */
+  SCREENS mChanging;
+
+  /** @brief Simulation thread variable
+   *
+   * Runs the next frame while the main thread draws the last one.
+   *
+   */
+  std::thread mSimulation;
+
  public:
+  /** @brief Unload delay variable
+   *
+   * Default seconds an idle screen stays loaded.
+   *
+   */
+  static constexpr float UNLOAD_DELAY = 30.0f;
+
+  /** @brief Preload delay variable
+   *
+   * Seconds the start screen cursor rests on an option before the screen it
+   * leads to preloads.
+   *
+   */
+  static constexpr float PRELOAD_DELAY = 0.25f;
+
   /** @brief Instance function
    *
    * Used to create and return a screen manager if the static instance is null.
@@ -90,16 +279,10 @@ class ScreenManager {
    */
   static void Release() noexcept;
 
-  /** @brief mode variable
-   *
-   * Used to keep track of the current mode for title screen selection.
-   *
-   */
-  int mode = 1;
-
   /** @brief Update function
    *
-   * Updating the type of screen that displays to the player.
+   * Latches this frame's input and runs every fixed step the frame's real
+   * time has filled, or starts the simulation thread on them when pipelined.
    *
    *  @return void
    */
@@ -107,13 +290,176 @@ class ScreenManager {
 
   /** @brief Render function
    *
-   * Renders all screen types.
+   * Draws the newest finished frame, interpolated between its last two steps.
    *
    *  @return void
    */
   void Render();
 
+  /** @brief Pipelined function
+   *
+   * Starts or stops simulating on a separate thread. While pipelined, frame N
+   * + 1 is simulated as frame N is drawn.
+   *
+   *  @param pipelined
+   *  @return void
+   */
+  void Pipelined(bool pipelined);
+
+  /** @brief Pipelined function
+   *
+   * Used to return true while frames are simulated on their own thread.
+   *
+   *  @return bool
+   */
+  bool Pipelined() noexcept;
+
+  /** @brief Unload delay function
+   *
+   * Sets how many seconds a screen other than the start screen stays loaded
+   * after it was last shown or preloaded.
+   *
+   *  @param seconds
+   *  @return void
+   */
+  void UnloadDelay(float seconds) noexcept;
+
+  /** @brief Run on main thread function
+   *
+   * Runs a job that creates or deletes textures. Called on the simulation
+   * thread, it waits for the main thread to run it between two frames so
+   * SDL is only used from one thread. Anywhere else it runs right away.
+   *
+   *  @param job, data
+   *  @return void
+   */
+  static void RunOnMainThread(void (*job)(void*), void* data);
+
  private:
+  /** @brief Simulate function
+   *
+   * Updating the type of screen that displays to the player by one fixed
+   * step.
+   *
+   *  @return void
+   */
+  void Simulate();
+
+  /** @brief Start screen action handler
+   *
+   * Leaves the start screen for the selected menu option on confirm.
+   *
+   *  @param data, action
+   *  @return void
+   */
+  static void StartAction(void* data, ActionMap::ACTIONS action);
+
+  /** @brief Play screen action handler
+   *
+   * Passes actions on to the play screen.
+   *
+   *  @param data, action
+   *  @return void
+   */
+  static void PlayAction(void* data, ActionMap::ACTIONS action);
+
+  /** @brief Controls screen action handler
+   *
+   * Goes back to the start screen on confirm.
+   *
+   *  @param data, action
+   *  @return void
+   */
+  static void ControlsAction(void* data, ActionMap::ACTIONS action);
+
+  /** @brief Load function
+   *
+   * Creates a screen if it is not loaded.
+   *
+   *  @param screen
+   *  @return bool true if the screen had to be created
+   */
+  bool Load(SCREENS screen);
+
+  /** @brief Unload function
+   *
+   * Deletes a screen other than the start screen.
+   *
+   *  @param screen
+   *  @return void
+   */
+  void Unload(SCREENS screen);
+
+  /** @brief Loaded function
+   *
+   * Used to return true if a screen exists.
+   *
+   *  @param screen
+   *  @return bool
+   */
+  bool Loaded(SCREENS screen) noexcept;
+
+  /** @brief Create screen job
+   *
+   * Creates the screen in 'mChanging'.
+   *
+   *  @param data
+   *  @return void
+   */
+  static void CreateScreen(void* data);
+
+  /** @brief Delete screen job
+   *
+   * Deletes the screen in 'mChanging'.
+   *
+   *  @param data
+   *  @return void
+   */
+  static void DeleteScreen(void* data);
+
+  /** @brief Manage screens function
+   *
+   * Preloads the screen under the start screen cursor once it has rested
+   * there and unloads screens left idle, 'deltaTime' after the last step.
+   *
+   *  @param deltaTime
+   *  @return void
+   */
+  void ManageScreens(float deltaTime);
+
+  /** @brief Record function
+   *
+   * Records all screen types into a render list.
+   *
+   *  @param list
+   *  @return void
+   */
+  void Record(RenderList& list);
+
+  /** @brief Simulation loop function
+   *
+   * Runs and records a frame's steps every time the main thread asks for it.
+   *
+   *  @return void
+   */
+  void SimulationLoop();
+
+  /** @brief Step function
+   *
+   * Runs the current frame's steps. Latched input is only seen by the first.
+   *
+   *  @return void
+   */
+  void Step();
+
+  /** @brief Wait for step function
+   *
+   * Returns once the simulation thread has finished its frame, running any
+   * job it hands over in the meantime.
+   *
+   *  @return void
+   */
+  void WaitForStep() noexcept;
 
   /** @brief Constructor
    *
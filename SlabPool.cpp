@@ -0,0 +1,92 @@
+/** @file SlabPool.cpp
+ *  @brief Source file for slab pools
+ *
+ * This program is responsible for keeping objects of one type side by side in
+ * large slabs, creating and destroying them without the global allocator.
+ *
+ *  @author Michael Martinez
+ *  @bug No known bugs.
+ */
+#include "SlabPool.h"
+
+#include <algorithm>
+#include <cstdio>
+
+// C26455: Fixing the warning 'noexcept' solution is to not include 'noexcept'
+// in the first place.
+//(https://docs.microsoft.com/en-us/cpp/code-quality/c26447?view=msvc-170)
+SlabPool::SlabPool(const char* name, std::size_t objectSize,
+                   int slabObjects) {
+  // Every slot starts on the alignment the global allocator gives
+  const std::size_t alignment = alignof(std::max_align_t);
+  const std::size_t size = std::max(objectSize, sizeof(FreeSlot));
+
+  mName = name;
+  mSlotSize = (size + alignment - 1) / alignment * alignment;
+  mSlabObjects = slabObjects;
+  mFree = nullptr;
+  mLive = 0;
+  mPeak = 0;
+
+  Pools().push_back(this);
+}
+
+// C26432: deleting all would cause compiling error
+SlabPool::~SlabPool() {
+  std::vector<SlabPool*>& pools = Pools();
+  pools.erase(std::remove(pools.begin(), pools.end(), this), pools.end());
+
+  for (char* slab : mSlabs) delete[] slab;
+  mSlabs.clear();
+  mFree = nullptr;
+}
+
+void* SlabPool::Allocate() {
+  if (mFree == nullptr) AddSlab();
+
+  FreeSlot* slot = mFree;
+  mFree = slot->next;
+
+  mLive++;
+  if (mLive > mPeak) mPeak = mLive;
+  return slot;
+}
+
+void SlabPool::Free(void* slot) noexcept {
+  FreeSlot* freed = static_cast<FreeSlot*>(slot);
+  freed->next = mFree;
+  mFree = freed;
+  mLive--;
+}
+
+int SlabPool::Live() noexcept { return mLive; }
+
+int SlabPool::Capacity() noexcept { return mSlabs.size() * mSlabObjects; }
+
+void SlabPool::Report() {
+  std::printf("Slab pools\n");
+  for (SlabPool* pool : Pools()) {
+    std::printf("  %-24s %5d of %5d in use, %5d peak, %3d slabs of %zu bytes\n",
+                pool->mName, pool->mLive, pool->Capacity(), pool->mPeak,
+                static_cast<int>(pool->mSlabs.size()),
+                pool->mSlotSize * pool->mSlabObjects);
+  }
+}
+
+void SlabPool::AddSlab() {
+  // C26409: Slabs are raw bytes split into slots
+  char* slab = new char[mSlotSize * mSlabObjects];
+  mSlabs.push_back(slab);
+
+  // Pushed from the back so the lowest slot is handed out first
+  for (int i = mSlabObjects - 1; i >= 0; i--) {
+    FreeSlot* slot = reinterpret_cast<FreeSlot*>(slab + mSlotSize * i);
+    slot->next = mFree;
+    mFree = slot;
+  }
+}
+
+std::vector<SlabPool*>& SlabPool::Pools() {
+  static std::vector<SlabPool*> pools;
+  return pools;
+}
@@ -0,0 +1,261 @@
+/** @file SlabPool.h
+ *  @brief Header file for slab pools
+ *
+ * This program is responsible for keeping objects of one type side by side in
+ * large slabs, creating and destroying them without the global allocator.
+ *
+ *  @author Michael Martinez
+ *  @bug No known bugs.
+ */
+#ifndef _SLABPOOL_H
+#define _SLABPOOL_H
+#include <cstddef>
+#include <new>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief The SlabPool class
+ * @author Michael Martinez
+ *
+ * SlabPool class which is used to hand out fixed size slots from slabs of
+ * contiguous memory. Freed slots go on a free list that the next allocation
+ * takes from, so both are constant time and a new slab is only made when every
+ * slot is in use. Slabs are kept until the pool is destroyed. Pools are not
+ * thread safe, objects of a type must be created and destroyed on one thread
+ * at a time.
+ *
+ */
+class SlabPool {
+ public:
+  /** @brief Slab objects variable
+   *
+   * Default number of slots in each slab.
+   *
+   */
+  static const int SLAB_OBJECTS = 64;
+
+ private:
+  /** @brief Free slot struct
+   *
+   * Link stored in a slot while it is on the free list.
+   *
+   */
+  struct FreeSlot {
+    FreeSlot* next;
+  };
+
+  /** @brief Name variable
+   *
+   * Name of the pool's type, used when reporting.
+   *
+   */
+  const char* mName;
+
+  /** @brief Slot size variable
+   *
+   * Size in bytes of each slot, the object size rounded up to keep every slot
+   * aligned.
+   *
+   */
+  std::size_t mSlotSize;
+
+  /** @brief Slab objects variable
+   *
+   * Number of slots in each slab.
+   *
+   */
+  int mSlabObjects;
+
+  /** @brief Slabs variable
+   *
+   * Memory of every slab.
+   *
+   */
+  std::vector<char*> mSlabs;
+
+  /** @brief Free variable
+   *
+   * First slot of the free list, or null when every slot is in use.
+   *
+   */
+  FreeSlot* mFree;
+
+  /** @brief Live variables
+   *
+   * Number of slots in use and the most that were ever in use at once.
+   *
+   */
+  int mLive;
+  int mPeak;
+
+ public:
+  /** @brief Constructor
+   *
+   * Creates an empty pool for objects of 'objectSize' bytes.
+   *
+   *  @param name, objectSize, slabObjects
+   */
+  SlabPool(const char* name, std::size_t objectSize,
+           int slabObjects = SLAB_OBJECTS);
+
+  /** @brief Deconstructor
+   *
+   * Freeing all entities.
+   *
+   */
+  ~SlabPool();
+
+  /** @brief Allocate function
+   *
+   * Used to return a free slot, adding a slab if there is none.
+   *
+   *  @return void*
+   */
+  void* Allocate();
+
+  /** @brief Free function
+   *
+   * Puts a slot back on the free list.
+   *
+   *  @param slot
+   *  @return void
+   */
+  void Free(void* slot) noexcept;
+
+  /** @brief Live function
+   *
+   * Used to return the number of slots in use.
+   *
+   *  @return int
+   */
+  int Live() noexcept;
+
+  /** @brief Capacity function
+   *
+   * Used to return the number of slots in every slab.
+   *
+   *  @return int
+   */
+  int Capacity() noexcept;
+
+  /** @brief Report function
+   *
+   * Prints the occupancy of every pool.
+   *
+   *  @return void
+   */
+  static void Report();
+
+ private:
+  /** @brief Add slab function
+   *
+   * Allocates a slab and puts its slots on the free list in address order.
+   *
+   *  @return void
+   */
+  void AddSlab();
+
+  /** @brief Pools function
+   *
+   * Used to return every pool that exists, for reporting.
+   *
+   *  @return std::vector<SlabPool*>&
+   */
+  static std::vector<SlabPool*>& Pools();
+};
+
+/**
+ * @brief The ObjectPool class
+ * @author Michael Martinez
+ *
+ * ObjectPool class which is used to create and destroy objects of one type in
+ * that type's slab pool. Types from the framework are made with 'Create' and
+ * 'Destroy' in place of new and delete. Game classes instead route their own
+ * operator new and delete to 'Allocate' and 'Free'.
+ *
+ */
+template <class T>
+class ObjectPool {
+ public:
+  /** @brief Slabs function
+   *
+   * Used to return the slab pool of the type, made on first use.
+   *
+   *  @return SlabPool&
+   */
+  static SlabPool& Slabs();
+
+  /** @brief Create function
+   *
+   * Used to return a new object built from 'args' in the pool.
+   *
+   *  @param args
+   *  @return T*
+   */
+  template <class... Args>
+  static T* Create(Args&&... args);
+
+  /** @brief Destroy function
+   *
+   * Destroys an object made with 'Create'. Does nothing for null.
+   *
+   *  @param object
+   *  @return void
+   */
+  static void Destroy(T* object) noexcept;
+
+  /** @brief Allocate function
+   *
+   * Used to return a slot for an object of the type.
+   *
+   *  @param size
+   *  @return void*
+   */
+  static void* Allocate(std::size_t size);
+
+  /** @brief Free function
+   *
+   * Puts an object's slot back in the pool.
+   *
+   *  @param object
+   *  @return void
+   */
+  static void Free(void* object) noexcept;
+};
+
+template <class T>
+SlabPool& ObjectPool<T>::Slabs() {
+  static SlabPool slabs(typeid(T).name(), sizeof(T));
+  return slabs;
+}
+
+template <class T>
+template <class... Args>
+T* ObjectPool<T>::Create(Args&&... args) {
+  void* slot = Slabs().Allocate();
+  return new (slot) T(std::forward<Args>(args)...);
+}
+
+template <class T>
+void ObjectPool<T>::Destroy(T* object) noexcept {
+  if (object == nullptr) return;
+
+  object->~T();
+  Slabs().Free(object);
+}
+
+template <class T>
+void* ObjectPool<T>::Allocate(std::size_t size) {
+  // Derived types are bigger than the slots
+  if (size != sizeof(T)) throw std::bad_alloc();
+  return Slabs().Allocate();
+}
+
+template <class T>
+void ObjectPool<T>::Free(void* object) noexcept {
+  if (object != nullptr) Slabs().Free(object);
+}
+
+#endif
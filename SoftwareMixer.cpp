@@ -0,0 +1,268 @@
+/** @file SoftwareMixer.cpp
+ *  @brief Source file for the software mixer
+ *
+ * This program is responsible for mixing hundreds of sound effects at once
+ * with SIMD, in place of the mixer's fixed set of channels.
+ *
+ *  @author Michael Martinez
+ *  @bug Only mixes for a 16 bit stereo device.
+ */
+#include "SoftwareMixer.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define MIXER_SSE
+#endif
+
+// C26455: Fixing the warning 'noexcept' solution is to not include 'noexcept'
+// in the first place.
+//(https://docs.microsoft.com/en-us/cpp/code-quality/c26447?view=msvc-170)
+SoftwareMixer::SoftwareMixer() {
+  mHead = 0;
+  mTail = 0;
+  mCount = 0;
+  mStarted = 0;
+  mHooked = false;
+  ResetStatistics();
+}
+
+// C26432: deleting all would cause compiling error
+SoftwareMixer::~SoftwareMixer() { Stop(); }
+
+bool SoftwareMixer::Start() {
+  int rate = 0;
+  Uint16 format = 0;
+  int channels = 0;
+  if (Mix_QuerySpec(&rate, &format, &channels) == 0 ||
+      format != AUDIO_S16SYS || channels != 2)
+    return false;
+
+  Mix_SetPostMix(Callback, this);
+  mHooked = true;
+  return true;
+}
+
+void SoftwareMixer::Stop() noexcept {
+  if (!mHooked) return;
+
+  Mix_SetPostMix(nullptr, nullptr);
+  mHooked = false;
+}
+
+bool SoftwareMixer::Play(const Mix_Chunk* chunk, int sound, int priority,
+                         int maxVoices, int loops, float gain,
+                         float pan) noexcept {
+  const unsigned int tail = mTail.load(std::memory_order_relaxed);
+  if (tail - mHead.load(std::memory_order_acquire) == QUEUE_CAPACITY)
+    return false;
+
+  // Panning only turns down the side it moves away from
+  const float left = gain * std::min(1.0f, 1.0f - pan);
+  const float right = gain * std::min(1.0f, 1.0f + pan);
+
+  // Chunks are loaded in the device's format, two samples a frame
+  mCommands[tail & (QUEUE_CAPACITY - 1)] = {
+      reinterpret_cast<const Sint16*>(chunk->abuf),
+      static_cast<int>(chunk->alen / 4), loops, left, right, sound, priority,
+      maxVoices};
+  mTail.store(tail + 1, std::memory_order_release);
+  return true;
+}
+
+void SoftwareMixer::Mix(Uint8* stream, int len) noexcept {
+  const Clock::time_point start = Clock::now();
+
+  unsigned int head = mHead.load(std::memory_order_relaxed);
+  const unsigned int tail = mTail.load(std::memory_order_acquire);
+  for (; head != tail; head++)
+    StartVoice(mCommands[head & (QUEUE_CAPACITY - 1)]);
+  mHead.store(head, std::memory_order_release);
+
+  const int voices = mCount;
+  Sint16* out = reinterpret_cast<Sint16*>(stream);
+  const int frames = len / 4;
+
+  for (int done = 0; done < frames; done += BLOCK_FRAMES) {
+    const int remaining = frames - done;
+    const int block = remaining < BLOCK_FRAMES ? remaining : BLOCK_FRAMES;
+    std::fill(mAccumulator, mAccumulator + block * 2, 0.0f);
+
+    int voice = 0;
+    while (voice < mCount) {
+      int mixed = 0;
+      bool playing = true;
+      while (mixed < block && playing) {
+        const int count =
+            std::min(block - mixed, mFrames[voice] - mPosition[voice]);
+        MixVoice(mAccumulator + mixed * 2,
+                 mSamples[voice] + mPosition[voice] * 2, count, mLeft[voice],
+                 mRight[voice]);
+        mixed += count;
+        mPosition[voice] += count;
+
+        if (mPosition[voice] < mFrames[voice]) continue;
+        if (mLoops[voice] == 0) {
+          playing = false;
+        } else {
+          if (mLoops[voice] > 0) mLoops[voice]--;
+          mPosition[voice] = 0;
+        }
+      }
+
+      if (playing) {
+        voice++;
+        continue;
+      }
+
+      // Finished voices are filled in by the last one to keep them packed
+      mCount--;
+      mSamples[voice] = mSamples[mCount];
+      mFrames[voice] = mFrames[mCount];
+      mPosition[voice] = mPosition[mCount];
+      mLoops[voice] = mLoops[mCount];
+      mLeft[voice] = mLeft[mCount];
+      mRight[voice] = mRight[mCount];
+      mSound[voice] = mSound[mCount];
+      mPriority[voice] = mPriority[mCount];
+      mOrder[voice] = mOrder[mCount];
+    }
+
+    Write(out + done * 2, mAccumulator, block);
+  }
+
+  mVoices = voices;
+  if (voices > mPeakVoices) mPeakVoices = voices;
+  mMixed += voices;
+  mMixTime += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                  Clock::now() - start)
+                  .count();
+}
+
+void SoftwareMixer::Callback(void* data, Uint8* stream, int len) {
+  static_cast<SoftwareMixer*>(data)->Mix(stream, len);
+}
+
+int SoftwareMixer::Voices() noexcept { return mVoices; }
+
+int SoftwareMixer::PeakVoices() noexcept { return mPeakVoices; }
+
+long long SoftwareMixer::Stolen() noexcept { return mStolen; }
+
+long long SoftwareMixer::Skipped() noexcept { return mSkipped; }
+
+float SoftwareMixer::VoicesPerMs() noexcept {
+  const long long time = mMixTime;
+  if (time == 0) return 0.0f;
+
+  return mMixed * 1000000.0f / time;
+}
+
+void SoftwareMixer::ResetStatistics() noexcept {
+  mVoices = 0;
+  mPeakVoices = 0;
+  mStolen = 0;
+  mSkipped = 0;
+  mMixed = 0;
+  mMixTime = 0;
+}
+
+void SoftwareMixer::StartVoice(const Command& command) noexcept {
+  if (command.samples == nullptr || command.frames == 0) return;
+
+  int instances = 0;
+  int oldestInstance = -1;
+  int victim = -1;
+  for (int i = 0; i < mCount; i++) {
+    if (mSound[i] == command.sound) {
+      instances++;
+      if (oldestInstance < 0 || mOrder[i] < mOrder[oldestInstance])
+        oldestInstance = i;
+    }
+
+    // Lowest priority first, the oldest of those
+    if (victim < 0 || mPriority[i] < mPriority[victim] ||
+        (mPriority[i] == mPriority[victim] && mOrder[i] < mOrder[victim]))
+      victim = i;
+  }
+
+  // Same order of choices as the audio thread uses for channels
+  int voice = mCount;
+  if (instances >= command.maxVoices) {
+    voice = oldestInstance;
+    mStolen++;
+  } else if (mCount < MAX_VOICES) {
+    mCount++;
+  } else if (mPriority[victim] > command.priority) {
+    mSkipped++;
+    return;
+  } else {
+    voice = victim;
+    mStolen++;
+  }
+
+  mSamples[voice] = command.samples;
+  mFrames[voice] = command.frames;
+  mPosition[voice] = 0;
+  mLoops[voice] = command.loops;
+  mLeft[voice] = command.left;
+  mRight[voice] = command.right;
+  mSound[voice] = command.sound;
+  mPriority[voice] = command.priority;
+  mOrder[voice] = mStarted++;
+}
+
+void SoftwareMixer::MixVoice(float* accumulator, const Sint16* samples,
+                             int frames, float left, float right) noexcept {
+  int i = 0;
+
+#ifdef MIXER_SSE
+  // Four frames at a time, the gains repeating left and right
+  const __m128 gains = _mm_setr_ps(left, right, left, right);
+  for (; i + 4 <= frames; i += 4) {
+    const __m128i pcm =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(samples + i * 2));
+
+    // Each sample moved to the top half of a 32 bit lane and shifted back
+    const __m128 low =
+        _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(pcm, pcm), 16));
+    const __m128 high =
+        _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(pcm, pcm), 16));
+
+    float* sum = accumulator + i * 2;
+    _mm_storeu_ps(sum, _mm_add_ps(_mm_loadu_ps(sum), _mm_mul_ps(low, gains)));
+    _mm_storeu_ps(sum + 4,
+                  _mm_add_ps(_mm_loadu_ps(sum + 4), _mm_mul_ps(high, gains)));
+  }
+#endif
+
+  for (; i < frames; i++) {
+    accumulator[i * 2] += samples[i * 2] * left;
+    accumulator[i * 2 + 1] += samples[i * 2 + 1] * right;
+  }
+}
+
+void SoftwareMixer::Write(Sint16* out, const float* accumulator,
+                          int frames) noexcept {
+  int i = 0;
+
+#ifdef MIXER_SSE
+  // Packing and adding both saturate at the 16 bit limits
+  for (; i + 4 <= frames; i += 4) {
+    const __m128i sum =
+        _mm_packs_epi32(_mm_cvtps_epi32(_mm_loadu_ps(accumulator + i * 2)),
+                        _mm_cvtps_epi32(_mm_loadu_ps(accumulator + i * 2 + 4)));
+    __m128i* mixed = reinterpret_cast<__m128i*>(out + i * 2);
+    _mm_storeu_si128(mixed, _mm_adds_epi16(_mm_loadu_si128(mixed), sum));
+  }
+#endif
+
+  // Clamped in the same two steps as with SIMD
+  for (i *= 2; i < frames * 2; i++) {
+    const float sum = std::clamp(std::nearbyint(accumulator[i]), -32768.0f,
+                                 32767.0f);
+    out[i] = static_cast<Sint16>(std::clamp(out[i] + sum, -32768.0f, 32767.0f));
+  }
+}
@@ -0,0 +1,298 @@
+/** @file SoftwareMixer.h
+ *  @brief Header file for the software mixer
+ *
+ * This program is responsible for mixing hundreds of sound effects at once
+ * with SIMD, in place of the mixer's fixed set of channels.
+ *
+ *  @author Michael Martinez
+ *  @bug Only mixes for a 16 bit stereo device.
+ */
+#ifndef _SOFTWAREMIXER_H
+#define _SOFTWAREMIXER_H
+#include <atomic>
+#include <chrono>
+
+#include "SDL_mixer.h"
+
+/**
+ * @brief The SoftwareMixer class
+ * @author Michael Martinez
+ *
+ * SoftwareMixer class which is used to sum sound effect voices into the
+ * audio device's buffer after the mixer has filled it. 'Play' queues a voice
+ * from one thread and the audio callback takes it from the queue, so neither
+ * side ever waits. Each voice has its own gain for the left and right
+ * channel, and four frames are mixed at a time. Voices are given out the way
+ * the audio thread gives out channels: a sound at its cap starts over on its
+ * oldest instance, and with every voice in use the oldest of the lowest
+ * priority is replaced unless the new sound's priority is lower still.
+ *
+ */
+class SoftwareMixer {
+ public:
+  /** @brief Max voices variable
+   *
+   * Number of voices that can play at once.
+   *
+   */
+  static const int MAX_VOICES = 256;
+
+  /** @brief Queue capacity variable
+   *
+   * Number of voices that can wait for the callback, a power of two.
+   *
+   */
+  static const int QUEUE_CAPACITY = 256;
+
+  /** @brief Block frames variable
+   *
+   * Number of frames mixed in each pass over the voices.
+   *
+   */
+  static const int BLOCK_FRAMES = 256;
+
+  /** @brief Clock type
+   *
+   * Clock the callback is timed with.
+   *
+   */
+  typedef std::chrono::steady_clock Clock;
+
+ private:
+  /** @brief Command struct
+   *
+   * A voice waiting to start, with its samples, gains, sound handle,
+   * priority and the most instances of the sound that may play.
+   *
+   */
+  struct Command {
+    const Sint16* samples;
+    int frames;
+    int loops;
+    float left;
+    float right;
+    int sound;
+    int priority;
+    int maxVoices;
+  };
+
+  /** @brief Commands variable
+   *
+   * Ring buffer of voices waiting to start.
+   *
+   */
+  Command mCommands[QUEUE_CAPACITY];
+
+  /** @brief Command position variables
+   *
+   * Index of the next command to take, only written by the callback, and of
+   * the next to queue, only written by 'Play'.
+   *
+   */
+  std::atomic<unsigned int> mHead;
+  std::atomic<unsigned int> mTail;
+
+  /** @brief Voice variables
+   *
+   * Samples, length in frames, next frame, loops left, gains, sound handle,
+   * priority and start order of every voice playing. Only used by the
+   * callback.
+   *
+   */
+  const Sint16* mSamples[MAX_VOICES];
+  int mFrames[MAX_VOICES];
+  int mPosition[MAX_VOICES];
+  int mLoops[MAX_VOICES];
+  float mLeft[MAX_VOICES];
+  float mRight[MAX_VOICES];
+  int mSound[MAX_VOICES];
+  int mPriority[MAX_VOICES];
+  long long mOrder[MAX_VOICES];
+
+  /** @brief Count variable
+   *
+   * Number of voices playing, packed at the front of the voice arrays.
+   *
+   */
+  int mCount;
+
+  /** @brief Started variable
+   *
+   * Number of voices started so far.
+   *
+   */
+  long long mStarted;
+
+  /** @brief Accumulator variable
+   *
+   * Interleaved sum of every voice for one block.
+   *
+   */
+  float mAccumulator[BLOCK_FRAMES * 2];
+
+  /** @brief Hooked variable
+   *
+   * True while the mixer calls 'Callback'.
+   *
+   */
+  bool mHooked;
+
+  /** @brief Statistics variables
+   *
+   * Voices playing at the last callback and at most, voices replaced, voices
+   * not started for lower priority, then voices summed over every callback
+   * with the time the callbacks took.
+   *
+   */
+  std::atomic<int> mVoices;
+  std::atomic<int> mPeakVoices;
+  std::atomic<long long> mStolen;
+  std::atomic<long long> mSkipped;
+  std::atomic<long long> mMixed;
+  std::atomic<long long> mMixTime;
+
+ public:
+  /** @brief Constructor
+   *
+   * Creates a mixer with no voices that is not hooked to the device.
+   *
+   */
+  SoftwareMixer();
+
+  /** @brief Deconstructor
+   *
+   * Unhooks the mixer.
+   *
+   */
+  ~SoftwareMixer();
+
+  /** @brief Start function
+   *
+   * Hooks the mixer to the device after the mixer's own channels.
+   *
+   *  @return bool false if the device is not 16 bit stereo
+   */
+  bool Start();
+
+  /** @brief Stop function
+   *
+   * Unhooks the mixer, waiting for a callback in progress.
+   *
+   *  @return void
+   */
+  void Stop() noexcept;
+
+  /** @brief Play function
+   *
+   * Queues a sound 'loops' more times after the first, -1 for forever, at
+   * 'gain' from 0 to 1 and 'pan' from -1 for left to 1 for right. 'sound'
+   * identifies the sound for its cap of 'maxVoices' instances, and
+   * 'priority' decides what it may replace.
+   *
+   *  @param chunk, sound, priority, maxVoices, loops, gain, pan
+   *  @return bool false if the queue is full
+   */
+  bool Play(const Mix_Chunk* chunk, int sound, int priority, int maxVoices,
+            int loops, float gain, float pan) noexcept;
+
+  /** @brief Mix function
+   *
+   * Adds every voice to the 'len' bytes of 'stream' and moves them on.
+   *
+   *  @param stream, len
+   *  @return void
+   */
+  void Mix(Uint8* stream, int len) noexcept;
+
+  /** @brief Callback function
+   *
+   * Post mix hook given to the mixer, with the software mixer as 'data'.
+   *
+   *  @param data, stream, len
+   *  @return void
+   */
+  static void Callback(void* data, Uint8* stream, int len);
+
+  /** @brief Voices function
+   *
+   * Used to return the number of voices playing at the last callback.
+   *
+   *  @return int
+   */
+  int Voices() noexcept;
+
+  /** @brief Peak voices function
+   *
+   * Used to return the most voices that played at once.
+   *
+   *  @return int
+   */
+  int PeakVoices() noexcept;
+
+  /** @brief Stolen function
+   *
+   * Used to return the number of voices replaced while every voice was in
+   * use.
+   *
+   *  @return long long
+   */
+  long long Stolen() noexcept;
+
+  /** @brief Skipped function
+   *
+   * Used to return the number of voices not started because every voice
+   * played something of higher priority.
+   *
+   *  @return long long
+   */
+  long long Skipped() noexcept;
+
+  /** @brief Voices per ms function
+   *
+   * Used to return the voices mixed per millisecond of callback time.
+   *
+   *  @return float
+   */
+  float VoicesPerMs() noexcept;
+
+  /** @brief Reset statistics function
+   *
+   * Sets every statistic back to zero.
+   *
+   *  @return void
+   */
+  void ResetStatistics() noexcept;
+
+ private:
+  /** @brief Start voice function
+   *
+   * Starts a queued voice, replacing one if its sound is at its cap or every
+   * voice is in use.
+   *
+   *  @param command
+   *  @return void
+   */
+  void StartVoice(const Command& command) noexcept;
+
+  /** @brief Mix voice function
+   *
+   * Adds 'frames' stereo frames of 'samples' to 'accumulator' at the gains.
+   *
+   *  @param accumulator, samples, frames, left, right
+   *  @return void
+   */
+  static void MixVoice(float* accumulator, const Sint16* samples, int frames,
+                       float left, float right) noexcept;
+
+  /** @brief Write function
+   *
+   * Adds 'frames' accumulated frames to 'out', clamping to 16 bits.
+   *
+   *  @param out, accumulator, frames
+   *  @return void
+   */
+  static void Write(Sint16* out, const float* accumulator,
+                    int frames) noexcept;
+};
+
+#endif
@@ -13,16 +13,16 @@
 // in the first place.
 //(https://docs.microsoft.com/en-us/cpp/code-quality/c26447?view=msvc-170)
 StartScreen::StartScreen() {
-  mTimer = Timer::Instance();
-  mInput = InputManager::Instance();
+  mTimer = FixedTimer::Instance();
+  mAnimations = Animations::Instance();
 
   // Logo Entities
-  // C26409: Fixing warning to replace 'new' requires editing included
-  // framework library 'QuickSDL"
-  mLogo = new Texture("TitleScreen.png", 0, 0, 960, 640);
+  mLogo = ObjectPool<Texture>::Create("TitleScreen.png", 0, 0, 960, 640);
   //(PNG file, x, y, width, height, frames, speed, direction for spritesheet)
-  mAnimatedLogo = new AnimatedTexture("TitleScreen.png", 0, 0, 960, 640, 10,
-                                      1.25f, AnimatedTexture::vertical);
+  mAnimatedLogo =
+      ObjectPool<Texture>::Create("TitleScreen.png", 0, 0, 960, 640);
+  mLogoClip = mAnimations->Add(mAnimatedLogo, 10, 1.25f,
+                               AnimatedTexture::vertical);
 
   // Used to adjust position of entities
   mLogo->Pos(Vector2(Graphics::Instance()->SCREEN_WIDTH * 0.5f,
@@ -34,14 +34,21 @@ StartScreen::StartScreen() {
   mAnimatedLogo->Parent(this);
 
   // Play Mode Entities
-  mPlayModes =
-      new GameEntity(Vector2(Graphics::Instance()->SCREEN_WIDTH * 0.5f,
-                             Graphics::Instance()->SCREEN_HEIGHT * 0.55f));
-  mNewGame = new Texture("NEW GAME", "BN6FontBold.ttf", 60, {230, 230, 230});
-  mControls = new Texture("CONTROLS", "BN6FontBig.ttf", 60, {230, 230, 230});
-
-  mAnimatedCursor = new AnimatedTexture("arrow.png", 0, 0, 52, 64, 3, 0.25f,
-                                        AnimatedTexture::vertical);
+  mPlayModes = ObjectPool<GameEntity>::Create(
+      Vector2(Graphics::Instance()->SCREEN_WIDTH * 0.5f,
+              Graphics::Instance()->SCREEN_HEIGHT * 0.55f));
+  mNewGame = ObjectPool<Texture>::Create("NEW GAME", "BN6FontBold.ttf", 60,
+                                         SDL_Color{230, 230, 230});
+  mControls = ObjectPool<Texture>::Create("CONTROLS", "BN6FontBig.ttf", 60,
+                                          SDL_Color{230, 230, 230});
+
+  mAnimatedCursor = ObjectPool<Texture>::Create("arrow.png", 0, 0, 52, 64);
+  mCursorClip = mAnimations->Add(mAnimatedCursor, 3, 0.25f,
+                                 AnimatedTexture::vertical);
+
+  // Animations start once the screen has slid in
+  mAnimations->Pause(mLogoClip, true);
+  mAnimations->Pause(mCursorClip, true);
 
   mNewGame->Parent(mPlayModes);
   mControls->Parent(mPlayModes);
@@ -60,42 +67,49 @@ StartScreen::StartScreen() {
   mSelectedMode = 0;
 
   // Bottom Bar Entities
-  mBotBar = new GameEntity(Vector2(Graphics::Instance()->SCREEN_WIDTH * 0.5f,
-                                   Graphics::Instance()->SCREEN_HEIGHT * 0.7f));
+  mBotBar = ObjectPool<GameEntity>::Create(
+      Vector2(Graphics::Instance()->SCREEN_WIDTH * 0.5f,
+              Graphics::Instance()->SCREEN_HEIGHT * 0.7f));
 
-  mRights = new Texture(" CAPCOM CO.,LTD.2005 ALL RIGHTS RESERVED",
-                        "BN6FontBold.ttf", 45, {230, 230, 230});
+  mRights = ObjectPool<Texture>::Create(
+      " CAPCOM CO.,LTD.2005 ALL RIGHTS RESERVED", "BN6FontBold.ttf", 45,
+      SDL_Color{230, 230, 230});
   mRights->Parent(mBotBar);
   mRights->Pos(Vector2(0.0f, 170.0f));
 
   mBotBar->Parent(this);
 
   Pos(mAnimationStartPos);
+  mPrevPos = mAnimationStartPos;
 }
 
 // C26432: deleting all would cause compiling error
 StartScreen::~StartScreen() {
+  mAnimations->Remove(mLogoClip);
+  mAnimations->Remove(mCursorClip);
+  mAnimations = nullptr;
+
   // Freeing Logo Entities
-  delete mLogo;
+  ObjectPool<Texture>::Destroy(mLogo);
   mLogo = nullptr;
-  delete mAnimatedLogo;
+  ObjectPool<Texture>::Destroy(mAnimatedLogo);
   mAnimatedLogo = nullptr;
 
   // Freeing Play Mode Entities
-  delete mPlayModes;
+  ObjectPool<GameEntity>::Destroy(mPlayModes);
   mPlayModes = nullptr;
-  delete mNewGame;
+  ObjectPool<Texture>::Destroy(mNewGame);
   mNewGame = nullptr;
-  delete mControls;
+  ObjectPool<Texture>::Destroy(mControls);
   mControls = nullptr;
 
-  delete mAnimatedCursor;
+  ObjectPool<Texture>::Destroy(mAnimatedCursor);
   mAnimatedCursor = nullptr;
 
   // Freeing Bottom Bar Entities
-  delete mBotBar;
+  ObjectPool<GameEntity>::Destroy(mBotBar);
   mBotBar = nullptr;
-  delete mRights;
+  ObjectPool<Texture>::Destroy(mRights);
   mRights = nullptr;
 }
 
@@ -113,40 +127,47 @@ void StartScreen::ChangeSelectedMode(int change) {
   mAnimatedCursor->Pos(mCursorStartPos + mCursorOffset * mSelectedMode);
 }
 
+void StartScreen::OnAction(void* data, ActionMap::ACTIONS action) {
+  StartScreen* screen = static_cast<StartScreen*>(data);
+  if (action != ActionMap::up && action != ActionMap::down) return;
+
+  if (!screen->mAnimationDone)
+    screen->mAnimationTimer = screen->mAnimationTotalTime;
+  else
+    screen->ChangeSelectedMode(action == ActionMap::down ? 1 : -1);
+}
+
 // C26433: Method is not a virtual function to use override.
 void StartScreen::Update() {
   if (!mAnimationDone) {
+    mPrevPos = Pos();
     mAnimationTimer += mTimer->DeltaTime();
     Pos(Lerp(mAnimationStartPos, mAnimationEndPos,
              mAnimationTimer / mAnimationTotalTime));
 
-    if (mAnimationTimer >= mAnimationTotalTime) mAnimationDone = true;
-
-    if (mInput->KeyPressed(SDL_SCANCODE_DOWN) ||
-        mInput->KeyPressed(SDL_SCANCODE_UP))
-      mAnimationTimer = mAnimationTotalTime;
-  } else {
-    mAnimatedLogo->Update();
-    mAnimatedCursor->Update();
-
-    if (mInput->KeyPressed(SDL_SCANCODE_DOWN))
-      ChangeSelectedMode(1);
-    else if (mInput->KeyPressed(SDL_SCANCODE_UP))
-      ChangeSelectedMode(-1);
+    if (mAnimationTimer >= mAnimationTotalTime) {
+      mAnimationDone = true;
+      mAnimations->Pause(mLogoClip, false);
+      mAnimations->Pause(mCursorClip, false);
+    }
   }
 }
 
 // C26433: Method is not a virtual function to use override.
 void StartScreen::Render() {
+  // Between the last two steps of the slide, the screen stays where it is
+  Vector2 slide = VEC2_ZERO;
+  if (!mAnimationDone) slide = (mPrevPos - Pos()) * (1.0f - mTimer->Alpha());
+
   if (!mAnimationDone)
-    mLogo->Render();
+    RenderList::Draw(mLogo, slide);
   else
-    mAnimatedLogo->Render();
+    RenderList::Draw(mAnimatedLogo);
 
-  mNewGame->Render();
-  mControls->Render();
+  RenderList::Draw(mNewGame, slide);
+  RenderList::Draw(mControls, slide);
 
-  mAnimatedCursor->Render();
+  RenderList::Draw(mAnimatedCursor, slide);
 
-  mRights->Render();
+  RenderList::Draw(mRights, slide);
 }
\ No newline at end of file
@@ -9,8 +9,11 @@
  */
 #ifndef _STARTSCREEN_H
 #define _STARTSCREEN_H
-#include "AnimatedTexture.h"
-#include "InputManager.h"
+#include "ActionMap.h"
+#include "Animations.h"
+#include "FixedTimer.h"
+#include "RenderList.h"
+#include "SlabPool.h"
 
 using namespace QuickSDL;
 
@@ -29,14 +32,14 @@ class StartScreen : public GameEntity {
    * Used to keep track of time between resets.
    *
    */
-  Timer* mTimer;
+  FixedTimer* mTimer;
 
-  /** @brief Input variable
+  /** @brief Animations variable
    *
-   * Used to handle keyboard inputs.
+   * Used to play the logo and cursor animations.
    *
    */
-  InputManager* mInput;
+  Animations* mAnimations;
 
   /** @brief Logo texture
    *
@@ -47,10 +50,17 @@ class StartScreen : public GameEntity {
 
   /** @brief Animated logo texture
    *
-   * Used to create animated logo texture.
+   * Used to create sprite sheet logo texture.
    *
    */
-  AnimatedTexture* mAnimatedLogo;
+  Texture* mAnimatedLogo;
+
+  /** @brief Logo clip variable
+   *
+   * Handle of the logo animation in the animation registry.
+   *
+   */
+  int mLogoClip;
 
   /** @brief Game entity variable
    *
@@ -76,10 +86,17 @@ class StartScreen : public GameEntity {
 
   /** @brief Animated cursor texture
    *
-   * Used to create animated cursor texture.
+   * Used to create sprite sheet cursor texture.
    *
    */
-  AnimatedTexture* mAnimatedCursor;
+  Texture* mAnimatedCursor;
+
+  /** @brief Cursor clip variable
+   *
+   * Handle of the cursor animation in the animation registry.
+   *
+   */
+  int mCursorClip;
 
   /** @brief Cursor start position variable
    *
@@ -130,6 +147,14 @@ class StartScreen : public GameEntity {
    */
   Vector2 mAnimationEndPos;
 
+  /** @brief Previous position variable
+   *
+   * Position before the last simulation step, drawn towards the current one
+   * while sliding in.
+   *
+   */
+  Vector2 mPrevPos;
+
   /** @brief Total animation time variable
    *
    * Used to keep track of total animation.
@@ -182,6 +207,16 @@ class StartScreen : public GameEntity {
    */
   void ChangeSelectedMode(int change);
 
+  /** @brief Action handler function
+   *
+   * Subscribed to the action map for the start screen. Up and down skip the
+   * slide in, then move the cursor.
+   *
+   *  @param data, action
+   *  @return void
+   */
+  static void OnAction(void* data, ActionMap::ACTIONS action);
+
   /** @brief Update function
    *
    * Used to update animated textures.
@@ -0,0 +1,274 @@
+/** @file StateHash.cpp
+ *  @brief Source file for simulation state hashing
+ *
+ * This program is responsible for hashing the gameplay state after every
+ * simulation step, logging the hashes and finding the first step where two
+ * runs stop matching.
+ *
+ *  @author Michael Martinez
+ *  @bug No known bugs.
+ */
+#include "StateHash.h"
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+
+namespace {
+
+const std::uint64_t FNV_OFFSET = 14695981039346656037ULL;
+const std::uint64_t FNV_PRIME = 1099511628211ULL;
+
+// Fields are logged as 32 bits, plenty to tell which one changed
+std::uint32_t Short(std::uint64_t hash) noexcept {
+  return static_cast<std::uint32_t>(hash ^ (hash >> 32));
+}
+
+}  // namespace
+
+StateHash* StateHash::sInstance = nullptr;
+
+StateHash* StateHash::Instance() {
+  // C26409: Fixing warning to replace 'new' requires editing included
+  // framework library 'QuickSDL"
+  if (sInstance == nullptr) sInstance = new StateHash();
+
+  return sInstance;
+}
+
+void StateHash::Release() noexcept {
+  delete sInstance;
+  sInstance = nullptr;
+}
+
+// C26455: Fixing the warning 'noexcept' solution is to not include 'noexcept'
+// in the first place.
+//(https://docs.microsoft.com/en-us/cpp/code-quality/c26447?view=msvc-170)
+StateHash::StateHash() {
+  mStep = 0;
+  mDivergence = -1;
+  mReferenceStep.step = -1;
+  mReferenceStep.hash = 0;
+}
+
+// C26432: deleting all would cause compiling error
+StateHash::~StateHash() {
+  mLog.close();
+  mReference.close();
+}
+
+bool StateHash::Log(const char* path) {
+  mLog.open(path, std::ios::out | std::ios::trunc);
+  mLoggedNames.clear();
+  return mLog.is_open();
+}
+
+bool StateHash::Reference(const char* path) {
+  mReference.open(path);
+  mDivergence = -1;
+  return mReference.is_open();
+}
+
+void StateHash::Close() {
+  mLog.close();
+  mReference.close();
+  mStep = 0;
+  mDivergence = -1;
+}
+
+bool StateHash::Enabled() noexcept {
+  return mLog.is_open() || mReference.is_open();
+}
+
+void StateHash::Begin() noexcept {
+  mNames.clear();
+  mFields.clear();
+}
+
+void StateHash::Add(const char* field, const void* data,
+                    std::size_t size) {
+  if (mNames.empty() || std::strcmp(mNames.back(), field) != 0) {
+    mNames.push_back(field);
+    mFields.push_back(FNV_OFFSET);
+  }
+
+  mFields.back() = Mix(mFields.back(), data, size);
+}
+
+void StateHash::Add(const char* field, int value) {
+  Add(field, &value, sizeof(value));
+}
+
+void StateHash::Add(const char* field, float value) {
+  Add(field, &value, sizeof(value));
+}
+
+void StateHash::Add(const char* field, double value) {
+  Add(field, &value, sizeof(value));
+}
+
+void StateHash::Add(const char* field, bool value) {
+  const char byte = value ? 1 : 0;
+  Add(field, &byte, sizeof(byte));
+}
+
+void StateHash::Add(const char* field, Vector2 value) {
+  Add(field, &value.x, sizeof(value.x));
+  Add(field, &value.y, sizeof(value.y));
+}
+
+void StateHash::End() {
+  std::uint64_t hash = FNV_OFFSET;
+  for (const std::uint64_t field : mFields) hash = Mix(hash, &field, 8);
+
+  if (mLog.is_open()) {
+    // Names are only written when they change, usually on screen changes
+    bool renamed = mNames.size() != mLoggedNames.size();
+    for (int i = 0; !renamed && i < static_cast<int>(mNames.size()); i++)
+      renamed = std::strcmp(mNames[i], mLoggedNames[i]) != 0;
+
+    if (renamed) {
+      mLog << '#';
+      for (const char* name : mNames) mLog << ' ' << name;
+      mLog << '\n';
+      mLoggedNames = mNames;
+    }
+
+    char text[32];
+    std::snprintf(text, sizeof(text), "%d %016" PRIx64, mStep, hash);
+    mLog << text;
+    for (const std::uint64_t field : mFields) {
+      std::snprintf(text, sizeof(text), " %08" PRIx32, Short(field));
+      mLog << text;
+    }
+    mLog << '\n';
+  }
+
+  if (mReference.is_open() && mDivergence < 0) {
+    if (!Read(mReference, mReferenceStep)) {
+      std::printf("State hash: reference ends before step %d\n", mStep);
+      mReference.close();
+    } else if (mReferenceStep.step != mStep || mReferenceStep.hash != hash) {
+      mDivergence = mStep;
+
+      Step current;
+      current.step = mStep;
+      current.hash = hash;
+      for (int i = 0; i < static_cast<int>(mNames.size()); i++) {
+        current.names.push_back(mNames[i]);
+        current.fields.push_back(Short(mFields[i]));
+      }
+
+      std::printf("State hash: first divergence from reference at step %d\n",
+                  mStep);
+      Report(mReferenceStep, current);
+    }
+  }
+
+  mStep++;
+}
+
+int StateHash::Steps() noexcept { return mStep; }
+
+int StateHash::Divergence() noexcept { return mDivergence; }
+
+int StateHash::Compare(const char* pathA, const char* pathB) {
+  std::ifstream logA(pathA);
+  std::ifstream logB(pathB);
+  if (!logA.is_open() || !logB.is_open()) {
+    std::printf("State hash: can't open %s\n", logA.is_open() ? pathB : pathA);
+    return -1;
+  }
+
+  Step a;
+  Step b;
+  int steps = 0;
+  while (true) {
+    const bool readA = Read(logA, a);
+    const bool readB = Read(logB, b);
+
+    if (!readA || !readB) {
+      if (readA != readB)
+        std::printf("State hash: %s ends after %d steps\n",
+                    readA ? pathB : pathA, steps);
+      else
+        std::printf("State hash: logs match for %d steps\n", steps);
+      return -1;
+    }
+
+    if (a.step != b.step || a.hash != b.hash) {
+      std::printf("State hash: first divergence at step %d\n", a.step);
+      Report(a, b);
+      return a.step;
+    }
+
+    steps++;
+  }
+}
+
+std::uint64_t StateHash::Mix(std::uint64_t hash, const void* data,
+                             std::size_t size) noexcept {
+  const unsigned char* bytes = static_cast<const unsigned char*>(data);
+
+  // Whole words first so large arrays cost an eighth of the multiplies
+  std::size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    std::uint64_t word = 0;
+    std::memcpy(&word, bytes + i, 8);
+    hash ^= word;
+    hash *= FNV_PRIME;
+  }
+
+  for (; i < size; i++) {
+    hash ^= bytes[i];
+    hash *= FNV_PRIME;
+  }
+
+  return hash;
+}
+
+bool StateHash::Read(std::ifstream& log, Step& step) {
+  std::string line;
+  while (std::getline(log, line)) {
+    if (line.empty()) continue;
+
+    std::istringstream stream(line);
+    if (line[0] == '#') {
+      std::string name;
+      stream.ignore(1);
+      step.names.clear();
+      while (stream >> name) step.names.push_back(name);
+      continue;
+    }
+
+    std::uint32_t field = 0;
+    stream >> std::dec >> step.step >> std::hex >> step.hash;
+    step.fields.clear();
+    while (stream >> field) step.fields.push_back(field);
+    return true;
+  }
+
+  return false;
+}
+
+void StateHash::Report(const Step& a, const Step& b) {
+  for (int i = 0; i < static_cast<int>(a.names.size()); i++) {
+    int j = 0;
+    while (j < static_cast<int>(b.names.size()) && b.names[j] != a.names[i])
+      j++;
+
+    if (j == static_cast<int>(b.names.size()))
+      std::printf("  %s only in the first run\n", a.names[i].c_str());
+    else if (i >= static_cast<int>(a.fields.size()) ||
+             j >= static_cast<int>(b.fields.size()) ||
+             a.fields[i] != b.fields[j])
+      std::printf("  %s differs\n", a.names[i].c_str());
+  }
+
+  for (const std::string& name : b.names) {
+    bool found = false;
+    for (const std::string& other : a.names) found = found || other == name;
+    if (!found) std::printf("  %s only in the second run\n", name.c_str());
+  }
+}
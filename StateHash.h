@@ -0,0 +1,260 @@
+/** @file StateHash.h
+ *  @brief Header file for simulation state hashing
+ *
+ * This program is responsible for hashing the gameplay state after every
+ * simulation step, logging the hashes and finding the first step where two
+ * runs stop matching.
+ *
+ *  @author Michael Martinez
+ *  @bug No known bugs.
+ */
+#ifndef _STATEHASH_H
+#define _STATEHASH_H
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "MathHelper.h"
+
+using namespace QuickSDL;
+
+/**
+ * @brief The StateHash class
+ * @author Michael Martinez
+ *
+ * StateHash class which is used to fingerprint each simulation step. Game
+ * classes add their state to named fields, calling 'Add' again with the same
+ * name to fold more data into a field. Every step is written to the log as
+ * one line with the step's hash and a short hash per field, and a line
+ * naming the fields whenever they change. Given a reference log from an
+ * earlier run, each step is checked against it as it is hashed and the first
+ * step and fields that differ are reported.
+ *
+ */
+class StateHash {
+ private:
+  /** @brief Step struct
+   *
+   * One parsed line of a log: the step number, its hash and its field
+   * hashes, with the field names in effect.
+   *
+   */
+  struct Step {
+    int step;
+    std::uint64_t hash;
+    std::vector<std::uint32_t> fields;
+    std::vector<std::string> names;
+  };
+
+  /** @brief Static instance variable
+   *
+   * Used within the Instance function to check if required to create a new
+   * state hash.
+   *
+   */
+  static StateHash* sInstance;
+
+  /** @brief Step variable
+   *
+   * Number of the step being hashed.
+   *
+   */
+  int mStep;
+
+  /** @brief Names variables
+   *
+   * Field names of the step being hashed and of the last step logged.
+   *
+   */
+  std::vector<const char*> mNames;
+  std::vector<const char*> mLoggedNames;
+
+  /** @brief Fields variable
+   *
+   * Hash of each field of the step being hashed.
+   *
+   */
+  std::vector<std::uint64_t> mFields;
+
+  /** @brief Log variable
+   *
+   * File every step is written to.
+   *
+   */
+  std::ofstream mLog;
+
+  /** @brief Reference variables
+   *
+   * Log of an earlier run each step is checked against and the last step
+   * read from it.
+   *
+   */
+  std::ifstream mReference;
+  Step mReferenceStep;
+
+  /** @brief Divergence variable
+   *
+   * First step that did not match the reference, or -1.
+   *
+   */
+  int mDivergence;
+
+ public:
+  /** @brief Instance function
+   *
+   * Used to create and return a state hash if the static instance is null.
+   *
+   */
+  static StateHash* Instance();
+
+  /** @brief Release function
+   *
+   * Frees the static instance.
+   *
+   *  @return void
+   */
+  static void Release() noexcept;
+
+  /** @brief Log function
+   *
+   * Starts writing every step to a file. Returns false if it can't be
+   * opened.
+   *
+   *  @param path
+   *  @return bool
+   */
+  bool Log(const char* path);
+
+  /** @brief Reference function
+   *
+   * Checks every step against the log of an earlier run. Returns false if it
+   * can't be opened.
+   *
+   *  @param path
+   *  @return bool
+   */
+  bool Reference(const char* path);
+
+  /** @brief Close function
+   *
+   * Stops logging and checking and starts counting steps from zero again.
+   *
+   *  @return void
+   */
+  void Close();
+
+  /** @brief Enabled function
+   *
+   * Used to return true if steps are being logged or checked.
+   *
+   *  @return bool
+   */
+  bool Enabled() noexcept;
+
+  /** @brief Begin function
+   *
+   * Starts hashing the next step.
+   *
+   *  @return void
+   */
+  void Begin() noexcept;
+
+  /** @brief Add functions
+   *
+   * Folds bytes or a value into a field. A field continues while the same
+   * name is added back to back.
+   *
+   *  @param field, data, size
+   *  @return void
+   */
+  void Add(const char* field, const void* data, std::size_t size);
+  void Add(const char* field, int value);
+  void Add(const char* field, float value);
+  void Add(const char* field, double value);
+  void Add(const char* field, bool value);
+  void Add(const char* field, Vector2 value);
+
+  /** @brief End function
+   *
+   * Finishes the step, writes it to the log and checks it against the
+   * reference.
+   *
+   *  @return void
+   */
+  void End();
+
+  /** @brief Steps function
+   *
+   * Used to return the number of steps hashed.
+   *
+   *  @return int
+   */
+  int Steps() noexcept;
+
+  /** @brief Divergence function
+   *
+   * Used to return the first step that did not match the reference, or -1.
+   *
+   *  @return int
+   */
+  int Divergence() noexcept;
+
+  /** @brief Compare function
+   *
+   * Reads two logs side by side and prints the first step where they differ
+   * and which fields differ. Returns that step, or -1 if they match.
+   *
+   *  @param pathA, pathB
+   *  @return int
+   */
+  static int Compare(const char* pathA, const char* pathB);
+
+ private:
+  /** @brief Mix function
+   *
+   * Used to return a hash with bytes folded in, 64 bit FNV-1a taken a word
+   * at a time.
+   *
+   *  @param hash, data, size
+   *  @return std::uint64_t
+   */
+  static std::uint64_t Mix(std::uint64_t hash, const void* data,
+                           std::size_t size) noexcept;
+
+  /** @brief Read function
+   *
+   * Reads the next step from a log, keeping the field names in effect.
+   * Returns false at the end of the log.
+   *
+   *  @param log, step
+   *  @return bool
+   */
+  static bool Read(std::ifstream& log, Step& step);
+
+  /** @brief Report function
+   *
+   * Prints the fields that differ between two steps.
+   *
+   *  @param a, b
+   *  @return void
+   */
+  static void Report(const Step& a, const Step& b);
+
+  /** @brief Constructor
+   *
+   * Creates a state hash that is not logging or checking.
+   *
+   */
+  StateHash();
+
+  /** @brief Deconstructor
+   *
+   * Freeing all entities.
+   *
+   */
+  ~StateHash();
+};
+
+#endif
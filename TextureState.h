@@ -0,0 +1,61 @@
+/** @file TextureState.h
+ *  @brief Header file for reading a texture's draw state
+ *
+ * This program is responsible for reaching the draw state QuickSDL keeps
+ * protected in its textures, so it is done in one place.
+ *
+ *  @author Michael Martinez
+ *  @bug No known bugs.
+ */
+#ifndef _TEXTURESTATE_H
+#define _TEXTURESTATE_H
+#include "Texture.h"
+
+using namespace QuickSDL;
+
+/**
+ * @brief The TextureState class
+ * @author Michael Martinez
+ *
+ * TextureState class which is used to hand out member pointers to the
+ * protected members of Texture. Only a derived class may name them, but the
+ * pointers it returns work on any texture, e.g. 'texture->*Width()'. Never
+ * constructed.
+ *
+ */
+class TextureState : public Texture {
+ public:
+  /** @brief Handle function
+   *
+   * Used to return the member holding the SDL texture.
+   *
+   *  @return SDL_Texture* Texture::*
+   */
+  static SDL_Texture* Texture::*Handle() noexcept {
+    return &TextureState::mTex;
+  }
+
+  /** @brief Size functions
+   *
+   * Used to return the members holding the width and height in pixels.
+   *
+   *  @return int Texture::*
+   */
+  static int Texture::*Width() noexcept { return &TextureState::mWidth; }
+  static int Texture::*Height() noexcept { return &TextureState::mHeight; }
+
+  /** @brief Clip functions
+   *
+   * Used to return the members holding whether only part of the texture is
+   * drawn and which part.
+   *
+   *  @return bool Texture::*, SDL_Rect Texture::*
+   */
+  static bool Texture::*Clipped() noexcept { return &TextureState::mClipped; }
+  static SDL_Rect Texture::*Clip() noexcept { return &TextureState::mClipRect; }
+
+ private:
+  TextureState() = delete;
+};
+
+#endif
@@ -0,0 +1,136 @@
+/** @file Transforms.cpp
+ *  @brief Source file for the world transform cache
+ *
+ * This program is responsible for remembering the world transform of every
+ * entity that is drawn so it is only worked out again after the entity or one
+ * of its parents moves.
+ *
+ *  @author Michael Martinez
+ *  @bug No known bugs.
+ */
+#include "Transforms.h"
+
+namespace {
+
+bool Same(Vector2 a, Vector2 b) noexcept { return a.x == b.x && a.y == b.y; }
+
+}  // namespace
+
+Transforms* Transforms::sInstance = nullptr;
+
+Transforms* Transforms::Instance() {
+  // C26409: Fixing warning to replace 'new' requires editing included
+  // framework library 'QuickSDL"
+  if (sInstance == nullptr) sInstance = new Transforms();
+
+  return sInstance;
+}
+
+void Transforms::Release() noexcept {
+  delete sInstance;
+  sInstance = nullptr;
+}
+
+// C26455: Fixing the warning 'noexcept' solution is to not include 'noexcept'
+// in the first place.
+//(https://docs.microsoft.com/en-us/cpp/code-quality/c26447?view=msvc-170)
+Transforms::Transforms() {
+  mFrame = 1;
+  mLastParent = nullptr;
+  mLastEntry = nullptr;
+  mRebuilds = 0;
+}
+
+// C26432: deleting all would cause compiling error
+Transforms::~Transforms() {
+  Clear();
+  mLastEntry = nullptr;
+}
+
+Transforms::World Transforms::Get(GameEntity* entity) {
+  const Vector2 pos = entity->Pos(GameEntity::local);
+  const Vector2 scale = entity->Scale(GameEntity::local);
+  const float rotation = entity->Rotation(GameEntity::local);
+
+  // Nothing to cache without a parent to walk
+  GameEntity* parent = entity->Parent();
+  if (parent == nullptr) {
+    const World world = {pos, scale, rotation};
+    return world;
+  }
+
+  if (parent != mLastParent) {
+    mLastEntry = &Check(parent);
+    mLastParent = parent;
+  }
+
+  return Place(mLastEntry->world, pos, scale, rotation);
+}
+
+void Transforms::NextFrame() noexcept {
+  mFrame++;
+  mLastParent = nullptr;
+  mRebuilds = 0;
+}
+
+int Transforms::Rebuilds() noexcept { return mRebuilds; }
+
+void Transforms::Clear() noexcept {
+  mEntries.clear();
+  mLastParent = nullptr;
+}
+
+Transforms::Entry& Transforms::Check(GameEntity* entity) {
+  // Entries are never erased, so references stay valid while parents are
+  // added below
+  const std::pair<std::unordered_map<GameEntity*, Entry>::iterator, bool>
+      found = mEntries.try_emplace(entity);
+  Entry& entry = found.first->second;
+  const bool added = found.second;
+
+  if (!added && entry.checked == mFrame) return entry;
+  entry.checked = mFrame;
+
+  GameEntity* parent = entity->Parent();
+  World parentWorld = {VEC2_ZERO, VEC2_ONE, 0.0f};
+  unsigned int parentVersion = 0;
+  if (parent != nullptr) {
+    const Entry& parentEntry = Check(parent);
+    parentWorld = parentEntry.world;
+    parentVersion = parentEntry.version;
+  }
+
+  const Vector2 pos = entity->Pos(GameEntity::local);
+  const Vector2 scale = entity->Scale(GameEntity::local);
+  const float rotation = entity->Rotation(GameEntity::local);
+
+  if (!added && parent == entry.parent &&
+      parentVersion == entry.parentVersion && Same(pos, entry.pos) &&
+      Same(scale, entry.scale) && rotation == entry.rotation)
+    return entry;
+
+  entry.parent = parent;
+  entry.pos = pos;
+  entry.scale = scale;
+  entry.rotation = rotation;
+  entry.parentVersion = parentVersion;
+
+  entry.world = Place(parentWorld, pos, scale, rotation);
+  entry.version = added ? 1 : entry.version + 1;
+  mRebuilds++;
+
+  return entry;
+}
+
+Transforms::World Transforms::Place(const World& parent, Vector2 pos,
+                                    Vector2 scale, float rotation) noexcept {
+  // Same math as GameEntity, skipping the rotation when there is none
+  Vector2 offset(pos.x * parent.scale.x, pos.y * parent.scale.y);
+  if (parent.rotation != 0.0f) offset = RotateVector(offset, parent.rotation);
+
+  const World world = {
+      parent.pos + offset,
+      Vector2(parent.scale.x * scale.x, parent.scale.y * scale.y),
+      parent.rotation + rotation};
+  return world;
+}
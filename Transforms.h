@@ -0,0 +1,198 @@
+/** @file Transforms.h
+ *  @brief Header file for the world transform cache
+ *
+ * This program is responsible for remembering the world transform of every
+ * entity that is drawn so it is only worked out again after the entity or one
+ * of its parents moves.
+ *
+ *  @author Michael Martinez
+ *  @bug No known bugs.
+ */
+#ifndef _TRANSFORMS_H
+#define _TRANSFORMS_H
+#include <unordered_map>
+
+#include "GameEntity.h"
+
+using namespace QuickSDL;
+
+/**
+ * @brief The Transforms class
+ * @author Michael Martinez
+ *
+ * Transforms class which is used to cache world transforms for the render
+ * path. 'GameEntity' rebuilds a world transform by walking its parents every
+ * time one is asked for and cannot be hooked to report a move, so this is not
+ * dirty propagation. Instead every cached parent has its local transform read
+ * again once per recorded frame and compared with the one its entry was built
+ * from. An entry is rebuilt when that or its parent's version changed, and
+ * its own version goes up so its children rebuild too. What is saved is the
+ * math, not the walk. The entity being drawn is placed on its parent's cached
+ * transform every time since leaf textures are often moved between draws.
+ *
+ * Entries are keyed by address, so 'Clear' has to be called once cached
+ * entities are destroyed, before their slots are reused. The screen manager
+ * does so whenever it unloads a screen, the only time entities are destroyed
+ * in play.
+ *
+ */
+class Transforms {
+ public:
+  /** @brief World struct
+   *
+   * World position, scale and rotation of an entity.
+   *
+   */
+  struct World {
+    Vector2 pos;
+    Vector2 scale;
+    float rotation;
+  };
+
+ private:
+  /** @brief Entry struct
+   *
+   * Cached world transform with the local transform, parent and parent
+   * version it was built from.
+   *
+   */
+  struct Entry {
+    GameEntity* parent;
+    Vector2 pos;
+    Vector2 scale;
+    float rotation;
+    unsigned int parentVersion;
+    unsigned int version;
+    unsigned int checked;
+    World world;
+  };
+
+  /** @brief Static instance variable
+   *
+   * Used within the Instance function to check if required to create a new
+   * transform cache.
+   *
+   */
+  static Transforms* sInstance;
+
+  /** @brief Entries variable
+   *
+   * Cached transform of every parent of a drawn entity.
+   *
+   */
+  std::unordered_map<GameEntity*, Entry> mEntries;
+
+  /** @brief Frame variable
+   *
+   * Number of the frame being recorded, stamped on entries when checked.
+   *
+   */
+  unsigned int mFrame;
+
+  /** @brief Last parent variables
+   *
+   * Parent of the last entity drawn this frame and its entry, so siblings
+   * drawn one after another skip the lookup.
+   *
+   */
+  GameEntity* mLastParent;
+  Entry* mLastEntry;
+
+  /** @brief Rebuilds variable
+   *
+   * Number of world transforms rebuilt in the frame being recorded.
+   *
+   */
+  int mRebuilds;
+
+ public:
+  /** @brief Instance function
+   *
+   * Used to create and return a transform cache if the static instance is
+   * null.
+   *
+   */
+  static Transforms* Instance();
+
+  /** @brief Release function
+   *
+   * Frees the static instance.
+   *
+   *  @return void
+   */
+  static void Release() noexcept;
+
+  /** @brief Get function
+   *
+   * Used to return the world transform of an entity, rebuilding any parent
+   * that moved.
+   *
+   *  @param entity
+   *  @return World
+   */
+  World Get(GameEntity* entity);
+
+  /** @brief Next frame function
+   *
+   * Starts a new frame so parents are checked for moves again.
+   *
+   *  @return void
+   */
+  void NextFrame() noexcept;
+
+  /** @brief Rebuilds function
+   *
+   * Used to return the number of world transforms rebuilt in the frame
+   * being recorded.
+   *
+   *  @return int
+   */
+  int Rebuilds() noexcept;
+
+  /** @brief Clear function
+   *
+   * Forgets every cached transform. Called whenever cached entities are
+   * destroyed.
+   *
+   *  @return void
+   */
+  void Clear() noexcept;
+
+ private:
+  /** @brief Check function
+   *
+   * Used to return an entity's entry after rebuilding it if it or a parent
+   * moved. An entry already checked this frame is trusted.
+   *
+   *  @param entity
+   *  @return Entry&
+   */
+  Entry& Check(GameEntity* entity);
+
+  /** @brief Place function
+   *
+   * Used to return the world transform of a local transform on a parent's
+   * world transform.
+   *
+   *  @param parent, pos, scale, rotation
+   *  @return World
+   */
+  static World Place(const World& parent, Vector2 pos, Vector2 scale,
+                     float rotation) noexcept;
+
+  /** @brief Constructor
+   *
+   * Creates an empty cache.
+   *
+   */
+  Transforms();
+
+  /** @brief Deconstructor
+   *
+   * Freeing all entities.
+   *
+   */
+  ~Transforms();
+};
+
+#endif
@@ -0,0 +1,247 @@
+/** @file Viruses.cpp
+ *  @brief Source file for virus enemies
+ *
+ * This program is responsible for handling every virus on the stage. Virus
+ * state is kept in packed arrays and updated in a single batched pass per
+ * frame instead of one entity per virus.
+ *
+ *  @author Michael Martinez
+ *  @bug No known bugs.
+ */
+#include "Viruses.h"
+
+// C26455: Fixing the warning 'noexcept' solution is to not include 'noexcept'
+// in the first place.
+//(https://docs.microsoft.com/en-us/cpp/code-quality/c26447?view=msvc-170)
+Viruses::Viruses(int capacity, int columns, int rows) {
+  mTimer = FixedTimer::Instance();
+  mJobs = JobSystem::Instance();
+  mDeltaTime = 0.0f;
+
+  // Virus frame entities
+  for (int i = 0; i < MAX_FRAMES; i++) {
+    gsl::at(mFrameTextures, i) =
+        ObjectPool<Texture>::Create("mettaur.png", 80 * i, 0, 80, 80);
+    gsl::at(mFrameTextures, i)->Parent(this);
+  }
+  mFrameInterval = 0.2f;
+
+  mCapacity = capacity;
+  mCount = 0;
+
+  mColumns = columns;
+  mRows = rows;
+  mPanelOrigin = Vector2(570.0f, 277.0f);
+  mPanelSize = Vector2(157.0f, 97.0f);
+
+  // Virus slots are only allocated here, never while playing
+  mPanelX.resize(mCapacity);
+  mPanelY.resize(mCapacity);
+  mHP.resize(mCapacity);
+  mCooldown.resize(mCapacity);
+  mFrame.resize(mCapacity);
+  mFrameTimer.resize(mCapacity);
+  mBehavior.resize(mCapacity);
+  mCursor.resize(mCapacity);
+  mFiring.resize(mCapacity);
+
+  mTargetRow = 0;
+
+  mBehaviors = new BehaviorTree();
+  CompileBehaviors();
+}
+
+// C26432: deleting all would cause compiling error
+Viruses::~Viruses() {
+  mTimer = nullptr;
+  mJobs = nullptr;
+
+  for (int i = 0; i < MAX_FRAMES; i++) {
+    ObjectPool<Texture>::Destroy(gsl::at(mFrameTextures, i));
+    gsl::at(mFrameTextures, i) = nullptr;
+  }
+
+  delete mBehaviors;
+  mBehaviors = nullptr;
+}
+
+void Viruses::CompileBehaviors() {
+  using Node = BehaviorTree::Node;
+
+  // Idle: wait, then fire
+  const Node idleTree = {
+      BehaviorTree::sequence,
+      0.0f,
+      {{BehaviorTree::wait, 2.0f, {}}, {BehaviorTree::fire, 0.0f, {}}}};
+
+  // Patrol: wait, step down a row, then fire
+  const Node patrolTree = {BehaviorTree::sequence,
+                           0.0f,
+                           {{BehaviorTree::wait, 1.0f, {}},
+                            {BehaviorTree::move, 1.0f, {}},
+                            {BehaviorTree::fire, 0.0f, {}}}};
+
+  // Chase: fire when lined up with the player, otherwise close in on the player's row
+  const Node chaseTree = {
+      BehaviorTree::selector,
+      0.0f,
+      {{BehaviorTree::sequence,
+        0.0f,
+        {{BehaviorTree::aligned, 0.0f, {}},
+         {BehaviorTree::wait, 0.5f, {}},
+         {BehaviorTree::fire, 0.0f, {}}}},
+       {BehaviorTree::sequence,
+        0.0f,
+        {{BehaviorTree::wait, 1.5f, {}},
+         {BehaviorTree::approach, 0.0f, {}}}}}};
+
+  gsl::at(mTreeRoots, idle) = mBehaviors->Compile(idleTree);
+  gsl::at(mTreeRoots, patrol) = mBehaviors->Compile(patrolTree);
+  gsl::at(mTreeRoots, chase) = mBehaviors->Compile(chaseTree);
+}
+
+Vector2 Viruses::PanelPos(int column, int row) noexcept {
+  return Vector2(mPanelOrigin.x + mPanelSize.x * column,
+                 mPanelOrigin.y + mPanelSize.y * row);
+}
+
+int Viruses::Spawn(int column, int row, int hp,
+                   VIRUS_BEHAVIORS behavior) noexcept {
+  if (mCount >= mCapacity) return -1;
+
+  const int slot = mCount++;
+  mPanelX[slot] = column;
+  mPanelY[slot] = row;
+  mHP[slot] = hp;
+  mCooldown[slot] = BehaviorTree::FRESH;
+  mFrame[slot] = 0;
+  mFrameTimer[slot] = 0.0f;
+  mBehavior[slot] = behavior;
+  mCursor[slot] = gsl::at(mTreeRoots, behavior);
+  mFiring[slot] = 0;
+
+  return slot;
+}
+
+void Viruses::Kill(int slot) noexcept {
+  if (slot < 0 || slot >= mCount) return;
+
+  // Keep live viruses packed by moving the last one into the freed slot
+  const int last = --mCount;
+  mPanelX[slot] = mPanelX[last];
+  mPanelY[slot] = mPanelY[last];
+  mHP[slot] = mHP[last];
+  mCooldown[slot] = mCooldown[last];
+  mFrame[slot] = mFrame[last];
+  mFrameTimer[slot] = mFrameTimer[last];
+  mBehavior[slot] = mBehavior[last];
+  mCursor[slot] = mCursor[last];
+  mFiring[slot] = mFiring[last];
+}
+
+void Viruses::Clear() noexcept { mCount = 0; }
+
+int Viruses::Count() noexcept { return mCount; }
+
+void Viruses::TargetRow(int row) noexcept { mTargetRow = row; }
+
+int Viruses::Row(Vector2 pos) noexcept {
+  return static_cast<int>((pos.y - mPanelOrigin.y) / mPanelSize.y + 0.5f);
+}
+
+int Viruses::HitTest(Vector2 pos) noexcept {
+  const int column =
+      static_cast<int>((pos.x - mPanelOrigin.x) / mPanelSize.x + 0.5f);
+  const int row = Row(pos);
+
+  if (pos.x < mPanelOrigin.x - mPanelSize.x * 0.5f || column >= mColumns)
+    return -1;
+  if (pos.y < mPanelOrigin.y - mPanelSize.y * 0.5f || row >= mRows) return -1;
+
+  for (int i = 0; i < mCount; i++) {
+    if (mPanelX[i] == column && mPanelY[i] == row) return i;
+  }
+
+  return -1;
+}
+
+bool Viruses::Damage(int slot, int amount) noexcept {
+  if (slot < 0 || slot >= mCount) return false;
+
+  mHP[slot] -= amount;
+  if (mHP[slot] > 0) return false;
+
+  Kill(slot);
+  return true;
+}
+
+bool Viruses::Firing(int slot) noexcept { return mFiring[slot] != 0; }
+
+int Viruses::Behavior(int slot) noexcept { return mBehavior[slot]; }
+
+Vector2 Viruses::SlotPos(int slot) noexcept {
+  return PanelPos(mPanelX[slot], mPanelY[slot]);
+}
+
+long long Viruses::NodeTicks() noexcept { return mBehaviors->NodeTicks(); }
+
+void Viruses::SimulateRange(void* data, int begin, int end) {
+  Viruses* viruses = static_cast<Viruses*>(data);
+  const float deltaTime = viruses->mDeltaTime;
+
+  // Behavior trees, with the attack cooldown doubling as the timer of the
+  // current 'wait' node
+  BehaviorTree::Agents agents = {viruses->mCount,
+                                 viruses->mCursor.data(),
+                                 viruses->mCooldown.data(),
+                                 viruses->mPanelY.data(),
+                                 viruses->mFiring.data(),
+                                 viruses->mRows,
+                                 viruses->mTargetRow};
+  viruses->mBehaviors->Tick(agents, begin, end, deltaTime);
+
+  // Animation frames
+  for (int i = begin; i < end; i++) {
+    viruses->mFrameTimer[i] += deltaTime;
+    if (viruses->mFrameTimer[i] >= viruses->mFrameInterval) {
+      viruses->mFrameTimer[i] -= viruses->mFrameInterval;
+      viruses->mFrame[i] = (viruses->mFrame[i] + 1) % MAX_FRAMES;
+    }
+  }
+}
+
+void Viruses::Simulate(float deltaTime) noexcept {
+  if (mCount == 0) return;
+
+  // Every virus only touches its own slot, so batches can run on any core
+  mDeltaTime = deltaTime;
+  JobCounter counter(0);
+  mJobs->ParallelFor(SimulateRange, this, mCount, BATCH_SIZE, counter);
+  mJobs->Wait(counter);
+}
+
+void Viruses::Hash(StateHash* hash) {
+  hash->Add("viruses", mCount);
+  hash->Add("viruses", mTargetRow);
+  hash->Add("viruses", mPanelX.data(), mCount * sizeof(int));
+  hash->Add("viruses", mPanelY.data(), mCount * sizeof(int));
+  hash->Add("viruses", mHP.data(), mCount * sizeof(int));
+  hash->Add("viruses", mCooldown.data(), mCount * sizeof(float));
+  hash->Add("viruses", mFrame.data(), mCount * sizeof(int));
+  hash->Add("viruses", mFrameTimer.data(), mCount * sizeof(float));
+  hash->Add("viruses", mBehavior.data(), mCount * sizeof(int));
+  hash->Add("viruses", mCursor.data(), mCount * sizeof(int));
+  hash->Add("viruses", mFiring.data(), mCount * sizeof(char));
+}
+
+// C26433: Method is not a virtual function to use override.
+void Viruses::Update() { Simulate(mTimer->DeltaTime()); }
+
+// C26433: Method is not a virtual function to use override.
+void Viruses::Render() {
+  for (int i = 0; i < mCount; i++) {
+    Texture* frame = gsl::at(mFrameTextures, mFrame[i]);
+    frame->Pos(PanelPos(mPanelX[i], mPanelY[i]));
+    RenderList::Draw(frame);
+  }
+}
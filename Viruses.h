@@ -0,0 +1,357 @@
+/** @file Viruses.h
+ *  @brief Header file for virus enemies
+ *
+ * This program is responsible for handling every virus on the stage. Virus
+ * state is kept in packed arrays and updated in a single batched pass per
+ * frame instead of one entity per virus.
+ *
+ *  @author Michael Martinez
+ *  @bug No known bugs.
+ */
+#ifndef _VIRUSES_H
+#define _VIRUSES_H
+#include <gsl/util>
+#include <vector>
+
+#include "BehaviorTree.h"
+#include "FixedTimer.h"
+#include "JobSystem.h"
+#include "RenderList.h"
+#include "SlabPool.h"
+#include "StateHash.h"
+#include "Texture.h"
+
+using namespace QuickSDL;
+
+/**
+ * @brief The Viruses class
+ * @author Michael Martinez
+ *
+ * Viruses class inheriting from GameEntity which is used to spawn, update and
+ * render all virus enemies from preallocated slots.
+ *
+ */
+class Viruses : public GameEntity {
+ public:
+  /** @brief enum for virus behaviors
+   *
+   * Used to pick the behavior tree a virus runs.
+   *
+   */
+  enum VIRUS_BEHAVIORS { idle, patrol, chase, TOTAL_BEHAVIORS };
+
+  /** @brief Default capacity variable
+   *
+   * Number of slots for a normal stage, one per enemy panel.
+   *
+   */
+  static const int DEFAULT_CAPACITY = 9;
+
+ private:
+  /** @brief Timer variable
+   *
+   * Used to keep track of time between resets.
+   *
+   */
+  FixedTimer* mTimer;
+
+  /** @brief Virus frame count variable
+   *
+   * Number of frames in the virus sprite sheet.
+   *
+   */
+  static const int MAX_FRAMES = 3;
+
+  /** @brief Virus frame textures
+   *
+   * One shared texture per animation frame. Every virus is drawn with these by
+   * moving them to the virus panel before rendering.
+   *
+   */
+  Texture* mFrameTextures[MAX_FRAMES];
+
+  /** @brief Frame interval variable
+   *
+   * Time each animation frame stays on screen.
+   *
+   */
+  float mFrameInterval;
+
+  /** @brief Capacity variable
+   *
+   * Number of preallocated virus slots.
+   *
+   */
+  int mCapacity;
+
+  /** @brief Count variable
+   *
+   * Number of live viruses. Live viruses always fill slots 0 to mCount - 1.
+   *
+   */
+  int mCount;
+
+  /** @brief Grid size variables
+   *
+   * Number of panel columns and rows viruses can stand on.
+   *
+   */
+  int mColumns;
+  int mRows;
+
+  /** @brief Panel origin variable
+   *
+   * Position of the top left enemy panel.
+   *
+   */
+  Vector2 mPanelOrigin;
+
+  /** @brief Panel size variable
+   *
+   * Distance between neighbouring panels.
+   *
+   */
+  Vector2 mPanelSize;
+
+  /** @brief Behavior tree variable
+   *
+   * Compiled node table shared by every virus behavior.
+   *
+   */
+  BehaviorTree* mBehaviors;
+
+  /** @brief Tree roots variable
+   *
+   * First node of each behavior's tree in 'mBehaviors'.
+   *
+   */
+  int mTreeRoots[TOTAL_BEHAVIORS];
+
+  /** @brief Packed virus state
+   *
+   * One array per field, indexed by slot.
+   *
+   */
+  std::vector<int> mPanelX;
+  std::vector<int> mPanelY;
+  std::vector<int> mHP;
+  std::vector<float> mCooldown;
+  std::vector<int> mFrame;
+  std::vector<float> mFrameTimer;
+  std::vector<int> mBehavior;
+  std::vector<int> mCursor;
+  std::vector<char> mFiring;
+
+  /** @brief Jobs variable
+   *
+   * Used to tick batches of viruses on every core.
+   *
+   */
+  JobSystem* mJobs;
+
+  /** @brief Batch size variable
+   *
+   * Number of viruses in one job.
+   *
+   */
+  static const int BATCH_SIZE = 1024;
+
+  /** @brief Delta time variable
+   *
+   * Delta time of the frame being simulated, read by every job.
+   *
+   */
+  float mDeltaTime;
+
+  /** @brief Target row variable
+   *
+   * Row that chasing viruses move towards, normally the player's row.
+   *
+   */
+  int mTargetRow;
+
+ private:
+  /** @brief Compile behaviors function
+   *
+   * Authors the tree of every virus behavior and compiles it.
+   *
+   *  @return void
+   */
+  void CompileBehaviors();
+
+  /** @brief Simulate range job
+   *
+   * Ticks behaviors and animation frames of the viruses from begin to end.
+   *
+   *  @param data, begin, end
+   *  @return void
+   */
+  static void SimulateRange(void* data, int begin, int end);
+
+  /** @brief Panel position function
+   *
+   * Converts a panel to a position on the stage.
+   *
+   *  @param column, row
+   *  @return Vector2
+   */
+  Vector2 PanelPos(int column, int row) noexcept;
+
+ public:
+  /** @brief Constructor
+   *
+   * Creates the frame textures and preallocates every virus slot.
+   *
+   *  @param capacity, columns, rows
+   */
+  Viruses(int capacity = DEFAULT_CAPACITY, int columns = 3, int rows = 3);
+
+  /** @brief Deconstructor
+   *
+   * Freeing all entities
+   *
+   */
+  virtual ~Viruses();
+
+  /** @brief Spawn function
+   *
+   * Takes the next free slot for a new virus.
+   *
+   *  @param column, row, hp, behavior
+   *  @return int slot, or -1 if every slot is taken
+   */
+  int Spawn(int column, int row, int hp, VIRUS_BEHAVIORS behavior) noexcept;
+
+  /** @brief Kill function
+   *
+   * Frees a slot by moving the last live virus into it.
+   *
+   *  @param slot
+   *  @return void
+   */
+  void Kill(int slot) noexcept;
+
+  /** @brief Clear function
+   *
+   * Frees every slot.
+   *
+   *  @return void
+   */
+  void Clear() noexcept;
+
+  /** @brief Count function
+   *
+   * Used to return the number of live viruses.
+   *
+   *  @return int
+   */
+  int Count() noexcept;
+
+  /** @brief Target row function
+   *
+   * Sets the row chasing viruses move towards.
+   *
+   *  @param row
+   *  @return void
+   */
+  void TargetRow(int row) noexcept;
+
+  /** @brief Row function
+   *
+   * Used to return the panel row under a position.
+   *
+   *  @param pos
+   *  @return int
+   */
+  int Row(Vector2 pos) noexcept;
+
+  /** @brief Hit test function
+   *
+   * Finds the virus standing on the panel under a position.
+   *
+   *  @param pos
+   *  @return int slot, or -1 if no virus is there
+   */
+  int HitTest(Vector2 pos) noexcept;
+
+  /** @brief Damage function
+   *
+   * Lowers the HP of a virus and kills it once HP reaches zero.
+   *
+   *  @param slot, amount
+   *  @return bool true if the virus was deleted
+   */
+  bool Damage(int slot, int amount) noexcept;
+
+  /** @brief Firing function
+   *
+   * Used to check if a virus reached a 'fire' node this frame.
+   *
+   *  @param slot
+   *  @return bool
+   */
+  bool Firing(int slot) noexcept;
+
+  /** @brief Behavior function
+   *
+   * Used to return the behavior of a virus.
+   *
+   *  @param slot
+   *  @return int
+   */
+  int Behavior(int slot) noexcept;
+
+  /** @brief Slot position function
+   *
+   * Used to return the stage position of a virus.
+   *
+   *  @param slot
+   *  @return Vector2
+   */
+  Vector2 SlotPos(int slot) noexcept;
+
+  /** @brief Node ticks function
+   *
+   * Used to return the number of behavior nodes run so far.
+   *
+   *  @return long long
+   */
+  long long NodeTicks() noexcept;
+
+  /** @brief Simulate function
+   *
+   * Ticks the behavior tree of every live virus and advances animation frames
+   * in one pass each.
+   *
+   *  @param deltaTime
+   *  @return void
+   */
+  void Simulate(float deltaTime) noexcept;
+
+  /** @brief Hash function
+   *
+   * Adds every live virus to the state hash.
+   *
+   *  @param hash
+   *  @return void
+   */
+  void Hash(StateHash* hash);
+
+  /** @brief Update function
+   *
+   * Simulates every virus with the frame's delta time.
+   *
+   *  @return void
+   */
+  void Update();
+
+  /** @brief Render function
+   *
+   * Renders all viruses.
+   *
+   *  @return void
+   */
+  void Render();
+};
+
+#endif